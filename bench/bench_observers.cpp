@@ -0,0 +1,176 @@
+// ============================================================================
+// bench_observers.cpp - Custo das políticas de observação
+// ============================================================================
+// Mede a mesma carga (leituras/escritas de memória, registradores e
+// desenho) com NullObserver, TracingObserver e cópias das classes de antes
+// das políticas, sem nenhum hook. As três variantes rodam o mesmo template
+// de carga, em rodadas intercaladas; o resultado é a mediana das rodadas.
+// NullObserver deve ficar dentro do ruído da versão sem hooks.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Memory.h"
+#include "Registers.h"
+#include "Display.h"
+
+namespace {
+
+const int ITERATIONS = 2000000;
+const int ROUNDS = 9;
+
+// ============================================================================
+// Referência: Memory, Registers e Display como eram antes das políticas
+// (só o que a carga usa), com o mesmo wrap e o mesmo desenho
+// ============================================================================
+class PlainMemory {
+private:
+    uint8_t data[4096];
+
+public:
+    PlainMemory() { std::memset(data, 0, sizeof(data)); }
+
+    uint8_t read(uint16_t address) const {
+        return data[address & 0xFFF];
+    }
+
+    void write(uint16_t address, uint8_t value) {
+        data[address & 0xFFF] = value;
+    }
+};
+
+class PlainRegisters {
+private:
+    uint8_t V[16];
+    uint16_t I;
+
+public:
+    PlainRegisters() : I(0) { std::memset(V, 0, sizeof(V)); }
+
+    uint8_t getV(uint8_t index) const { return V[index & 0xF]; }
+    void setV(uint8_t index, uint8_t value) { V[index & 0xF] = value; }
+    uint16_t getI() const { return I; }
+    void addI(uint16_t value) { I += value; }
+};
+
+class PlainDisplay {
+private:
+    static constexpr size_t WIDTH = 64;
+    static constexpr size_t HEIGHT = 32;
+
+    uint8_t pixels[WIDTH * HEIGHT];
+    bool needsRedraw;
+
+public:
+    PlainDisplay() : needsRedraw(true) { std::memset(pixels, 0, sizeof(pixels)); }
+
+    bool drawSprite(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t height) {
+        bool collision = false;
+        x %= WIDTH;
+        y %= HEIGHT;
+
+        for(uint8_t row = 0; row < height; ++row) {
+            uint8_t spriteData = sprite[row];
+
+            for(uint8_t col = 0; col < 8; ++col) {
+                if(spriteData & (0x80 >> col)) {
+                    uint16_t pixelX = (x + col) % WIDTH;
+                    uint16_t pixelY = (y + row) % HEIGHT;
+                    uint16_t index = pixelY * WIDTH + pixelX;
+
+                    if(pixels[index] == 1) {
+                        collision = true;
+                    }
+                    pixels[index] ^= 1;
+                }
+            }
+        }
+
+        needsRedraw = true;
+        return collision;
+    }
+
+    const uint8_t* getPixels() const { return pixels; }
+};
+
+// A mesma carga para as três variantes
+template<typename MemoryType, typename RegistersType, typename DisplayType>
+uint32_t runWorkload(MemoryType& memory, RegistersType& registers, DisplayType& display) {
+    static const uint8_t sprite[1] = {0x80};
+    uint32_t checksum = 0;
+    for(int i = 0; i < ITERATIONS; ++i) {
+        uint16_t addr = static_cast<uint16_t>(0x200 + (i & 0x7FF));
+        memory.write(addr, static_cast<uint8_t>(i));
+        uint8_t value = memory.read(addr + 1);
+        registers.setV(i & 0xF, static_cast<uint8_t>(registers.getV(i & 0xF) + value));
+        registers.addI(value);
+        if((i & 0xFF) == 0) {
+            checksum += display.drawSprite(i & 63, i & 31, sprite, 1);
+        }
+        checksum += registers.getV((i + 1) & 0xF) + display.getPixels()[(i + 7) & 0x7FF];
+    }
+    return checksum + registers.getI();
+}
+
+template<typename MemoryType, typename RegistersType, typename DisplayType>
+struct Variant {
+    const char* name;
+    MemoryType memory;
+    RegistersType registers;
+    DisplayType display;
+    std::vector<double> times;      // ns por iteração, uma por rodada
+    uint32_t checksum;
+
+    explicit Variant(const char* label) : name(label), checksum(0) {}
+
+    void round() {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        checksum += runWorkload(memory, registers, display);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        times.push_back(elapsed.count() / ITERATIONS);
+    }
+
+    double median() const {
+        std::vector<double> sorted(times);
+        std::sort(sorted.begin(), sorted.end());
+        return sorted[sorted.size() / 2];
+    }
+
+    void print() const {
+        std::printf("%-18s mediana %8.3f ns/iter   min %8.3f   max %8.3f   (checksum %u)\n",
+                    name, median(), *std::min_element(times.begin(), times.end()),
+                    *std::max_element(times.begin(), times.end()), checksum);
+    }
+};
+
+} // namespace
+
+int main() {
+    Variant<PlainMemory, PlainRegisters, PlainDisplay> raw("sem hooks");
+    Variant<BasicMemory<NullObserver>, BasicRegisters<NullObserver>, BasicDisplay<NullObserver> >
+        null("NullObserver");
+    Variant<BasicMemory<TracingObserver>, BasicRegisters<TracingObserver>,
+            BasicDisplay<TracingObserver> > trace("TracingObserver");
+
+    // Intercaladas, para que frequência e cache variem igual para todas
+    for(int r = 0; r < ROUNDS; ++r) {
+        raw.round();
+        null.round();
+        trace.round();
+    }
+
+    raw.print();
+    null.print();
+    trace.print();
+    if(null.checksum != raw.checksum || trace.checksum != raw.checksum) {
+        std::printf("Checksums diferentes: as variantes não fizeram o mesmo trabalho\n");
+        return 1;
+    }
+    std::printf("\n%d rodadas de %d iterações\n", ROUNDS, ITERATIONS);
+    std::printf("NullObserver / sem hooks:    %.2fx\n", null.median() / raw.median());
+    std::printf("TracingObserver / sem hooks: %.2fx\n", trace.median() / raw.median());
+    return 0;
+}
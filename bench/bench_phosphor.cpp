@@ -0,0 +1,53 @@
+// ============================================================================
+// bench_phosphor.cpp - Custo do filtro de fósforo por frame
+// ============================================================================
+// Mede PhosphorFilter::process em 64x32 e 128x64, e o upscale para uma
+// textura 8x maior, com frames que mudam a cada iteração (como o XOR de
+// sprites). O resultado deve ficar na casa dos microssegundos por frame.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "PhosphorFilter.h"
+
+namespace {
+
+const int FRAMES = 20000;
+
+double measure(const char* name, size_t width, size_t height, unsigned scale) {
+    PhosphorFilter filter(PhosphorOptions(), width, height);
+    std::vector<std::vector<uint8_t>> frames(4, std::vector<uint8_t>(width * height));
+    for(size_t f = 0; f < frames.size(); ++f) {
+        for(size_t i = 0; i < width * height; ++i) {
+            frames[f][i] = static_cast<uint8_t>(((i * 7 + f * 13) % 5) == 0);
+        }
+    }
+    std::vector<uint8_t> texture(width * scale * height * scale);
+
+    uint32_t checksum = 0;
+    double best = 1e30;
+    for(int round = 0; round < 5; ++round) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int f = 0; f < FRAMES; ++f) {
+            filter.process(frames[f & 3].data());
+            if(scale > 1) filter.upscale(scale, texture.data());
+            checksum += filter.getIntensity()[f % (width * height)] + texture[f % texture.size()];
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        double perFrame = elapsed.count() / FRAMES;
+        if(perFrame < best) best = perFrame;
+    }
+    std::printf("%-22s %8.3f us/frame   (checksum %u)\n", name, best, checksum);
+    return best;
+}
+
+} // namespace
+
+int main() {
+    measure("64x32", 64, 32, 1);
+    measure("128x64", 128, 64, 1);
+    measure("64x32 + upscale 8x", 64, 32, 8);
+    measure("128x64 + upscale 8x", 128, 64, 8);
+    return 0;
+}
@@ -0,0 +1,275 @@
+// ============================================================================
+// fuzz_rom.cpp - Fuzzing de ROMs guiado por cobertura de PCs do CHIP-8
+// ============================================================================
+// A entrada do fuzzer é interpretada como:
+//
+//   byte 0          quantidade de eventos de tecla (4 bits baixos)
+//   2 bytes/evento  frame em que o evento entra, tecla | 0x80 se pressionada
+//   resto           bytes da ROM (carregados em 0x200)
+//
+// Cada execução roda no máximo FRAMES * CYCLES_PER_FRAME instruções. Entre
+// execuções a máquina não é reconstruída: um snapshot pristino (fontset
+// carregado, registradores zerados) é restaurado por cópia.
+//
+// Cobertura: cada par (PC anterior, PC atual) incrementa um contador num
+// mapa estilo AFL. Compilado com -DCHIP8_LIBFUZZER (clang + -fsanitize=fuzzer)
+// o mapa fica na seção __libfuzzer_extra_counters e guia o libFuzzer
+// diretamente; sem isso, o main() no fim do arquivo é um fuzzer de mutação
+// simples que usa o mesmo mapa.
+//
+// Uso de pilha fora dos limites (2NNN com 16 níveis ou 00EE com pilha
+// vazia) é contado; com -DCHIP8_FUZZ_ABORT_ON_STACK_FAULT o harness aborta
+// para que o fuzzer salve a entrada que o causou.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Chip8.h"
+
+namespace {
+
+const uint32_t FRAMES = 16;
+const uint32_t CYCLES_PER_FRAME = 16;
+const size_t MAP_SIZE = 1 << 16;
+
+#ifdef CHIP8_LIBFUZZER
+__attribute__((used, section("__libfuzzer_extra_counters")))
+#endif
+uint8_t edgeMap[MAP_SIZE];
+
+// Posições do mapa tocadas na execução atual (no máximo uma por instrução),
+// para o fuzzer standalone não varrer o mapa inteiro a cada execução
+size_t touched[FRAMES * CYCLES_PER_FRAME];
+size_t touchedCount = 0;
+
+uint64_t stackFaults = 0;
+
+inline size_t edgeIndex(uint16_t from, uint16_t to) {
+    return ((from * 0x9E37u) ^ to) & (MAP_SIZE - 1);
+}
+
+// Máquina e snapshot criados uma única vez
+struct FuzzTarget {
+    Chip8 emulator;
+    Chip8Snapshot pristine;
+
+    FuzzTarget() {
+        // Opcodes inválidos são a regra aqui; o log em cerr dominaria o tempo
+        std::cerr.setstate(std::ios::badbit);
+        emulator.saveSnapshot(pristine);
+    }
+};
+
+FuzzTarget& target() {
+    static FuzzTarget instance;
+    return instance;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if(size < 1) return 0;
+
+    size_t eventCount = data[0] & 0x0F;
+    size_t romOffset = 1 + eventCount * 2;
+    if(size <= romOffset) return 0;
+
+    FuzzTarget& t = target();
+    Chip8& emulator = t.emulator;
+
+    emulator.restoreSnapshot(t.pristine);
+    emulator.seedRandom(0);
+    if(!emulator.loadROM(data + romOffset, size - romOffset)) return 0;
+
+    Input& input = emulator.getInput();
+    for(size_t i = 0; i < eventCount; ++i) {
+        uint8_t frame = data[1 + i * 2];
+        uint8_t key = data[2 + i * 2];
+        input.postKey(key & 0x0F, (key & 0x80) != 0, frame);
+    }
+
+    const Registers& registers = emulator.getRegisters();
+    touchedCount = 0;
+    uint16_t previous = registers.getPC();
+    bool stalled = false;
+
+    for(uint32_t frame = 0; frame < FRAMES && !stalled; ++frame) {
+        emulator.runFrame(CYCLES_PER_FRAME, [&]() {
+            uint16_t pc = registers.getPC();
+            size_t index = edgeIndex(previous, pc);
+            uint8_t& counter = edgeMap[index];
+            if(counter == 0) touched[touchedCount++] = index;
+            if(counter != 0xFF) ++counter;
+            // Laço em si mesmo (1NNN para NNN): nada mais a descobrir
+            if(pc == previous) stalled = true;
+            previous = pc;
+        });
+    }
+
+    if(registers.hasStackFault()) {
+        ++stackFaults;
+#ifdef CHIP8_FUZZ_ABORT_ON_STACK_FAULT
+        std::abort();
+#endif
+    }
+    return 0;
+}
+
+#ifndef CHIP8_LIBFUZZER
+
+// ============================================================================
+// Fuzzer standalone (sem libFuzzer): corpus em memória + mutação aleatória
+// ============================================================================
+namespace {
+
+typedef std::vector<uint8_t> Bytes;
+
+bool readFile(const char* path, Bytes& out) {
+    std::ifstream file(path, std::ios::binary);
+    if(!file.is_open()) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+void writeFile(const std::string& path, const Bytes& data) {
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+// Roda uma entrada e devolve quantas arestas novas ela cobriu
+size_t runAndMerge(const Bytes& data, uint8_t* virgin) {
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+
+    size_t fresh = 0;
+    for(size_t i = 0; i < touchedCount; ++i) {
+        size_t index = touched[i];
+        edgeMap[index] = 0;
+        if(!virgin[index]) {
+            virgin[index] = 1;
+            ++fresh;
+        }
+    }
+    return fresh;
+}
+
+void mutate(Bytes& data, std::mt19937& rng) {
+    const size_t maxSize = 1 + 15 * 2 + (4096 - 0x200);
+    int rounds = 1 + static_cast<int>(rng() % 4);
+
+    for(int r = 0; r < rounds; ++r) {
+        if(data.empty()) data.push_back(0);
+        size_t pos = rng() % data.size();
+
+        switch(rng() % 5) {
+            case 0:     // Inverte um bit
+                data[pos] ^= static_cast<uint8_t>(1 << (rng() % 8));
+                break;
+            case 1:     // Byte aleatório
+                data[pos] = static_cast<uint8_t>(rng());
+                break;
+            case 2:     // Insere uma instrução aleatória
+                if(data.size() + 2 <= maxSize) {
+                    uint8_t op[2] = {static_cast<uint8_t>(rng()), static_cast<uint8_t>(rng())};
+                    data.insert(data.begin() + pos, op, op + 2);
+                }
+                break;
+            case 3:     // Remove dois bytes
+                if(data.size() > 3) {
+                    data.erase(data.begin() + pos,
+                               data.begin() + std::min(pos + 2, data.size()));
+                }
+                break;
+            case 4:     // Copia um trecho para outro ponto (reaproveita laços)
+                if(data.size() > 4) {
+                    size_t from = rng() % data.size();
+                    size_t length = 1 + rng() % std::min<size_t>(16, data.size() - from);
+                    Bytes chunk(data.begin() + from, data.begin() + from + length);
+                    size_t to = rng() % data.size();
+                    for(size_t i = 0; i < length && to + i < data.size(); ++i) {
+                        data[to + i] = chunk[i];
+                    }
+                }
+                break;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t iterations = 1000000;
+    uint32_t seed = 1;
+    std::vector<Bytes> corpus;
+
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(arg == "-n" && i + 1 < argc) {
+            iterations = std::strtoull(argv[++i], nullptr, 10);
+        } else if(arg == "-seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            Bytes data;
+            if(!readFile(argv[i], data)) {
+                std::fprintf(stderr, "Erro ao abrir entrada: %s\n", argv[i]);
+                return 1;
+            }
+            corpus.push_back(data);
+        }
+    }
+
+    if(corpus.empty()) {
+        // Semente mínima: nenhum evento, um 00E0
+        Bytes data;
+        data.push_back(0x00);
+        data.push_back(0x00);
+        data.push_back(0xE0);
+        corpus.push_back(data);
+    }
+
+    static uint8_t virgin[MAP_SIZE];
+    size_t edges = 0;
+    for(size_t i = 0; i < corpus.size(); ++i) {
+        edges += runAndMerge(corpus[i], virgin);
+    }
+
+    std::mt19937 rng(seed);
+    uint64_t lastFaults = stackFaults;
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint64_t n = 1; n <= iterations; ++n) {
+        Bytes candidate = corpus[rng() % corpus.size()];
+        mutate(candidate, rng);
+
+        size_t fresh = runAndMerge(candidate, virgin);
+        if(fresh) {
+            edges += fresh;
+            corpus.push_back(candidate);
+        }
+
+        if(stackFaults != lastFaults) {
+            if(lastFaults == 0) {
+                writeFile("stack-fault.bin", candidate);
+            }
+            lastFaults = stackFaults;
+        }
+
+        if((n & 0xFFFF) == 0 || n == iterations) {
+            double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            std::printf("#%llu arestas: %zu corpus: %zu falhas de pilha: %llu exec/s: %.0f\n",
+                        static_cast<unsigned long long>(n), edges, corpus.size(),
+                        static_cast<unsigned long long>(stackFaults),
+                        seconds > 0 ? n / seconds : 0.0);
+        }
+    }
+    return 0;
+}
+
+#endif // CHIP8_LIBFUZZER
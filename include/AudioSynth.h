@@ -0,0 +1,161 @@
+// ============================================================================
+// AudioSynth.h - Síntese de áudio a partir do sound timer
+// ============================================================================
+#ifndef AUDIO_SYNTH_H
+#define AUDIO_SYNTH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "SpscRing.h"
+
+// Converte a atividade do sound timer em PCM 16-bit mono. A forma de onda é
+// um padrão de 128 bits tocado em loop (o buffer de áudio do XO-CHIP); sem
+// XO-CHIP usa-se um padrão fixo que soa como onda quadrada de 500 Hz.
+// As bordas do padrão são suavizadas com PolyBLEP (limitado em banda) e o
+// liga/desliga passa por uma rampa curta para evitar cliques.
+class AudioSynth {
+public:
+    static constexpr uint32_t DEFAULT_SAMPLE_RATE = 44100;
+    static constexpr size_t PATTERN_SIZE = 16;      // 16 bytes = 128 bits
+    static constexpr uint8_t DEFAULT_PITCH = 64;    // 4000 bits/s
+    static constexpr uint32_t FRAME_RATE = 60;
+
+private:
+    static constexpr size_t PATTERN_BITS = PATTERN_SIZE * 8;
+
+    uint32_t sampleRate;
+    uint8_t pattern[PATTERN_SIZE];
+    uint8_t pitch;
+
+    double phase;       // Posição no padrão, em bits
+    double phaseStep;   // Bits avançados por amostra (< 1)
+    float gain;         // Envelope atual (0..1)
+    float gainStep;     // Variação do envelope por amostra
+    int16_t volume;
+
+    uint32_t frameRemainder;    // Acumula a fração de amostras por frame
+    uint64_t droppedSamples;
+    std::vector<int16_t> scratch;
+
+    int level(size_t bit) const {
+        bit %= PATTERN_BITS;
+        return (pattern[bit >> 3] & (0x80 >> (bit & 7))) ? 1 : -1;
+    }
+
+    // Resíduo PolyBLEP para um degrau de altura 2 em t (frações de amostra)
+    static float polyBlep(double t) {
+        if(t >= 0.0) {
+            double x = 1.0 - t;
+            return static_cast<float>(-x * x);
+        }
+        double x = 1.0 + t;
+        return static_cast<float>(x * x);
+    }
+
+    void updatePhaseStep() {
+        double bitRate = 4000.0 * std::pow(2.0, (static_cast<int>(pitch) - 64) / 48.0);
+        phaseStep = bitRate / sampleRate;
+        // Acima da taxa de amostragem não há como limitar a banda
+        if(phaseStep > 0.99) phaseStep = 0.99;
+    }
+
+    float nextSample() {
+        size_t bit = static_cast<size_t>(phase);
+        double frac = phase - bit;
+        int current = level(bit);
+        float value = static_cast<float>(current);
+
+        // Borda que acabou de passar (entre bit-1 e bit)
+        if(frac < phaseStep) {
+            int step = current - level(bit + PATTERN_BITS - 1);
+            if(step) value += (step / 2) * polyBlep(frac / phaseStep);
+        }
+        // Borda que está para chegar (entre bit e bit+1)
+        if(frac > 1.0 - phaseStep) {
+            int step = level(bit + 1) - current;
+            if(step) value += (step / 2) * polyBlep((frac - 1.0) / phaseStep);
+        }
+
+        phase += phaseStep;
+        if(phase >= PATTERN_BITS) phase -= PATTERN_BITS;
+        return value;
+    }
+
+public:
+    explicit AudioSynth(uint32_t rate = DEFAULT_SAMPLE_RATE)
+        : sampleRate(rate ? rate : DEFAULT_SAMPLE_RATE),
+          pitch(DEFAULT_PITCH), volume(8000),
+          scratch(sampleRate / FRAME_RATE + 1) {
+        // Rampa de ~2 ms para ligar/desligar
+        gainStep = 500.0f / sampleRate;
+        reset();
+    }
+
+    void reset() {
+        std::memset(pattern, 0xF0, PATTERN_SIZE);
+        pitch = DEFAULT_PITCH;
+        phase = 0.0;
+        gain = 0.0f;
+        frameRemainder = 0;
+        droppedSamples = 0;
+        updatePhaseStep();
+    }
+
+    // Interface XO-CHIP: F002 (carrega o padrão) e FX3A (pitch)
+    void setPattern(const uint8_t* data) {
+        std::memcpy(pattern, data, PATTERN_SIZE);
+    }
+
+    void setPitch(uint8_t value) {
+        pitch = value;
+        updatePhaseStep();
+    }
+
+    void setVolume(int16_t value) { volume = value; }
+
+    // Gera count amostras; active normalmente vem de Chip8::shouldBeep()
+    void render(bool active, int16_t* out, size_t count) {
+        float target = active ? 1.0f : 0.0f;
+
+        for(size_t i = 0; i < count; ++i) {
+            if(gain < target) {
+                gain = std::min(target, gain + gainStep);
+            } else if(gain > target) {
+                gain = std::max(target, gain - gainStep);
+            }
+
+            if(gain == 0.0f) {
+                // Silêncio: mantém a fase andando para não reiniciar a onda
+                phase += phaseStep;
+                if(phase >= PATTERN_BITS) phase -= PATTERN_BITS;
+                out[i] = 0;
+                continue;
+            }
+
+            out[i] = static_cast<int16_t>(nextSample() * gain * volume);
+        }
+    }
+
+    // Gera as amostras de um tick de 60 Hz e empurra para o ring sem
+    // bloquear. O que não couber é descartado e contabilizado.
+    size_t renderFrame(bool active, SpscRing<int16_t>& ring) {
+        frameRemainder += sampleRate;
+        size_t count = frameRemainder / FRAME_RATE;
+        frameRemainder %= FRAME_RATE;
+
+        render(active, scratch.data(), count);
+        size_t pushed = ring.push(scratch.data(), count);
+        droppedSamples += count - pushed;
+        return pushed;
+    }
+
+    uint32_t getSampleRate() const { return sampleRate; }
+    uint8_t getPitch() const { return pitch; }
+    uint64_t getDroppedSamples() const { return droppedSamples; }
+};
+
+#endif // AUDIO_SYNTH_H
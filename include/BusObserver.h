@@ -0,0 +1,145 @@
+// ============================================================================
+// BusObserver.h - Políticas de observação de Memory, Registers e Display
+// ============================================================================
+#ifndef BUS_OBSERVER_H
+#define BUS_OBSERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Os componentes herdam da política escolhida em tempo de compilação e
+// chamam os hooks abaixo em cada acesso. Com NullObserver (classe vazia,
+// métodos inline vazios) a herança não ocupa espaço e as chamadas somem
+// na otimização; TracingObserver grava registros binários compactos.
+
+enum TraceKind : uint8_t {
+    TRACE_MEMORY_READ = 1,
+    TRACE_MEMORY_WRITE,
+    TRACE_REGISTER_V,       // index = registrador
+    TRACE_REGISTER_I,
+    TRACE_REGISTER_PC,
+    TRACE_REGISTER_SP,      // value = novo SP, address = valor empilhado/desempilhado
+    TRACE_DELAY_TIMER,
+    TRACE_SOUND_TIMER,
+    TRACE_DISPLAY_CLEAR,
+    TRACE_DISPLAY_DRAW      // address = x | (y << 8), index = altura, value = colisão
+};
+
+// 6 bytes, sem padding
+struct TraceRecord {
+    uint8_t kind;
+    uint8_t index;
+    uint16_t address;
+    uint16_t value;
+};
+
+// Política padrão: nada é gravado e nada é gerado
+struct NullObserver {
+    void onMemoryRead(uint16_t, uint8_t) const {}
+    void onMemoryWrite(uint16_t, uint8_t) const {}
+    void onMemoryReadSpan(uint16_t, const uint8_t*, size_t) const {}
+    void onMemoryWriteSpan(uint16_t, const uint8_t*, size_t) const {}
+    void onRegisterWrite(TraceKind, uint8_t, uint16_t, uint16_t = 0) const {}
+    void onDisplayClear() const {}
+    void onDisplayDraw(uint8_t, uint8_t, uint8_t, bool) const {}
+};
+
+// Grava cada evento num ring buffer próprio de cada instância. Quando o
+// buffer enche os registros mais antigos são sobrescritos.
+class TracingObserver {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+private:
+    struct Buffer {
+        std::vector<TraceRecord> records;
+        size_t mask;
+        uint64_t total;
+
+        explicit Buffer(size_t capacity) : records(capacity), mask(capacity - 1), total(0) {}
+    };
+
+    // O buffer fica no heap para que os hooks possam ser const (os
+    // componentes chamam o observador também de métodos const como read)
+    std::unique_ptr<Buffer> buffer;
+
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 1;
+        while(result < value) result <<= 1;
+        return result;
+    }
+
+    void record(uint8_t kind, uint8_t index, uint16_t address, uint16_t value) const {
+        TraceRecord& r = buffer->records[buffer->total++ & buffer->mask];
+        r.kind = kind;
+        r.index = index;
+        r.address = address;
+        r.value = value;
+    }
+
+public:
+    explicit TracingObserver(size_t capacity = DEFAULT_CAPACITY)
+        : buffer(new Buffer(roundUpPow2(capacity < 2 ? 2 : capacity))) {}
+
+    // Cópias começam com um trace vazio do mesmo tamanho
+    TracingObserver(const TracingObserver& other)
+        : buffer(new Buffer(other.buffer->records.size())) {}
+    TracingObserver& operator=(const TracingObserver&) {
+        clearTrace();
+        return *this;
+    }
+
+    void onMemoryRead(uint16_t address, uint8_t value) const {
+        record(TRACE_MEMORY_READ, 0, address, value);
+    }
+    void onMemoryWrite(uint16_t address, uint8_t value) const {
+        record(TRACE_MEMORY_WRITE, 0, address, value);
+    }
+    void onMemoryReadSpan(uint16_t address, const uint8_t* data, size_t count) const {
+        for(size_t i = 0; i < count; ++i) {
+            record(TRACE_MEMORY_READ, 0, (address + i) & 0xFFF, data[i]);
+        }
+    }
+    void onMemoryWriteSpan(uint16_t address, const uint8_t* data, size_t count) const {
+        for(size_t i = 0; i < count; ++i) {
+            record(TRACE_MEMORY_WRITE, 0, (address + i) & 0xFFF, data[i]);
+        }
+    }
+    void onRegisterWrite(TraceKind kind, uint8_t index, uint16_t value, uint16_t address = 0) const {
+        record(kind, index, address, value);
+    }
+    void onDisplayClear() const {
+        record(TRACE_DISPLAY_CLEAR, 0, 0, 0);
+    }
+    void onDisplayDraw(uint8_t x, uint8_t y, uint8_t height, bool collision) const {
+        record(TRACE_DISPLAY_DRAW, height, static_cast<uint16_t>(x | (y << 8)), collision ? 1 : 0);
+    }
+
+    // Copia os registros retidos, do mais antigo para o mais recente
+    void copyTrace(std::vector<TraceRecord>& out) const {
+        size_t capacity = buffer->records.size();
+        uint64_t total = buffer->total;
+        size_t kept = total < capacity ? static_cast<size_t>(total) : capacity;
+
+        out.resize(kept);
+        for(size_t i = 0; i < kept; ++i) {
+            out[i] = buffer->records[(total - kept + i) & buffer->mask];
+        }
+    }
+
+    void clearTrace() const { buffer->total = 0; }
+    uint64_t getTraceCount() const { return buffer->total; }
+    size_t getTraceCapacity() const { return buffer->records.size(); }
+};
+
+// Seleção da política para o build inteiro: -DCHIP8_TRACE liga o trace em
+// Memory, Registers e Display sem mudar nenhuma outra linha de código
+#ifdef CHIP8_TRACE
+typedef TracingObserver DefaultObserver;
+#else
+typedef NullObserver DefaultObserver;
+#endif
+
+#endif // BUS_OBSERVER_H
@@ -4,6 +4,17 @@
 #ifndef CPU_H
 #define CPU_H
 
+#include <cstdint>
+#include <random>
+
+#include "Memory.h"
+#include "Registers.h"
+#include "Display.h"
+#include "Input.h"
+#include "Opcode.h"
+#include "InstructionSet.h"
+#include "VipTiming.h"
+
 class CPU {
 private:
     Memory& memory;
@@ -18,15 +29,41 @@ public:
           instructionSet(mem, reg, disp, inp) {}
     
     void cycle() {
+        step();
+        tickTimers();
+    }
+    
+    // Apenas fetch-decode-execute, sem timers
+    void step() {
         // Fetch
-        uint16_t pc = registers.getPC();
-        uint16_t opcode = (memory.read(pc) << 8) | memory.read(pc + 1);
+        uint16_t opcode = memory.fetchOpcode(registers.getPC());
         
         // Decode & Execute
         Opcode op(opcode);
         instructionSet.execute(op);
+    }
+    
+    // step() com o custo da instrução no COSMAC VIP. Retorna ciclos de
+    // máquina, com VipTiming::WAIT_VBLANK quando a instrução espera a
+    // próxima interrupção de vídeo.
+    uint32_t step(const VipTiming& timing) {
+        uint16_t pc = registers.getPC();
+        uint16_t opcode = memory.fetchOpcode(pc);
+        uint32_t entry = timing.lookup(opcode);
         
-        // Atualiza timers
+        if(!(entry & VipTiming::DYNAMIC)) {
+            instructionSet.execute(Opcode(opcode));
+            return entry;
+        }
+        
+        uint8_t vx = registers.getV((opcode >> 8) & 0xF);
+        instructionSet.execute(Opcode(opcode));
+        bool skipped = registers.getPC() == static_cast<uint16_t>(pc + 4);
+        return VipTiming::resolve(opcode, entry, vx, skipped);
+    }
+    
+    // Tick de 60 Hz dos timers
+    void tickTimers() {
         registers.decrementDelayTimer();
         registers.decrementSoundTimer();
     }
@@ -34,6 +71,17 @@ public:
     void reset() {
         registers.reset();
     }
+    
+    void seedRandom(uint32_t seed) {
+        instructionSet.seedRandom(seed);
+    }
+    
+    const std::default_random_engine& getRandomState() const {
+        return instructionSet.getRandomState();
+    }
+    void setRandomState(const std::default_random_engine& state) {
+        instructionSet.setRandomState(state);
+    }
 };
 
 #endif // CPU_H
\ No newline at end of file
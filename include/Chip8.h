@@ -4,10 +4,46 @@
 #ifndef CHIP8_H
 #define CHIP8_H
 
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <thread>
 #include <vector>
 
+#include "CPU.h"
+#include "FramePacer.h"
+#include "RomProfile.h"
+
+// Cópia completa do estado da máquina para reset rápido (fuzzing, testes).
+// Não inclui eventos de entrada pendentes.
+struct Chip8Snapshot {
+    Memory memory;
+    Registers registers;
+    Display display;
+    uint16_t keyMask;
+    uint64_t frameCount;
+    std::default_random_engine random;  // Gerador do CXNN
+};
+
+// Configuração do loop principal
+struct RunOptions {
+    uint32_t cyclesPerFrame;    // Instruções por frame de 60 Hz
+    double speed;               // Múltiplo do tempo real; <= 0 = sem limite
+    uint32_t maxCatchUpFrames;  // Frames seguidos antes de ressincronizar
+    bool vipTiming;             // Frames pelo custo no COSMAC VIP, ignora cyclesPerFrame
+
+    RunOptions() : cyclesPerFrame(10), speed(1.0), maxCatchUpFrames(10), vipTiming(false) {}
+};
+
+// O que a máquina espera numa fronteira de frame (ver Chip8::idleWait())
+enum class IdleWait {
+    None,       // Executa normalmente
+    Key,        // FX0A sem tecla: só uma tecla a tira da espera
+    Timer,      // Laço lendo DT: só o tempo a tira da espera
+    Halted      // Trap: parada até initialize()
+};
+
 class Chip8 {
 private:
     Memory memory;
@@ -15,9 +51,16 @@ private:
     Display display;
     Input input;
     CPU cpu;
+    uint64_t frameCount;
+    uint64_t skippedPresents;
+    VipTiming vipTiming;
+    uint64_t machineCycles;     // Ciclos de máquina do VIP desde initialize()
+    uint64_t frameEndCycle;     // Fim do frame atual em machineCycles
+    uint64_t romHash;           // RomProfile::hashRom da ROM carregada
 
 public:
-    Chip8() : cpu(memory, registers, display, input) {}
+    Chip8() : cpu(memory, registers, display, input), frameCount(0), skippedPresents(0),
+              machineCycles(0), frameEndCycle(0), romHash(0) {}
     
     void initialize() {
         memory.clear();
@@ -25,6 +68,19 @@ public:
         registers.reset();
         display.clear();
         input.clear();
+        frameCount = 0;
+        skippedPresents = 0;
+        machineCycles = 0;
+        frameEndCycle = 0;
+        romHash = 0;
+    }
+    
+    // Carrega uma ROM já em memória (sem log). O hash do conteúdo é a
+    // chave do perfil persistente da ROM (RomProfile).
+    bool loadROM(const uint8_t* data, size_t size) {
+        if(!memory.loadProgram(data, size)) return false;
+        romHash = RomProfile::hashRom(data, size);
+        return true;
     }
     
     bool loadROM(const char* filename) {
@@ -44,7 +100,7 @@ public:
             return false;
         }
         
-        if(!memory.loadProgram(buffer.data(), size)) {
+        if(!loadROM(buffer.data(), size)) {
             std::cerr << "ROM muito grande!" << std::endl;
             return false;
         }
@@ -57,11 +113,271 @@ public:
         cpu.cycle();
     }
     
+    // Partes de um ciclo, para quem controla o frame por conta própria
+    void step() {
+        cpu.step();
+    }
+    
+    void tickTimers() {
+        cpu.tickTimers();
+    }
+    
+    // Aplica os eventos de tecla enfileirados por outras threads. Deve ser
+    // chamado pela thread de emulação entre ciclos (tipicamente no início
+    // de cada frame), nunca no meio de uma instrução.
+    size_t applyInput(uint64_t now) {
+        return input.applyPending(now);
+    }
+    
+    // Um frame de 60 Hz: aplica a entrada com o número do frame como
+    // timestamp, executa cyclesPerFrame instruções e decrementa os timers
+    // uma única vez
+    void runFrame(uint32_t cyclesPerFrame) {
+        runFrame(cyclesPerFrame, [](){});
+    }
+    
+    // Igual, chamando afterStep() depois de cada instrução (cobertura,
+    // condições de parada). O hook é inline, sem custo quando vazio.
+    //
+    // Uma instância com trap está parada: o frame não faz nada. No frame em
+    // que o trap acontece as instruções restantes repetem a que falhou, sem
+    // efeito, então não há teste de trap por instrução.
+    template<typename StepHook>
+    void runFrame(uint32_t cyclesPerFrame, StepHook afterStep) {
+        if(registers.isTrapped()) return;
+        input.applyPending(frameCount);
+        for(uint32_t i = 0; i < cyclesPerFrame; ++i) {
+            cpu.step();
+            afterStep();
+        }
+        cpu.tickTimers();
+        ++frameCount;
+    }
+
+    // Como runFrame(), mas sai logo depois da instrução em que stop()
+    // retornar true, sem decrementar os timers nem contar o frame: o estado
+    // fica exatamente o daquela instrução. Retorna quantas instruções
+    // executou; quem chama sabe pelo próprio stop() se o frame terminou.
+    template<typename StopCondition>
+    uint32_t runFrameUntil(uint32_t cyclesPerFrame, StopCondition stop) {
+        if(registers.isTrapped()) return 0;
+        input.applyPending(frameCount);
+        for(uint32_t i = 0; i < cyclesPerFrame; ++i) {
+            cpu.step();
+            if(stop()) return i + 1;
+        }
+        cpu.tickTimers();
+        ++frameCount;
+        return cyclesPerFrame;
+    }
+
+    // Um frame de 60 Hz no tempo do COSMAC VIP: executa instruções até
+    // esgotar os ciclos disponíveis no frame. O excesso da última instrução
+    // passa para o frame seguinte; DXYN espera a interrupção de vídeo e
+    // encerra o frame.
+    void runVipFrame() {
+        if(registers.isTrapped()) return;
+        input.applyPending(frameCount);
+        frameEndCycle += VipTiming::CYCLES_AVAILABLE;
+        while(machineCycles < frameEndCycle) {
+            uint32_t cost = cpu.step(vipTiming);
+            if(cost & VipTiming::WAIT_VBLANK) {
+                machineCycles += cost & VipTiming::COST_MASK;
+                if(machineCycles < frameEndCycle) machineCycles = frameEndCycle;
+                break;
+            }
+            machineCycles += cost;
+        }
+        cpu.tickTimers();
+        ++frameCount;
+    }
+    
+    // Frame no modo escolhido em options; o teste é por frame, não por
+    // instrução, e o modo padrão continua sem contabilidade de ciclos
+    void runFrame(const RunOptions& options) {
+        if(options.vipTiming) {
+            runVipFrame();
+        } else {
+            runFrame(options.cyclesPerFrame);
+        }
+    }
+    
+    // Loop principal. Em tempo real (speed > 0) roda frames inteiros para
+    // acompanhar o relógio do host e chama present() uma vez por rodada;
+    // quando atrasado emula todos os frames devidos e apresenta só o
+    // último. Sem limite (speed <= 0) emula o mais rápido possível e
+    // apresenta no máximo 60 vezes por segundo de tempo do host.
+    // afterFrame() roda depois de cada frame emulado, inclusive os de uma
+    // rodada de catch-up: o que segue o tempo emulado (som, persistência)
+    // fica ali, e não em present().
+    // Também termina num trap (ver getTrap()). Retorna o número de frames
+    // emulados.
+    uint64_t run(const RunOptions& options,
+                 const std::function<bool()>& keepRunning,
+                 const std::function<void()>& present = std::function<void()>(),
+                 const std::function<void()>& afterFrame = std::function<void()>()) {
+        typedef FramePacer::Clock Clock;
+        uint64_t startFrame = frameCount;
+
+        if(options.speed <= 0.0) {
+            FramePacer presentPacer(1.0, 1);
+            while(keepRunning() && !registers.isTrapped()) {
+                runFrame(options);
+                if(afterFrame) afterFrame();
+                if(presentPacer.framesDue(Clock::now()) > 0) {
+                    presentPacer.advance(1);
+                    if(present) present();
+                } else {
+                    ++skippedPresents;
+                }
+            }
+            return frameCount - startFrame;
+        }
+
+        FramePacer pacer(options.speed, options.maxCatchUpFrames);
+        while(keepRunning() && !registers.isTrapped()) {
+            uint32_t due = pacer.framesDue(Clock::now());
+            if(due == 0) {
+                std::this_thread::sleep_until(pacer.getNextFrameTime());
+                continue;
+            }
+
+            for(uint32_t i = 0; i < due; ++i) {
+                runFrame(options);
+                if(afterFrame) afterFrame();
+            }
+            pacer.advance(due);
+            skippedPresents += due - 1;
+            if(present) present();
+        }
+        return frameCount - startFrame;
+    }
+    
+    // Numa fronteira de frame, diz se os próximos frames não fazem nada além
+    // de contar o tempo, e quantos (frames):
+    //  Key   - PC em FX0A sem tecla pressionada nem eventos pendentes: todo
+    //          frame só decrementa os timers até chegar uma tecla (frames =
+    //          UINT32_MAX)
+    //  Timer - PC no laço "L: FX07; 3XNN; 1L" com DT > NN: nos próximos
+    //          DT - NN frames o laço não sai
+    // O modo VIP e frames com menos de 3 instruções nunca ficam ociosos.
+    IdleWait idleWait(const RunOptions& options, uint32_t& frames) const {
+        frames = 0;
+        if(registers.isTrapped()) return IdleWait::Halted;
+        if(options.vipTiming || options.cyclesPerFrame < 3 || input.hasPending()) {
+            return IdleWait::None;
+        }
+
+        uint16_t pc = registers.getPC();
+        uint16_t opcode = memory.fetchOpcode(pc);
+        if((opcode & 0xF0FF) == 0xF00A && input.getKeyMask() == 0) {
+            frames = UINT32_MAX;
+            return IdleWait::Key;
+        }
+
+        uint16_t loop;
+        uint8_t x, target;
+        if(!findTimerLoop(loop, x, target)) return IdleWait::None;
+        uint8_t delay = registers.getDelayTimer();
+        if(delay <= target) return IdleWait::None;
+        // Entrando no SE: o VX lido antes ainda decide este frame
+        if(pc == loop + 2 && registers.getV(x) == target) return IdleWait::None;
+        frames = delay - target;
+        return IdleWait::Timer;
+    }
+
+    // Avança frames ociosos sem executar instruções, deixando a máquina como
+    // frames chamadas a runFrame(options) deixariam. frames não pode passar
+    // do devolvido por idleWait().
+    void skipIdleFrames(uint32_t frames, const RunOptions& options) {
+        if(frames == 0 || registers.isTrapped()) return;
+
+        uint16_t loop;
+        uint8_t x, target;
+        if((memory.fetchOpcode(registers.getPC()) & 0xF0FF) != 0xF00A &&
+           findTimerLoop(loop, x, target)) {
+            // Cada frame executa ao menos um FX07: VX fica com o DT do
+            // último frame pulado, e o PC avança cyclesPerFrame posições
+            // no laço de 3 instruções
+            uint32_t phase = (registers.getPC() - loop) / 2;
+            uint64_t steps = static_cast<uint64_t>(frames) * options.cyclesPerFrame;
+            registers.setV(x, static_cast<uint8_t>(registers.getDelayTimer() - (frames - 1)));
+            registers.setPC(static_cast<uint16_t>(loop + 2 * ((phase + steps) % 3)));
+        }
+
+        uint8_t delay = registers.getDelayTimer();
+        uint8_t sound = registers.getSoundTimer();
+        registers.setDelayTimer(delay > frames ? static_cast<uint8_t>(delay - frames) : 0);
+        registers.setSoundTimer(sound > frames ? static_cast<uint8_t>(sound - frames) : 0);
+        frameCount += frames;
+    }
+    
+    uint64_t getMachineCycles() const { return machineCycles; }
+    uint64_t getRomHash() const { return romHash; }
+    
+    // Falha que parou a máquina (Trap::None se está rodando). O PC aponta
+    // para a instrução que falhou; initialize() volta a rodar.
+    Trap getTrap() const { return registers.getTrap(); }
+    
+    void saveSnapshot(Chip8Snapshot& snapshot) const {
+        snapshot.memory = memory;
+        snapshot.registers = registers;
+        snapshot.display = display;
+        snapshot.keyMask = input.getKeyMask();
+        snapshot.frameCount = frameCount;
+        snapshot.random = cpu.getRandomState();
+    }
+    
+    void restoreSnapshot(const Chip8Snapshot& snapshot) {
+        memory = snapshot.memory;
+        registers = snapshot.registers;
+        display = snapshot.display;
+        input.clear();      // Descarta eventos pendentes da execução anterior
+        input.setKeyMask(snapshot.keyMask);
+        frameCount = snapshot.frameCount;
+        cpu.setRandomState(snapshot.random);
+    }
+    
+    void seedRandom(uint32_t seed) {
+        cpu.seedRandom(seed);
+    }
+    
     // Interface pública para componentes
+    const Memory& getMemory() const { return memory; }
     const Display& getDisplay() const { return display; }
     Input& getInput() { return input; }
+    const Input& getInput() const { return input; }
     const Registers& getRegisters() const { return registers; }
     bool shouldBeep() const { return registers.getSoundTimer() > 0; }
+    uint64_t getFrameCount() const { return frameCount; }
+    uint64_t getSkippedPresents() const { return skippedPresents; }
+    
+    // true se a tela mudou desde a última chamada
+    bool takeRedraw() {
+        bool redraw = display.getNeedsRedraw();
+        display.resetRedrawFlag();
+        return redraw;
+    }
+
+private:
+    // PC dentro de "L: FX07; 3XNN; 1L" (espera DT chegar a NN)
+    bool findTimerLoop(uint16_t& loop, uint8_t& x, uint8_t& target) const {
+        uint16_t pc = registers.getPC();
+        for(uint16_t offset = 0; offset <= 4 && offset <= pc; offset += 2) {
+            uint16_t start = pc - offset;
+            uint16_t read = memory.fetchOpcode(start);
+            uint16_t test = memory.fetchOpcode(start + 2);
+            uint16_t jump = memory.fetchOpcode(start + 4);
+            if((read & 0xF0FF) == 0xF007 && (test & 0xF000) == 0x3000 &&
+               ((test >> 8) & 0xF) == ((read >> 8) & 0xF) && jump == (0x1000 | start)) {
+                loop = start;
+                x = (read >> 8) & 0xF;
+                target = test & 0xFF;
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
 #endif // CHIP8_H
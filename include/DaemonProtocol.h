@@ -0,0 +1,130 @@
+// ============================================================================
+// DaemonProtocol.h - Mensagens trocadas com o chip8d pelo socket Unix
+// ============================================================================
+#ifndef DAEMON_PROTOCOL_H
+#define DAEMON_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "FrameCodec.h"
+
+// Cada mensagem é um u32 LE com o tamanho do corpo seguido do corpo: um
+// byte de tipo e o payload. Inteiros são little-endian.
+enum class DaemonMessage : uint8_t {
+    Create = 0x01,      // Cliente: u32 instruções por frame, bytes da ROM
+    Key = 0x02,         // Cliente: u32 sessão, u8 tecla, u8 pressionada
+    Destroy = 0x03,     // Cliente: u32 sessão
+    Keyframe = 0x04,    // Cliente: u32 sessão; próximo Frame será keyframe
+    Created = 0x81,     // Daemon: u32 sessão
+    Frame = 0x82,       // Daemon: u32 sessão, u64 frame, pacote de FrameCodec
+    Closed = 0x83,      // Daemon: u32 sessão
+    Trap = 0x84,        // Daemon: u32 sessão, u8 Trap, u16 PC; a sessão parou
+    Error = 0xFF        // Daemon: texto
+};
+
+// Mensagem já recortada do buffer; payload aponta para dentro dele
+struct DaemonMessageView {
+    DaemonMessage type;
+    const uint8_t* payload;
+    size_t size;
+};
+
+class DaemonProtocol {
+public:
+    static constexpr size_t HEADER_SIZE = 4;
+    static constexpr size_t MAX_BODY = 8192;
+    static constexpr size_t FRAME_PREFIX_SIZE = 4 + 8;  // Sessão e frame antes do pacote
+
+    static void putU16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+    static void putU32(std::vector<uint8_t>& out, uint32_t value) {
+        for(int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    static void putU64(std::vector<uint8_t>& out, uint64_t value) {
+        for(int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    static uint16_t getU16(const uint8_t* data) {
+        return static_cast<uint16_t>(data[0] | (data[1] << 8));
+    }
+    static uint32_t getU32(const uint8_t* data) {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+               (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+    static uint64_t getU64(const uint8_t* data) {
+        return static_cast<uint64_t>(getU32(data)) | (static_cast<uint64_t>(getU32(data + 4)) << 32);
+    }
+
+    // Abre uma mensagem em out; devolve a posição para end()
+    static size_t begin(std::vector<uint8_t>& out, DaemonMessage type) {
+        size_t start = out.size();
+        putU32(out, 0);
+        out.push_back(static_cast<uint8_t>(type));
+        return start;
+    }
+    static void end(std::vector<uint8_t>& out, size_t start) {
+        uint32_t body = static_cast<uint32_t>(out.size() - start - HEADER_SIZE);
+        for(int i = 0; i < 4; ++i) out[start + i] = static_cast<uint8_t>(body >> (8 * i));
+    }
+
+    static void appendCreate(std::vector<uint8_t>& out, uint32_t cyclesPerFrame,
+                             const uint8_t* rom, size_t size) {
+        size_t start = begin(out, DaemonMessage::Create);
+        putU32(out, cyclesPerFrame);
+        out.insert(out.end(), rom, rom + size);
+        end(out, start);
+    }
+    static void appendKey(std::vector<uint8_t>& out, uint32_t session, uint8_t key, bool pressed) {
+        size_t start = begin(out, DaemonMessage::Key);
+        putU32(out, session);
+        out.push_back(key);
+        out.push_back(pressed ? 1 : 0);
+        end(out, start);
+    }
+    static void appendSession(std::vector<uint8_t>& out, DaemonMessage type, uint32_t session) {
+        size_t start = begin(out, type);
+        putU32(out, session);
+        end(out, start);
+    }
+    // Tela empacotada (FrameCodec::packPixels) codificada por encoder
+    static void appendFrame(std::vector<uint8_t>& out, uint32_t session, uint64_t frame,
+                            FrameEncoder& encoder, const uint8_t* packed) {
+        size_t start = begin(out, DaemonMessage::Frame);
+        putU32(out, session);
+        putU64(out, frame);
+        encoder.encodePacked(packed, out);
+        end(out, start);
+    }
+    static void appendTrap(std::vector<uint8_t>& out, uint32_t session, uint8_t trap, uint16_t pc) {
+        size_t start = begin(out, DaemonMessage::Trap);
+        putU32(out, session);
+        out.push_back(trap);
+        putU16(out, pc);
+        end(out, start);
+    }
+    static void appendError(std::vector<uint8_t>& out, const std::string& text) {
+        size_t start = begin(out, DaemonMessage::Error);
+        out.insert(out.end(), text.begin(), text.end());
+        end(out, start);
+    }
+
+    // Recorta a primeira mensagem de data. Retorna os bytes consumidos,
+    // 0 se ainda estiver incompleta ou -1 se o tamanho for inválido.
+    static long parse(const uint8_t* data, size_t size, DaemonMessageView& message) {
+        if(size < HEADER_SIZE) return 0;
+        uint32_t body = getU32(data);
+        if(body == 0 || body > MAX_BODY) return -1;
+        if(size < HEADER_SIZE + body) return 0;
+
+        message.type = static_cast<DaemonMessage>(data[HEADER_SIZE]);
+        message.payload = data + HEADER_SIZE + 1;
+        message.size = body - 1;
+        return static_cast<long>(HEADER_SIZE + body);
+    }
+};
+
+#endif // DAEMON_PROTOCOL_H
@@ -7,7 +7,11 @@
 #include <cstdint>
 #include <cstring>
 
-class Display {
+#include "BusObserver.h"
+
+// Observer: política de observação (ver BusObserver.h)
+template<typename Observer = DefaultObserver>
+class BasicDisplay : private Observer {
 private:
     static constexpr size_t WIDTH = 64;
     static constexpr size_t HEIGHT = 32;
@@ -16,17 +20,9 @@ private:
     uint8_t pixels[PIXEL_COUNT];
     bool needsRedraw;
 
-public:
-    Display() {
-        clear();
-    }
-    
-    void clear() {
-        std::memset(pixels, 0, PIXEL_COUNT);
-        needsRedraw = true;
-    }
-    
-    bool drawSprite(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t height) {
+    // XOR do sprite; com COLLISION também apura se algum pixel apagou
+    template<bool COLLISION>
+    bool blit(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t height) {
         bool collision = false;
         x %= WIDTH;
         y %= HEIGHT;
@@ -40,7 +36,7 @@ public:
                     uint16_t pixelY = (y + row) % HEIGHT;
                     uint16_t index = pixelY * WIDTH + pixelX;
                     
-                    if(pixels[index] == 1) {
+                    if(COLLISION && pixels[index] == 1) {
                         collision = true;
                     }
                     pixels[index] ^= 1;
@@ -49,8 +45,31 @@ public:
         }
         
         needsRedraw = true;
+        this->onDisplayDraw(x, y, height, collision);
         return collision;
     }
+
+public:
+    BasicDisplay() {
+        clear();
+    }
+    
+    void clear() {
+        std::memset(pixels, 0, PIXEL_COUNT);
+        needsRedraw = true;
+        this->onDisplayClear();
+    }
+    
+    bool drawSprite(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t height) {
+        return blit<true>(x, y, sprite, height);
+    }
+    
+    // Mesmo desenho sem apurar colisão, para quando VF será sobrescrito
+    // antes de ser lido (código recompilado). O observer recebe
+    // collision = false.
+    void xorSprite(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t height) {
+        blit<false>(x, y, sprite, height);
+    }
     
     const uint8_t* getPixels() const { return pixels; }
     bool getNeedsRedraw() const { return needsRedraw; }
@@ -58,6 +77,10 @@ public:
     
     static constexpr size_t getWidth() { return WIDTH; }
     static constexpr size_t getHeight() { return HEIGHT; }
+    
+    const Observer& getObserver() const { return *this; }
 };
 
+typedef BasicDisplay<> Display;
+
 #endif // DISPLAY_H
\ No newline at end of file
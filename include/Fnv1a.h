@@ -0,0 +1,23 @@
+// ============================================================================
+// Fnv1a.h - Hash FNV-1a de 64 bits
+// ============================================================================
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <cstddef>
+#include <cstdint>
+
+const uint64_t FNV1A_OFFSET = 0xcbf29ce484222325ULL;
+const uint64_t FNV1A_PRIME = 0x100000001b3ULL;
+
+// Hash de ROMs, de perfis e das telas de GoldenSuite e chip8-core. Passar
+// o resultado anterior em hash continua o mesmo hash sobre outro bloco.
+inline uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash = FNV1A_OFFSET) {
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
+#endif // FNV1A_H
@@ -0,0 +1,107 @@
+// ============================================================================
+// FrameCodec.h - Deltas compactos do framebuffer para streaming
+// ============================================================================
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Display.h"
+
+// Pacote (inteiros little-endian):
+//
+//   u8  flags       bit 0 = keyframe
+//   u32 sequência   +1 por pacote emitido
+//   u32 linhas      bit r = linha r presente
+//   linhas presentes, em ordem: tokens até o fim da linha
+//
+// Cada linha tem 8 bytes (64 pixels a 1 bit). Token: bit 7 = último token
+// da linha, bits 4-6 = bytes inalterados a pular, bits 0-3 = bytes de XOR
+// que vêm em seguida (1 a 8). Delta é XOR contra o pacote anterior;
+// keyframe é XOR contra a tela apagada. Um sprite de 5 linhas alinhado
+// custa 9 + 5 * 2 bytes.
+//
+// O pacote se delimita sozinho, então o mesmo formato serve para filas em
+// memória e para um stream de bytes: decode() informa quantos bytes usou.
+class FrameCodec {
+public:
+    static constexpr size_t ROW_BYTES = Display::getWidth() / 8;
+    static constexpr size_t ROWS = Display::getHeight();
+    static constexpr size_t PACKED_SIZE = ROW_BYTES * ROWS;
+    static constexpr size_t HEADER_SIZE = 9;
+    static constexpr uint8_t FLAG_KEYFRAME = 0x01;
+
+    static_assert(ROWS <= 32, "máscara de linhas é u32");
+    static_assert(ROW_BYTES <= 8, "token comporta no máximo 8 bytes");
+
+    // Pixels de Display (1 byte cada) para 1 bit por pixel, MSB à esquerda
+    static void packPixels(const uint8_t* pixels, uint8_t* packed) {
+        for(size_t i = 0; i < PACKED_SIZE; ++i) {
+            const uint8_t* p = pixels + i * 8;
+            packed[i] = static_cast<uint8_t>((p[0] << 7) | (p[1] << 6) | (p[2] << 5) | (p[3] << 4) |
+                                             (p[4] << 3) | (p[5] << 2) | (p[6] << 1) | p[7]);
+        }
+    }
+
+    static void unpackPixels(const uint8_t* packed, uint8_t* pixels) {
+        for(size_t i = 0; i < PACKED_SIZE * 8; ++i) {
+            pixels[i] = (packed[i >> 3] >> (7 - (i & 7))) & 1;
+        }
+    }
+};
+
+// Lado que envia. Emite keyframe no primeiro pacote, a cada
+// keyframeInterval pacotes (0 = nunca por intervalo) e após
+// requestKeyframe(), por exemplo quando um receptor perde a sincronia.
+class FrameEncoder {
+private:
+    uint8_t reference[FrameCodec::PACKED_SIZE];
+    uint32_t sequence;
+    uint32_t keyframeInterval;
+    uint32_t sinceKeyframe;
+    bool forceKeyframe;
+
+public:
+    explicit FrameEncoder(uint32_t keyframeInterval = 60);
+
+    // Anexa a out o pacote do frame (pixels de Display ou já empacotado)
+    void encode(const uint8_t* pixels, std::vector<uint8_t>& out);
+    void encodePacked(const uint8_t* packed, std::vector<uint8_t>& out);
+
+    void requestKeyframe() { forceKeyframe = true; }
+    void reset();
+
+    uint32_t getSequence() const { return sequence; }
+};
+
+enum class FrameDecodeStatus {
+    Frame,          // Frame atualizado
+    Incomplete,     // Faltam bytes: chame de novo com mais dados
+    NeedKeyframe,   // Delta fora de sequência descartado; peça keyframe
+    Corrupt         // Pacote inválido
+};
+
+// Lado que recebe. Enquanto não sincronizado (início ou perda de pacote)
+// ignora deltas até o próximo keyframe, sem nunca mostrar um frame errado.
+class FrameDecoder {
+private:
+    uint8_t packed[FrameCodec::PACKED_SIZE];
+    uint32_t sequence;
+    bool synced;
+
+public:
+    FrameDecoder();
+
+    // consumed recebe o tamanho do pacote (0 se Incomplete ou Corrupt)
+    FrameDecodeStatus decode(const uint8_t* data, size_t size, size_t& consumed);
+
+    const uint8_t* getPacked() const { return packed; }
+    void getPixels(uint8_t* pixels) const { FrameCodec::unpackPixels(packed, pixels); }
+    uint32_t getSequence() const { return sequence; }
+    bool isSynced() const { return synced; }
+    void reset();
+};
+
+#endif // FRAME_CODEC_H
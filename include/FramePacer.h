@@ -0,0 +1,81 @@
+// ============================================================================
+// FramePacer.h - Agendamento de frames em tempo real com catch-up
+// ============================================================================
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+#include <cstdint>
+
+// Decide quantos frames de 60 Hz (escalados por speed) devem ser emulados
+// para acompanhar o relógio do host. Quando o host atrasa, devolve vários
+// frames de uma vez para que o chamador os rode seguidos e apresente só o
+// último: a emulação nunca perde frames, a apresentação sim. Se o atraso
+// passar de maxCatchUp frames (debugger, suspensão) o agendamento é
+// ressincronizado em vez de tentar alcançar indefinidamente.
+class FramePacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr double FRAME_RATE = 60.0;
+
+private:
+    Clock::duration framePeriod;
+    Clock::time_point nextFrame;
+    uint32_t maxCatchUp;
+    uint64_t resyncCount;
+
+public:
+    explicit FramePacer(double speed = 1.0, uint32_t maxCatchUpFrames = 10)
+        : maxCatchUp(maxCatchUpFrames ? maxCatchUpFrames : 1), resyncCount(0) {
+        setSpeed(speed);
+        start(Clock::now());
+    }
+
+    // speed = múltiplo do tempo real (2.0 = 120 frames por segundo)
+    void setSpeed(double speed) {
+        if(speed <= 0.0) speed = 1.0;
+        framePeriod = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / (FRAME_RATE * speed)));
+        if(framePeriod.count() <= 0) framePeriod = Clock::duration(1);
+    }
+
+    void start(Clock::time_point now) {
+        nextFrame = now;
+    }
+
+    // Frames que já deveriam ter sido emulados em now (0 = adiantado)
+    uint32_t framesDue(Clock::time_point now) {
+        if(now < nextFrame) return 0;
+
+        uint64_t due = static_cast<uint64_t>((now - nextFrame) / framePeriod) + 1;
+        if(due > maxCatchUp) {
+            // Atrasado demais: descarta o tempo perdido
+            nextFrame = now - framePeriod * (maxCatchUp - 1);
+            ++resyncCount;
+            return maxCatchUp;
+        }
+        return static_cast<uint32_t>(due);
+    }
+
+    // Sem nada para emular (todas as sessões esperando), o tempo passa sem
+    // catch-up nem ressincronização: pula todos os frames devidos menos o
+    // último, que framesDue() ainda devolve. Retorna quantos pulou.
+    uint64_t skipIdle(Clock::time_point now) {
+        if(now < nextFrame) return 0;
+        uint64_t skipped = static_cast<uint64_t>((now - nextFrame) / framePeriod);
+        nextFrame += framePeriod * skipped;
+        return skipped;
+    }
+
+    // Registra que count frames foram emulados
+    void advance(uint32_t count) {
+        nextFrame += framePeriod * count;
+    }
+
+    Clock::time_point getNextFrameTime() const { return nextFrame; }
+    Clock::duration getFramePeriod() const { return framePeriod; }
+    uint64_t getResyncCount() const { return resyncCount; }
+};
+
+#endif // FRAME_PACER_H
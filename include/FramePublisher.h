@@ -0,0 +1,164 @@
+// ============================================================================
+// FramePublisher.h - Troca de frames lock-free entre emulação e renderização
+// ============================================================================
+#ifndef FRAME_PUBLISHER_H
+#define FRAME_PUBLISHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Display.h"
+
+// Cópia imutável de um frame completo
+struct Frame {
+    static constexpr size_t PIXEL_COUNT = Display::getWidth() * Display::getHeight();
+
+    uint8_t pixels[PIXEL_COUNT];
+    uint64_t sequence;      // Número do frame (começa em 1)
+};
+
+class FramePublisher;
+
+// Referência RAII a um frame publicado. Enquanto existir, o slot não é
+// reutilizado pelo produtor, então o conteúdo nunca muda durante a leitura.
+class FrameHandle {
+private:
+    const FramePublisher* owner;
+    uint32_t slot;
+
+    friend class FramePublisher;
+    FrameHandle(const FramePublisher* pub, uint32_t s) : owner(pub), slot(s) {}
+
+    void release();
+
+public:
+    FrameHandle() : owner(nullptr), slot(0) {}
+    ~FrameHandle() { release(); }
+
+    FrameHandle(FrameHandle&& other) : owner(other.owner), slot(other.slot) {
+        other.owner = nullptr;
+    }
+    FrameHandle& operator=(FrameHandle&& other) {
+        if(this != &other) {
+            release();
+            owner = other.owner;
+            slot = other.slot;
+            other.owner = nullptr;
+        }
+        return *this;
+    }
+    FrameHandle(const FrameHandle&) = delete;
+    FrameHandle& operator=(const FrameHandle&) = delete;
+
+    bool valid() const { return owner != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    const Frame& operator*() const;
+    const Frame* operator->() const { return &**this; }
+};
+
+// Triple buffering generalizado: a thread de emulação escreve num slot livre
+// e o publica com um único store atômico; qualquer número de consumidores
+// pega o frame mais recente sem locks. Com 3 slots (padrão) um consumidor
+// nunca atrasa o produtor; com mais consumidores simultâneos use
+// consumidores + 2 slots. Se todos estiverem ocupados o frame é descartado,
+// nunca esperado.
+class FramePublisher {
+private:
+    static constexpr uint32_t NO_FRAME = 0xFFFFFFFF;
+
+    std::vector<Frame> slots;
+    mutable std::vector<std::atomic<uint32_t>> readers;
+    std::atomic<uint32_t> latest;
+
+    // Estado exclusivo do produtor
+    uint64_t sequence;
+    uint64_t droppedFrames;
+
+    friend class FrameHandle;
+
+    int findFreeSlot() const {
+        uint32_t current = latest.load();
+        for(uint32_t i = 0; i < slots.size(); ++i) {
+            if(i != current && readers[i].load() == 0) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+public:
+    explicit FramePublisher(size_t slotCount = 3)
+        : slots(slotCount < 2 ? 2 : slotCount),
+          readers(slots.size()),
+          latest(NO_FRAME), sequence(0), droppedFrames(0) {
+        for(size_t i = 0; i < readers.size(); ++i) {
+            readers[i].store(0);
+        }
+    }
+
+    FramePublisher(const FramePublisher&) = delete;
+    FramePublisher& operator=(const FramePublisher&) = delete;
+
+    // Produtor (thread de emulação), chamado no vblank
+    bool publish(const uint8_t* pixels) {
+        int slot = findFreeSlot();
+        if(slot < 0) {
+            ++droppedFrames;
+            return false;
+        }
+
+        Frame& frame = slots[slot];
+        std::memcpy(frame.pixels, pixels, Frame::PIXEL_COUNT);
+        frame.sequence = ++sequence;
+
+        // seq_cst: pareado com a releitura de latest em acquire()
+        latest.store(static_cast<uint32_t>(slot));
+        return true;
+    }
+
+    bool publish(const Display& display) {
+        return publish(display.getPixels());
+    }
+
+    // Consumidores (qualquer thread)
+    FrameHandle acquire() const {
+        for(;;) {
+            uint32_t slot = latest.load();
+            if(slot == NO_FRAME) return FrameHandle();
+
+            readers[slot].fetch_add(1);
+            // Se o produtor publicou outro slot nesse meio tempo, este pode
+            // estar sendo reescrito: solta e tenta de novo
+            if(latest.load() == slot) return FrameHandle(this, slot);
+            readers[slot].fetch_sub(1);
+        }
+    }
+
+    bool copyLatest(Frame& out) const {
+        FrameHandle handle = acquire();
+        if(!handle) return false;
+        out = *handle;
+        return true;
+    }
+
+    // Estatísticas (ler apenas na thread do produtor)
+    uint64_t getPublishedCount() const { return sequence; }
+    uint64_t getDroppedFrames() const { return droppedFrames; }
+    size_t getSlotCount() const { return slots.size(); }
+};
+
+inline void FrameHandle::release() {
+    if(owner) {
+        owner->readers[slot].fetch_sub(1);
+        owner = nullptr;
+    }
+}
+
+inline const Frame& FrameHandle::operator*() const {
+    return owner->slots[slot];
+}
+
+#endif // FRAME_PUBLISHER_H
@@ -0,0 +1,133 @@
+// ============================================================================
+// FrameScheduler.h - Agendamento de tempo real brando para muitas sessões
+// ============================================================================
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Chip8.h"
+
+// Configuração do agendador
+struct FrameSchedulerOptions {
+    size_t workerThreads;       // 0 = um por núcleo
+    bool pinWorkers;            // Worker i preso ao núcleo i (Linux)
+    uint32_t maxLateFrames;     // Atraso, em frames, antes de ressincronizar
+
+    FrameSchedulerOptions() : workerThreads(0), pinWorkers(true), maxLateFrames(10) {}
+};
+
+// Estatísticas de uma sessão (ou somadas, em getTotals()). Tempos em ns.
+struct FrameStats {
+    uint64_t frames;
+    uint64_t misses;            // Frames terminados depois do deadline
+    uint64_t dropped;           // Frames descartados ao ressincronizar
+    int64_t worstLateness;      // Maior (término - deadline); negativo = sempre adiantado
+    int64_t jitter;             // Estimador do RFC 3550 sobre |intervalo - período|
+
+    FrameStats() : frames(0), misses(0), dropped(0), worstLateness(INT64_MIN), jitter(0) {}
+};
+
+// Cada sessão é uma máquina Chip8 que deve produzir um frame a cada período
+// (1/60 s dividido por RunOptions::speed). O frame n tem liberação em
+// início + n períodos e deadline um período depois.
+//
+// EDF particionado: cada sessão pertence a um worker (o com menos sessões
+// quando criada) e nunca muda de thread; com pinWorkers cada worker fica
+// num núcleo, então o estado da máquina continua no cache daquele núcleo.
+// Cada worker roda, entre as sessões já liberadas, a de deadline mais cedo,
+// e dorme até a próxima liberação quando nenhuma está pronta.
+//
+// Uma sessão atrasada roda frames seguidos até alcançar o relógio; atrasada
+// mais de maxLateFrames, pula os frames perdidos (contados em dropped).
+//
+// onFrame é chamado pelo worker depois de cada frame, fora de qualquer lock:
+// deve ser rápido (p.ex. publicar num FramePublisher).
+class FrameScheduler {
+public:
+    typedef FramePacer::Clock Clock;
+    typedef std::function<void(uint32_t session, Chip8& machine)> FrameCallback;
+
+    explicit FrameScheduler(const FrameSchedulerOptions& options = FrameSchedulerOptions(),
+                            const FrameCallback& onFrame = FrameCallback());
+    ~FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    // Inicia os workers. As sessões podem ser criadas antes ou depois.
+    void start();
+    void stop();
+
+    // Qualquer thread. Retorna o id da sessão, 0 se a ROM for inválida.
+    uint32_t addSession(const uint8_t* rom, size_t size, const RunOptions& options = RunOptions());
+
+    // Se a sessão estiver rodando um frame, ela some ao terminá-lo
+    bool removeSession(uint32_t id);
+
+    // Aplicada no início do próximo frame da sessão
+    bool postKey(uint32_t id, uint8_t key, bool pressed);
+
+    bool getStats(uint32_t id, FrameStats& stats) const;
+    FrameStats getTotals() const;       // jitter e worstLateness: o pior entre as sessões
+    size_t getSessionCount() const;
+    size_t getWorkerCount() const { return workers.size(); }
+    bool isPinned() const { return pinned.load(); }
+
+private:
+    struct Session {
+        uint32_t id;
+        Chip8 machine;
+        RunOptions options;
+        Clock::duration period;
+        Clock::time_point release;      // Do próximo frame
+        Clock::time_point deadline;     // release + period
+        Clock::time_point lastDone;
+        bool running;                   // Fora dos heaps, com o worker
+        bool removed;
+        FrameStats stats;               // Protegido pelo mutex do worker
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<Session*> pending;  // Heap pela liberação mais cedo
+        std::vector<Session*> ready;    // Já liberadas: heap pelo deadline mais cedo
+        std::map<uint32_t, std::unique_ptr<Session>> sessions;
+        std::thread thread;
+    };
+
+    FrameSchedulerOptions options;
+    FrameCallback onFrame;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> stopping;
+    std::atomic<bool> pinned;
+    bool started;
+
+    mutable std::mutex registryMutex;   // id -> worker
+    std::map<uint32_t, Worker*> registry;
+    uint32_t nextSessionId;
+
+    // Comparadores de heap: o topo é o mais cedo
+    static bool laterRelease(const Session* a, const Session* b) {
+        return a->release > b->release;
+    }
+    static bool laterDeadline(const Session* a, const Session* b) {
+        return a->deadline > b->deadline;
+    }
+
+    void workerLoop(size_t index);
+    bool pinToCore(size_t index);
+    void account(Session& session, Clock::time_point done);
+    Worker* findWorker(uint32_t id) const;
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,80 @@
+// ============================================================================
+// GoldenSuite.h - Regressão ponta a ponta por hashes de ROMs executadas
+// ============================================================================
+#ifndef GOLDEN_SUITE_H
+#define GOLDEN_SUITE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Chip8.h"
+
+// Teclas mantidas a partir de um frame (bit n = tecla n)
+struct GoldenInput {
+    uint32_t frame;
+    uint16_t keyMask;
+};
+
+// Uma ROM executada sem tela por um número fixo de frames, com entrada
+// roteirizada e semente fixa do CXNN
+struct GoldenCase {
+    std::string name;
+    std::vector<uint8_t> rom;
+    uint32_t frames;
+    uint32_t cyclesPerFrame;
+    bool vipTiming;
+    std::vector<GoldenInput> input;
+
+    GoldenCase() : frames(60), cyclesPerFrame(10), vipTiming(false) {}
+};
+
+// Hashes FNV-1a de 64 bits. O estado cobre registradores, pilha, timers,
+// trap, frames e os 4 KB de memória; a tela é hasheada à parte para que
+// uma divergência diga logo se foi no que se vê.
+struct GoldenResult {
+    std::string name;
+    uint64_t frameHash;
+    uint64_t stateHash;
+    Trap trap;
+
+    GoldenResult() : frameHash(0), stateHash(0), trap(Trap::None) {}
+};
+
+typedef std::map<std::string, GoldenResult> GoldenTable;
+
+class GoldenSuite {
+public:
+    // ROMs geradas que cobrem opcodes, flags, quirks, teclado, timers,
+    // sprites e traps, no espírito das ROMs de teste conhecidas
+    static std::vector<GoldenCase> builtinCases();
+
+    // ROM externa com os parâmetros padrão de GoldenCase; o nome do caso é
+    // o nome do arquivo
+    static bool addRomFile(const std::string& path, std::vector<GoldenCase>& cases);
+
+    static GoldenResult run(const GoldenCase& test);
+
+    // Executa em machine, que fica no estado final para inspeção
+    static GoldenResult run(const GoldenCase& test, Chip8& machine);
+
+    // Divide os casos entre jobs threads (0 = um por núcleo). Os
+    // resultados saem na ordem de cases, independente de jobs.
+    static std::vector<GoldenResult> runAll(const std::vector<GoldenCase>& cases, size_t jobs = 0);
+
+    // Arquivo texto: "nome hash_tela hash_estado trap" por linha, '#' comenta
+    static bool load(const std::string& path, GoldenTable& table);
+    static bool save(const std::string& path, const std::vector<GoldenResult>& results);
+
+    // Descreve em out cada resultado ausente ou diferente de table.
+    // Retorna quantos divergiram.
+    static size_t compare(const std::vector<GoldenResult>& results, const GoldenTable& table,
+                          std::string& out);
+
+    // Tela em texto ('#' aceso), para inspecionar um golden novo
+    static std::string renderFrame(const Display& display);
+};
+
+#endif // GOLDEN_SUITE_H
@@ -0,0 +1,204 @@
+// ============================================================================
+// HeadlessRunner.h - Execução sem frontend com condições de parada
+// ============================================================================
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Chip8.h"
+#include "Fnv1a.h"
+
+// Linha do script de entrada: "<frame> <tecla hex> down|up"
+struct RunnerKeyEvent {
+    uint64_t frame;             // Aplicado no início deste frame
+    uint8_t key;
+    bool pressed;
+};
+
+struct RunnerOptions {
+    uint32_t cyclesPerFrame;
+    uint64_t maxFrames;         // 0 = sem limite
+    uint64_t maxCycles;         // 0 = sem limite; o último frame pode ficar parcial
+    std::vector<RunnerKeyEvent> input;  // Em ordem de frame
+
+    // Condições de parada. PC e memória são testadas a cada instrução, só
+    // quando ativas; laço infinito e hash da tela, no fim de cada frame.
+    bool stopAtPc;
+    uint16_t pc;
+    bool stopOnHalt;            // 1NNN para o próprio endereço
+    bool stopOnMemory;
+    uint16_t memoryAddress;
+    uint8_t memoryValue;
+    bool stopOnFrameHash;
+    uint64_t frameHash;
+
+    RunnerOptions()
+        : cyclesPerFrame(10), maxFrames(0), maxCycles(0),
+          stopAtPc(false), pc(0), stopOnHalt(false),
+          stopOnMemory(false), memoryAddress(0), memoryValue(0),
+          stopOnFrameHash(false), frameHash(0) {}
+
+    bool hasConditions() const {
+        return stopAtPc || stopOnHalt || stopOnMemory || stopOnFrameHash;
+    }
+};
+
+enum class RunnerExit {
+    Frames,         // maxFrames
+    Cycles,         // maxCycles
+    Pc,
+    Halt,
+    Memory,
+    FrameHash,
+    Trap
+};
+
+struct RunnerResult {
+    RunnerExit exit;
+    uint64_t frames;            // Frames completos
+    uint64_t cycles;            // Instruções executadas
+
+    RunnerResult() : exit(RunnerExit::Frames), frames(0), cycles(0) {}
+};
+
+// Roda uma máquina o mais rápido possível até um limite ou condição, sem
+// nenhum teste por instrução além dos configurados: sem condições de PC ou
+// memória e sem stepHook, cada frame é um Chip8::runFrame puro.
+//
+// stepHook() roda depois de cada instrução (ProfileRecorder,
+// InstructionTracer) e frameHook(redraw) depois de cada frame completo; o
+// runner consome takeRedraw() e repassa se a tela mudou no frame.
+class HeadlessRunner {
+public:
+    template<typename StepHook, typename FrameHook>
+    static RunnerResult run(Chip8& machine, const RunnerOptions& options,
+                            StepHook stepHook, FrameHook frameHook);
+
+    static RunnerResult run(Chip8& machine, const RunnerOptions& options) {
+        return run(machine, options, []() {}, [](bool) {});
+    }
+
+    // Mesmo FNV-1a do frameHash de GoldenSuite
+    static uint64_t frameHash(const Display& display) {
+        return fnv1a(display.getPixels(), Display::getWidth() * Display::getHeight());
+    }
+
+    static bool isHalted(const Chip8& machine) {
+        uint16_t pc = machine.getRegisters().getPC();
+        return machine.getMemory().fetchOpcode(pc) == (0x1000 | pc);
+    }
+
+    // '#' comenta até o fim da linha. false (com a linha no cerr) se
+    // alguma linha for inválida; os eventos saem em ordem de frame.
+    static bool parseInputScript(std::istream& in, std::vector<RunnerKeyEvent>& events);
+    static bool loadInputScript(const std::string& path, std::vector<RunnerKeyEvent>& events);
+
+    // JSON com o motivo da parada, registradores, pilha, timers, teclas,
+    // tela (linhas de '0'/'1') e a memória inteira em hexadecimal
+    static void dumpJson(const Chip8& machine, const RunnerResult& result, std::ostream& out);
+
+    static const char* exitName(RunnerExit exit);
+};
+
+template<typename StepHook, typename FrameHook>
+RunnerResult HeadlessRunner::run(Chip8& machine, const RunnerOptions& options,
+                                 StepHook stepHook, FrameHook frameHook) {
+    RunnerResult result;
+    uint32_t cycles = options.cyclesPerFrame ? options.cyclesPerFrame : 1;
+    bool perInstruction = options.stopAtPc || options.stopOnMemory;
+    size_t nextEvent = 0;
+    RunnerExit stopped = RunnerExit::Frames;
+    bool hit = false;
+
+    // Só instanciada quando alguma condição por instrução está ativa
+    const Registers& registers = machine.getRegisters();
+    const Memory& memory = machine.getMemory();
+    auto check = [&]() -> bool {
+        if(options.stopAtPc && registers.getPC() == options.pc) {
+            stopped = RunnerExit::Pc;
+            return hit = true;
+        }
+        if(options.stopOnMemory && memory.read(options.memoryAddress) == options.memoryValue) {
+            stopped = RunnerExit::Memory;
+            return hit = true;
+        }
+        return false;
+    };
+
+    for(;;) {
+        if(options.maxFrames && result.frames >= options.maxFrames) {
+            result.exit = RunnerExit::Frames;
+            return result;
+        }
+        uint64_t budget = cycles;
+        if(options.maxCycles) {
+            if(result.cycles >= options.maxCycles) {
+                result.exit = RunnerExit::Cycles;
+                return result;
+            }
+            if(options.maxCycles - result.cycles < budget) budget = options.maxCycles - result.cycles;
+        }
+
+        // Eventos do script entram na fila com o frame como timestamp
+        uint64_t frame = machine.getFrameCount();
+        while(nextEvent < options.input.size() && options.input[nextEvent].frame <= frame) {
+            const RunnerKeyEvent& event = options.input[nextEvent++];
+            machine.getInput().postKey(event.key, event.pressed, event.frame);
+        }
+
+        uint32_t executed;
+        if(budget < cycles) {
+            // Último frame, parcial: para em budget instruções sem fechar o frame
+            uint64_t done = 0;
+            executed = machine.runFrameUntil(cycles, [&]() {
+                stepHook();
+                return (perInstruction && check()) || ++done == budget;
+            });
+        } else if(perInstruction) {
+            executed = machine.runFrameUntil(cycles, [&]() {
+                stepHook();
+                return check();
+            });
+        } else {
+            machine.runFrame(cycles, stepHook);
+            executed = registers.isTrapped() && frame == machine.getFrameCount() ? 0 : cycles;
+        }
+        result.cycles += executed;
+
+        if(hit) {
+            result.exit = stopped;
+            return result;
+        }
+        if(registers.isTrapped()) {
+            // O frame do trap termina (repetindo a instrução); os seguintes não rodam
+            if(machine.getFrameCount() != frame) ++result.frames;
+            result.exit = RunnerExit::Trap;
+            return result;
+        }
+        if(budget < cycles) {
+            result.exit = RunnerExit::Cycles;
+            return result;
+        }
+
+        ++result.frames;
+        bool redraw = machine.takeRedraw();
+        frameHook(redraw);
+
+        if(options.stopOnHalt && isHalted(machine)) {
+            result.exit = RunnerExit::Halt;
+            return result;
+        }
+        if(options.stopOnFrameHash && redraw &&
+           frameHash(machine.getDisplay()) == options.frameHash) {
+            result.exit = RunnerExit::FrameHash;
+            return result;
+        }
+    }
+}
+
+#endif // HEADLESS_RUNNER_H
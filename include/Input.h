@@ -7,36 +7,88 @@
 #include <cstdint>
 #include <cstring>
 
+#include "MpscQueue.h"
+
+// Evento de tecla enviado por threads de frontend. O timestamp é definido
+// pelo host (número do frame, ciclo ou tempo de jogo) e decide em qual
+// fronteira o evento é aplicado, o que torna a latência reproduzível.
+struct KeyEvent {
+    uint64_t timestamp;
+    uint8_t key;
+    bool pressed;
+};
+
 class Input {
 private:
     static constexpr size_t KEY_COUNT = 16;
-    uint8_t keys[KEY_COUNT];
+    static constexpr size_t EVENT_CAPACITY = 256;
+
+    uint16_t keyMask;               // Bit i = tecla i pressionada
+    MpscQueue<KeyEvent> events;
 
 public:
-    Input() {
+    Input() : events(EVENT_CAPACITY) {
         clear();
     }
     
+    // Thread de emulação
     void clear() {
-        std::memset(keys, 0, KEY_COUNT);
+        keyMask = 0;
+        KeyEvent discarded;
+        while(events.tryPop(discarded)) {}
     }
     
     void setKey(uint8_t key, bool pressed) {
         if(key < KEY_COUNT) {
-            keys[key] = pressed ? 1 : 0;
+            uint16_t bit = static_cast<uint16_t>(1u << key);
+            keyMask = pressed ? (keyMask | bit) : (keyMask & ~bit);
         }
     }
     
     bool isKeyPressed(uint8_t key) const {
-        return key < KEY_COUNT && keys[key] != 0;
+        return key < KEY_COUNT && (keyMask & (1u << key)) != 0;
     }
     
     int getAnyKeyPressed() const {
-        for(int i = 0; i < KEY_COUNT; ++i) {
-            if(keys[i]) return i;
+        if(!keyMask) return -1;
+        for(int i = 0; i < static_cast<int>(KEY_COUNT); ++i) {
+            if(keyMask & (1u << i)) return i;
         }
         return -1;
     }
+
+    uint16_t getKeyMask() const { return keyMask; }
+    void setKeyMask(uint16_t mask) { keyMask = mask; }
+
+    // Qualquer thread: enfileira sem locks. Retorna false se a tecla for
+    // inválida ou a fila estiver cheia.
+    bool postKey(uint8_t key, bool pressed, uint64_t timestamp = 0) {
+        if(key >= KEY_COUNT) return false;
+        KeyEvent event;
+        event.timestamp = timestamp;
+        event.key = key;
+        event.pressed = pressed;
+        return events.tryPush(event);
+    }
+
+    // Thread de emulação: há eventos ainda não aplicados
+    bool hasPending() const {
+        KeyEvent event;
+        return events.peek(event);
+    }
+
+    // Thread de emulação, numa fronteira de frame/ciclo: aplica em ordem os
+    // eventos com timestamp <= now. Para no primeiro evento futuro.
+    size_t applyPending(uint64_t now) {
+        size_t applied = 0;
+        KeyEvent event;
+        while(events.peek(event) && event.timestamp <= now) {
+            events.tryPop(event);
+            setKey(event.key, event.pressed);
+            ++applied;
+        }
+        return applied;
+    }
 };
 
-#endif // INPUT_H
\ No newline at end of file
+#endif // INPUT_H
@@ -7,9 +7,12 @@
 #include <random>
 #include <chrono>
 
-class Memory;
-class Registers;
-class Display;
+// Memory, Registers e Display são typedefs de templates (política de
+// observação), então não podem ser declarados antecipadamente como classes
+#include "Memory.h"
+#include "Registers.h"
+#include "Display.h"
+
 class Input;
 struct Opcode;
 
@@ -30,6 +33,22 @@ public:
           randByte(0, 255) {}
     
     void execute(const Opcode& op);
+    
+    // Semente fixa para execuções reproduzíveis (fuzzing, testes)
+    void seedRandom(uint32_t seed) {
+        rng.seed(seed);
+        randByte.reset();
+    }
+    
+    // Próximo byte do CXNN (também usado por código recompilado)
+    uint8_t randomByte() { return randByte(rng); }
+    
+    // Estado do gerador, para snapshots
+    const std::default_random_engine& getRandomState() const { return rng; }
+    void setRandomState(const std::default_random_engine& state) {
+        rng = state;
+        randByte.reset();
+    }
 
 private:
     // Categorias de instruções
@@ -37,6 +56,9 @@ private:
     void execute8xxx(const Opcode& op);
     void executeExxx(const Opcode& op);
     void executeFxxx(const Opcode& op);
+    
+    // Opcode sem instrução: registra o trap (ver Trap.h)
+    void invalidOpcode();
 };
 
 #endif // INSTRUCTION_SET_H
\ No newline at end of file
@@ -0,0 +1,268 @@
+// ============================================================================
+// InstructionTrace.h - Trace binário por instrução e leitura offline
+// ============================================================================
+#ifndef INSTRUCTION_TRACE_H
+#define INSTRUCTION_TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Uma instrução executada em 16 bytes: ciclo, PC, opcode, o primeiro
+// registrador que ela mudou (V0..VF, I, SP, DT, ST) e a faixa de memória
+// que escreveu (FX33, FX55). Arquivos são nativos (little-endian).
+struct InstructionRecord {
+    static constexpr uint8_t REG_I = 16;
+    static constexpr uint8_t REG_SP = 17;
+    static constexpr uint8_t REG_DT = 18;
+    static constexpr uint8_t REG_ST = 19;
+    static constexpr uint8_t NO_REGISTER = 0x7F;
+    static constexpr uint8_t MEMORY_WRITTEN = 0x80;     // Bit em reg
+
+    uint32_t cycleLow;
+    uint16_t cycleHigh;         // Ciclo de 48 bits
+    uint16_t pc;
+    uint16_t opcode;
+    uint16_t value;             // Novo valor do registrador
+    uint8_t reg;                // Registrador | MEMORY_WRITTEN
+    uint8_t memoryValue;        // Primeiro byte escrito
+    uint16_t memory;            // Endereço (12 bits) | (bytes - 1) << 12
+
+    uint64_t getCycle() const {
+        return cycleLow | (static_cast<uint64_t>(cycleHigh) << 32);
+    }
+    void setCycle(uint64_t cycle) {
+        cycleLow = static_cast<uint32_t>(cycle);
+        cycleHigh = static_cast<uint16_t>(cycle >> 32);
+    }
+    uint8_t getRegister() const { return reg & ~MEMORY_WRITTEN; }
+    bool wroteMemory() const { return (reg & MEMORY_WRITTEN) != 0; }
+    uint16_t getMemoryAddress() const { return memory & 0xFFF; }
+    size_t getMemoryCount() const { return wroteMemory() ? (memory >> 12) + 1 : 0; }
+
+    bool operator==(const InstructionRecord& other) const {
+        return std::memcmp(this, &other, sizeof(*this)) == 0;
+    }
+    bool operator!=(const InstructionRecord& other) const { return !(*this == other); }
+};
+
+static_assert(sizeof(InstructionRecord) == 16, "InstructionRecord deve ter 16 bytes");
+
+// Cabeçalho do arquivo, seguido dos registros
+struct TraceFileHeader {
+    char magic[8];              // "C8TRACE1"
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t capacity;          // Registros do anel; 0 = arquivo linear
+    uint64_t total;             // Registros gravados desde o início
+};
+
+static_assert(sizeof(TraceFileHeader) == 32, "TraceFileHeader deve ter 32 bytes");
+
+// Grava registros em um de dois formatos:
+//  - linear (ringCapacity = 0): todos os registros, em blocos de
+//    BUFFER_RECORDS por fwrite
+//  - anel mapeado em memória (POSIX): os últimos ringCapacity registros
+//    (arredondado para potência de 2, até MAX_RING_RECORDS) num arquivo de
+//    tamanho fixo. O cabeçalho é atualizado a cada registro, então o
+//    arquivo fica legível mesmo se o processo morrer.
+class TraceWriter {
+public:
+    static constexpr size_t BUFFER_RECORDS = 4096;
+    static constexpr uint64_t MAX_RING_RECORDS = 1ULL << 32;
+
+private:
+    std::FILE* file;
+    void* mapping;
+    size_t mappingSize;
+    TraceFileHeader* mappedHeader;
+    InstructionRecord* ring;
+    uint64_t ringMask;
+    std::vector<InstructionRecord> buffer;
+    size_t buffered;
+    uint64_t total;
+
+    void appendBuffered(const InstructionRecord& record) {
+        buffer[buffered++] = record;
+        ++total;
+        if(buffered == BUFFER_RECORDS) flush();
+    }
+
+public:
+    TraceWriter() : file(nullptr), mapping(nullptr), mappingSize(0), mappedHeader(nullptr),
+                    ring(nullptr), ringMask(0), buffered(0), total(0) {}
+    ~TraceWriter() { close(); }
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool open(const std::string& path, uint64_t ringCapacity = 0);
+    bool flush();
+    bool close();
+
+    void append(const InstructionRecord& record) {
+        if(ring) {
+            ring[total & ringMask] = record;
+            mappedHeader->total = ++total;
+        } else {
+            appendBuffered(record);
+        }
+    }
+
+    bool isOpen() const { return file || ring; }
+    uint64_t getTotal() const { return total; }
+};
+
+// Lê um trace em ordem cronológica (no anel, a partir do mais antigo retido)
+class TraceReader {
+private:
+    std::FILE* file;
+    TraceFileHeader header;
+    uint64_t count;             // Registros retidos
+    uint64_t position;          // Próximo, de 0 a count
+
+    bool seekSlot(uint64_t index);
+
+public:
+    TraceReader() : file(nullptr), count(0), position(0) {}
+    ~TraceReader() { close(); }
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    // Próximo registro; false no fim
+    bool next(InstructionRecord& record);
+
+    uint64_t size() const { return count; }
+    uint64_t getTotal() const { return header.total; }
+    bool isRing() const { return header.capacity != 0; }
+};
+
+// Faixas inclusivas de PC e opcode
+struct TraceFilter {
+    uint16_t pcFirst, pcLast;
+    uint16_t opcodeFirst, opcodeLast;
+
+    TraceFilter() : pcFirst(0), pcLast(0xFFFF), opcodeFirst(0), opcodeLast(0xFFFF) {}
+
+    bool matches(const InstructionRecord& record) const {
+        return record.pc >= pcFirst && record.pc <= pcLast &&
+               record.opcode >= opcodeFirst && record.opcode <= opcodeLast;
+    }
+};
+
+// Primeiro ponto em que dois traces diferem
+struct TraceDivergence {
+    uint64_t index;                         // Posição do registro nos dois traces
+    bool endOfFirst, endOfSecond;           // Um acabou antes do outro
+    InstructionRecord first, second;
+    std::vector<InstructionRecord> context; // Registros iguais antes da divergência
+};
+
+namespace InstructionTrace {
+
+// "LD V3, 0x12", "DRW V0, V1, 5"...
+std::string disassemble(uint16_t opcode);
+
+// Uma linha: ciclo, PC, opcode, mnemônico e efeito
+void formatRecord(std::ostream& out, const InstructionRecord& record);
+
+// true se os traces são iguais; senão preenche divergence com até
+// contextRecords registros anteriores
+bool diff(TraceReader& first, TraceReader& second, TraceDivergence& divergence,
+          size_t contextRecords = 8);
+
+} // namespace InstructionTrace
+
+// Alimenta um TraceWriter a partir de uma máquina em execução (Chip8 ou
+// qualquer tipo com getRegisters() e getMemory()). Chame step() depois de
+// cada instrução, p.ex. como hook de Chip8::runFrame:
+//
+//     machine.runFrame(cycles, [&]() { tracer.step(); });
+//
+// DT e ST só são atribuídos a FX15/FX18: o decremento de fim de frame não
+// é de nenhuma instrução. Depois de um trap as repetições da instrução que
+// falhou não são gravadas.
+template<typename Machine>
+class InstructionTracer {
+private:
+    TraceWriter& writer;
+    const Machine& machine;
+    uint64_t cycle;
+    uint16_t pc;
+    uint16_t i;
+    uint8_t sp;
+    uint8_t v[16];
+    bool trapped;
+
+    void capture() {
+        const auto& registers = machine.getRegisters();
+        pc = registers.getPC();
+        i = registers.getI();
+        sp = registers.getSP();
+        std::memcpy(v, registers.getVData(), sizeof(v));
+    }
+
+public:
+    InstructionTracer(TraceWriter& output, const Machine& target, uint64_t firstCycle = 0)
+        : writer(output), machine(target), cycle(firstCycle), trapped(false) {
+        capture();
+    }
+
+    void step() {
+        const auto& registers = machine.getRegisters();
+        if(trapped) return;
+        trapped = registers.isTrapped();
+
+        InstructionRecord record;
+        record.setCycle(cycle++);
+        record.pc = pc;
+        record.opcode = machine.getMemory().fetchOpcode(pc);
+        record.value = 0;
+        record.reg = InstructionRecord::NO_REGISTER;
+        record.memoryValue = 0;
+        record.memory = 0;
+
+        const uint8_t* now = registers.getVData();
+        if(std::memcmp(now, v, sizeof(v)) != 0) {
+            uint8_t x = 0;
+            while(now[x] == v[x]) ++x;
+            record.reg = x;
+            record.value = now[x];
+        } else if(registers.getI() != i) {
+            record.reg = InstructionRecord::REG_I;
+            record.value = registers.getI();
+        } else if(registers.getSP() != sp) {
+            record.reg = InstructionRecord::REG_SP;
+            record.value = registers.getSP();
+        } else if((record.opcode & 0xF0FF) == 0xF015) {
+            record.reg = InstructionRecord::REG_DT;
+            record.value = registers.getDelayTimer();
+        } else if((record.opcode & 0xF0FF) == 0xF018) {
+            record.reg = InstructionRecord::REG_ST;
+            record.value = registers.getSoundTimer();
+        }
+
+        // Só FX33 e FX55 escrevem na memória, a partir do I anterior
+        uint16_t store = record.opcode & 0xF0FF;
+        if(!trapped && (store == 0xF033 || store == 0xF055)) {
+            size_t bytes = store == 0xF033 ? 3 : ((record.opcode >> 8) & 0xF) + 1;
+            record.reg |= InstructionRecord::MEMORY_WRITTEN;
+            record.memory = static_cast<uint16_t>((i & 0xFFF) | ((bytes - 1) << 12));
+            record.memoryValue = machine.getMemory().read(i);
+        }
+
+        writer.append(record);
+        capture();
+    }
+
+    uint64_t getCycle() const { return cycle; }
+};
+
+#endif // INSTRUCTION_TRACE_H
@@ -0,0 +1,122 @@
+// ============================================================================
+// Lockstep.h - Execução diferencial entre motores de execução
+// ============================================================================
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Chip8.h"
+
+// Interface mínima que um motor (interpretador, blocos, código compilado)
+// expõe ao harness. O estado é trocado sempre no formato Chip8Snapshot,
+// então motores com representação interna própria só precisam converter.
+class ExecutionEngine {
+public:
+    virtual ~ExecutionEngine() {}
+
+    virtual const char* getName() const = 0;
+
+    // Estado inicial com a semente dada para o CXNN, seguido da ROM
+    virtual bool start(const uint8_t* rom, size_t size, uint32_t seed) = 0;
+
+    // Exatamente count instruções, sem tocar nos timers
+    virtual void execute(uint32_t count) = 0;
+    virtual void tickTimers() = 0;
+    virtual void setKeyMask(uint16_t mask) = 0;
+
+    virtual void saveSnapshot(Chip8Snapshot& snapshot) const = 0;
+    virtual void restoreSnapshot(const Chip8Snapshot& snapshot) = 0;
+};
+
+// Motor de referência: Chip8 com InstructionSet::execute
+class InterpreterEngine : public ExecutionEngine {
+protected:
+    Chip8 machine;
+
+public:
+    const char* getName() const override { return "interpreter"; }
+
+    bool start(const uint8_t* rom, size_t size, uint32_t seed) override {
+        machine.initialize();
+        machine.seedRandom(seed);
+        return machine.loadROM(rom, size);
+    }
+
+    void execute(uint32_t count) override {
+        for(uint32_t i = 0; i < count; ++i) {
+            machine.step();
+        }
+    }
+
+    void tickTimers() override { machine.tickTimers(); }
+    void setKeyMask(uint16_t mask) override { machine.getInput().setKeyMask(mask); }
+
+    void saveSnapshot(Chip8Snapshot& snapshot) const override {
+        machine.saveSnapshot(snapshot);
+    }
+    void restoreSnapshot(const Chip8Snapshot& snapshot) override {
+        machine.restoreSnapshot(snapshot);
+    }
+};
+
+struct LockstepOptions {
+    uint32_t checkInterval;     // Instruções entre comparações
+    uint32_t cyclesPerFrame;    // Mesma divisão em frames de Chip8::runFrame
+    uint64_t maxInstructions;
+    uint32_t seed;
+
+    LockstepOptions()
+        : checkInterval(256), cyclesPerFrame(10), maxInstructions(1000000), seed(0) {}
+};
+
+struct LockstepResult {
+    bool diverged;
+    uint64_t instructions;      // Executadas em cada motor até o fim ou a divergência
+    uint16_t pc;                // Endereço e opcode da primeira instrução divergente
+    uint16_t opcode;
+    std::string differences;    // Uma linha por campo diferente
+    Chip8Snapshot before;       // Estado comum antes da instrução divergente
+    Chip8Snapshot reference;    // Estados logo depois dela
+    Chip8Snapshot candidate;
+};
+
+// Roda dois motores sobre a mesma ROM e o mesmo roteiro de teclas, comparando
+// o estado completo a cada checkInterval instruções. Numa divergência, volta
+// ao último ponto igual e faz busca binária até a primeira instrução cujo
+// resultado difere (assume que, uma vez divergentes, os estados não voltam a
+// coincidir dentro do intervalo).
+class LockstepHarness {
+private:
+    ExecutionEngine& reference;
+    ExecutionEngine& candidate;
+    LockstepOptions options;
+    std::vector<KeyEvent> script;
+
+    uint16_t keyMaskAtFrame(uint64_t frame) const;
+    void advance(ExecutionEngine& engine, uint64_t position, uint64_t count) const;
+
+public:
+    LockstepHarness(ExecutionEngine& ref, ExecutionEngine& cand,
+                    const LockstepOptions& opts = LockstepOptions())
+        : reference(ref), candidate(cand), options(opts) {}
+
+    // Eventos com timestamp em frames, como em Input::postKey
+    void setInputScript(const std::vector<KeyEvent>& events);
+
+    // true se os motores terminaram maxInstructions com estados iguais
+    bool run(const uint8_t* rom, size_t size, LockstepResult& result);
+
+    // Lista os campos diferentes; vazio se iguais
+    static std::string compare(const Chip8Snapshot& a, const Chip8Snapshot& b);
+
+    // Registradores, pilha, timers, tela em ASCII e memória (linhas não nulas)
+    static void dumpState(std::ostream& out, const Chip8Snapshot& state);
+    static void dumpResult(std::ostream& out, const LockstepResult& result,
+                           const char* referenceName, const char* candidateName);
+};
+
+#endif // LOCKSTEP_H
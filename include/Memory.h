@@ -7,13 +7,20 @@
 #include <cstdint>
 #include <cstring>
 
-class Memory {
+#include "BusObserver.h"
+
+// Observer: política de observação (ver BusObserver.h)
+template<typename Observer = DefaultObserver>
+class BasicMemory : private Observer {
 private:
     static constexpr size_t MEMORY_SIZE = 4096;
     static constexpr size_t FONT_START = 0x000;
     static constexpr size_t PROGRAM_START = 0x200;
+    static constexpr uint16_t LAST_INSTRUCTION = MEMORY_SIZE - 2;
+    static constexpr uint8_t GUARD_BYTE = 0xFF;    // FFFF não é instrução
     
-    uint8_t data[MEMORY_SIZE];
+    // Dois bytes de guarda após a memória, só lidos por fetchOpcode()
+    uint8_t data[MEMORY_SIZE + 2];
     
     static constexpr uint8_t FONTSET[80] = {
         0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
@@ -35,9 +42,11 @@ private:
     };
 
 public:
-    Memory() {
+    BasicMemory() {
         clear();
         loadFontset();
+        data[MEMORY_SIZE] = GUARD_BYTE;
+        data[MEMORY_SIZE + 1] = GUARD_BYTE;
     }
     
     void clear() {
@@ -51,11 +60,60 @@ public:
     }
     
     uint8_t read(uint16_t address) const {
-        return data[address & 0xFFF];
+        uint8_t value = data[address & 0xFFF];
+        this->onMemoryRead(address & 0xFFF, value);
+        return value;
+    }
+    
+    // Busca da instrução em pc. Uma instrução que não cabe na memória
+    // (pc > 0xFFE) lê o opcode de guarda, inválido, e vira trap pelo
+    // caminho de opcode inválido: a escolha do índice substitui a máscara
+    // de read() e não há teste de PC em cada jump ou incremento.
+    uint16_t fetchOpcode(uint16_t pc) const {
+        size_t at = pc <= LAST_INSTRUCTION ? pc : MEMORY_SIZE;
+        this->onMemoryRead(pc & 0xFFF, data[at]);
+        this->onMemoryRead((pc + 1) & 0xFFF, data[at + 1]);
+        return static_cast<uint16_t>((data[at] << 8) | data[at + 1]);
     }
     
     void write(uint16_t address, uint8_t value) {
         data[address & 0xFFF] = value;
+        this->onMemoryWrite(address & 0xFFF, value);
+    }
+    
+    // Acesso em bloco com o mesmo wrap de read/write (0xFFF + 1 -> 0x000).
+    // O caso comum, sem cruzar o fim da memória, é um único memcpy.
+    void readSpan(uint16_t address, uint8_t* out, size_t count) const {
+        size_t start = address & 0xFFF;
+        size_t first = MEMORY_SIZE - start;
+        if(count <= first) {
+            std::memcpy(out, &data[start], count);
+        } else {
+            std::memcpy(out, &data[start], first);
+            std::memcpy(out + first, data, count - first);
+        }
+        this->onMemoryReadSpan(start, out, count);
+    }
+    
+    void writeSpan(uint16_t address, const uint8_t* in, size_t count) {
+        size_t start = address & 0xFFF;
+        size_t first = MEMORY_SIZE - start;
+        if(count <= first) {
+            std::memcpy(&data[start], in, count);
+        } else {
+            std::memcpy(&data[start], in, first);
+            std::memcpy(data, in + first, count - first);
+        }
+        this->onMemoryWriteSpan(start, in, count);
+    }
+    
+    // Ponteiro direto para [address, address + count) ou nullptr se o
+    // intervalo cruzar 0xFFF (use readSpan nesse caso)
+    const uint8_t* getPointer(uint16_t address, size_t count) const {
+        size_t start = address & 0xFFF;
+        if(count > MEMORY_SIZE - start) return nullptr;
+        this->onMemoryReadSpan(start, &data[start], count);
+        return &data[start];
     }
     
     bool loadProgram(const uint8_t* program, size_t size) {
@@ -67,6 +125,14 @@ public:
     }
     
     static constexpr uint16_t getProgramStart() { return PROGRAM_START; }
+    static constexpr uint16_t getLastInstruction() { return LAST_INSTRUCTION; }
+    
+    const Observer& getObserver() const { return *this; }
 };
 
+template<typename Observer>
+constexpr uint8_t BasicMemory<Observer>::FONTSET[80];
+
+typedef BasicMemory<> Memory;
+
 #endif // MEMORY_H
\ No newline at end of file
@@ -0,0 +1,97 @@
+// ============================================================================
+// MpscQueue.h - Fila lock-free limitada (vários produtores, um consumidor)
+// ============================================================================
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fila de Vyukov: cada célula carrega um número de sequência que indica se
+// está livre para o produtor da volta atual ou pronta para o consumidor.
+// Produtores disputam apenas um compare_exchange na posição de escrita; o
+// consumidor não usa operações read-modify-write.
+template<typename T>
+class MpscQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::vector<Cell> cells;
+    size_t mask;
+
+    char padEnqueue[64];
+    std::atomic<size_t> enqueuePos;     // Compartilhado entre produtores
+    char padDequeue[64];
+    size_t dequeuePos;                  // Exclusivo do consumidor
+
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 1;
+        while(result < value) result <<= 1;
+        return result;
+    }
+
+public:
+    explicit MpscQueue(size_t capacity)
+        : cells(roundUpPow2(capacity < 2 ? 2 : capacity)),
+          mask(cells.size() - 1), enqueuePos(0), dequeuePos(0) {
+        for(size_t i = 0; i < cells.size(); ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Qualquer thread. Retorna false se a fila estiver cheia.
+    bool tryPush(const T& item) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for(;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if(diff == 0) {
+                if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Apenas o consumidor: olha o próximo item sem removê-lo
+    bool peek(T& item) const {
+        const Cell& cell = cells[dequeuePos & mask];
+        if(cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            return false;
+        }
+        item = cell.value;
+        return true;
+    }
+
+    // Apenas o consumidor
+    bool tryPop(T& item) {
+        Cell& cell = cells[dequeuePos & mask];
+        if(cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            return false;
+        }
+        item = cell.value;
+        cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
+
+    size_t capacity() const { return cells.size(); }
+};
+
+#endif // MPSC_QUEUE_H
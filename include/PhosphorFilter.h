@@ -0,0 +1,71 @@
+// ============================================================================
+// PhosphorFilter.h - Persistência de fósforo e redução de cintilação
+// ============================================================================
+#ifndef PHOSPHOR_FILTER_H
+#define PHOSPHOR_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Display.h"
+
+struct PhosphorOptions {
+    uint8_t decay;          // Intensidade mantida por frame, em 1/256 (0 = nenhuma)
+    bool blend;             // Média do frame atual com o anterior
+    uint8_t threshold;      // Intensidade mínima acesa em getPixels()
+
+    PhosphorOptions() : decay(192), blend(true), threshold(64) {}
+};
+
+// Estágio entre a Display e as saídas. Jogos CHIP-8 apagam e redesenham os
+// sprites com XOR, então um objeto some em frames alternados; aqui cada
+// pixel tem uma intensidade (0..255) que:
+//  - com blend, vai a 128 quando o pixel está aceso só no frame atual ou
+//    só no anterior, e a 255 quando está aceso nos dois;
+//  - decai multiplicando por decay/256 a cada frame, mas nunca fica abaixo
+//    do valor do frame atual.
+//
+// getIntensity() serve a saídas em tons de cinza; getPixels() é a mesma
+// tela em 0/1 (intensidade >= threshold), no formato de
+// Display::getPixels(), para FramePublisher, VideoRecorder e FrameCodec:
+//
+//     filter.process(machine.getDisplay());
+//     publisher.publish(filter.getPixels());
+//
+// O laço por pixel usa SSE2 ou NEON, 16 pixels por instrução, com versão
+// escalar de resultado idêntico nos demais alvos.
+class PhosphorFilter {
+private:
+    size_t width;
+    size_t height;
+    PhosphorOptions options;
+    std::vector<uint8_t> intensity;
+    std::vector<uint8_t> previous;      // Frame anterior, 0/1
+    std::vector<uint8_t> lit;           // 0/1
+
+public:
+    explicit PhosphorFilter(const PhosphorOptions& options = PhosphorOptions(),
+                            size_t width = Display::getWidth(),
+                            size_t height = Display::getHeight());
+
+    // Apaga a persistência (p.ex. ao trocar de ROM)
+    void reset();
+
+    // pixels: width * height bytes 0/1. Retorna getIntensity().
+    const uint8_t* process(const uint8_t* pixels);
+    const uint8_t* process(const Display& display) { return process(display.getPixels()); }
+
+    // Intensidade ampliada por vizinho mais próximo:
+    // (width * scale) x (height * scale) bytes em out
+    void upscale(unsigned scale, uint8_t* out) const;
+
+    void setOptions(const PhosphorOptions& opts) { options = opts; }
+    const PhosphorOptions& getOptions() const { return options; }
+
+    const uint8_t* getIntensity() const { return intensity.data(); }
+    const uint8_t* getPixels() const { return lit.data(); }
+    size_t getWidth() const { return width; }
+    size_t getHeight() const { return height; }
+};
+
+#endif // PHOSPHOR_FILTER_H
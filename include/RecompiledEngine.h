@@ -0,0 +1,278 @@
+// ============================================================================
+// RecompiledEngine.h - Execução de ROMs recompiladas para C++ (AOT)
+// ============================================================================
+#ifndef RECOMPILED_ENGINE_H
+#define RECOMPILED_ENGINE_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Lockstep.h"
+
+class RecompiledContext;
+
+// Cada bloco básico vira uma função que executa no máximo budget (>= 1)
+// instruções a partir de start, atualiza o PC e retorna quantas executou.
+// Com budget para o bloco inteiro, flags em VF que o próprio bloco
+// sobrescreve antes de ler não são calculadas (ver Recompiler).
+typedef uint32_t (*RecompiledBlockFunction)(RecompiledContext& ctx, uint32_t budget);
+
+struct RecompiledBlock {
+    uint16_t start;
+    uint16_t end;       // Exclusivo: bytes [start, end) foram traduzidos
+    RecompiledBlockFunction function;
+};
+
+// Tabela emitida por recompile-rom junto com a ROM original
+struct RecompiledProgram {
+    const char* name;
+    const uint8_t* rom;
+    size_t romSize;
+    const RecompiledBlock* blocks;
+    size_t blockCount;
+};
+
+// Estado da máquina visto pelo código gerado. As instruções que não mudam
+// fluxo nem memória são emitidas inline sobre memory/registers/display;
+// as demais passam pelos helpers abaixo, que replicam InstructionSet.
+class RecompiledContext {
+public:
+    Memory memory;
+    Registers registers;
+    Display display;
+    Input input;
+    InstructionSet instructions;    // Fallback e gerador do CXNN
+
+private:
+    const RecompiledProgram& program;
+    std::vector<uint8_t> codeMap;   // Byte coberto por algum bloco traduzido
+    std::vector<uint8_t> valid;     // Bloco ainda corresponde à memória
+
+    // Grava bytes vindos de FX33/FX55. true se alterou código traduzido,
+    // caso em que os blocos afetados deixam de ser usados.
+    bool store(uint16_t address, const uint8_t* values, size_t count) {
+        bool hitsCode = false;
+        for(size_t i = 0; i < count; ++i) {
+            uint16_t a = (address + i) & 0xFFF;
+            if(codeMap[a] && memory.read(a) != values[i]) {
+                hitsCode = true;
+            }
+        }
+
+        memory.writeSpan(address, values, count);
+        if(!hitsCode) return false;
+
+        for(size_t b = 0; b < program.blockCount; ++b) {
+            const RecompiledBlock& block = program.blocks[b];
+            for(size_t i = 0; i < count; ++i) {
+                uint16_t a = (address + i) & 0xFFF;
+                if(a >= block.start && a < block.end) {
+                    valid[b] = 0;
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit RecompiledContext(const RecompiledProgram& prog)
+        : instructions(memory, registers, display, input),
+          program(prog), codeMap(4096, 0), valid(prog.blockCount, 1) {
+        for(size_t b = 0; b < program.blockCount; ++b) {
+            const RecompiledBlock& block = program.blocks[b];
+            for(uint16_t a = block.start; a < block.end && a < 4096; ++a) {
+                codeMap[a] = 1;
+            }
+        }
+    }
+
+    RecompiledContext(const RecompiledContext&) = delete;
+    RecompiledContext& operator=(const RecompiledContext&) = delete;
+
+    bool isBlockValid(size_t index) const { return valid[index] != 0; }
+    void setBlockValid(size_t index, bool state) { valid[index] = state ? 1 : 0; }
+
+    // Helpers chamados pelo código gerado
+    uint8_t random() { return instructions.randomByte(); }
+
+    void draw(uint8_t x, uint8_t y, uint8_t height) {
+        uint16_t addr = registers.getI();
+        uint8_t buffer[15];
+        const uint8_t* sprite = memory.getPointer(addr, height);
+        if(!sprite) {
+            memory.readSpan(addr, buffer, height);
+            sprite = buffer;
+        }
+        bool collision = display.drawSprite(registers.getV(x), registers.getV(y), sprite, height);
+        registers.setV(0xF, collision ? 1 : 0);
+    }
+
+    // DXYN com VF morto: sem colisão e sem escrever VF
+    void drawWithoutFlag(uint8_t x, uint8_t y, uint8_t height) {
+        uint16_t addr = registers.getI();
+        uint8_t buffer[15];
+        const uint8_t* sprite = memory.getPointer(addr, height);
+        if(!sprite) {
+            memory.readSpan(addr, buffer, height);
+            sprite = buffer;
+        }
+        display.xorSprite(registers.getV(x), registers.getV(y), sprite, height);
+    }
+
+    bool storeBCD(uint8_t x) {
+        uint8_t val = registers.getV(x);
+        uint8_t bcd[3] = {
+            static_cast<uint8_t>(val / 100),
+            static_cast<uint8_t>((val / 10) % 10),
+            static_cast<uint8_t>(val % 10)
+        };
+        return store(registers.getI(), bcd, 3);
+    }
+
+    bool storeRegisters(uint8_t x) {
+        return store(registers.getI(), registers.getVData(), x + 1);
+    }
+
+    void loadRegisters(uint8_t x) {
+        uint16_t addr = registers.getI();
+        const uint8_t* src = memory.getPointer(addr, x + 1);
+        if(src) {
+            registers.loadV(src, x + 1);
+        } else {
+            uint8_t values[16];
+            memory.readSpan(addr, values, x + 1);
+            registers.loadV(values, x + 1);
+        }
+    }
+
+    // Uma instrução pelo interpretador, com a mesma detecção de escrita em
+    // código que os blocos fazem
+    void interpret() {
+        Opcode op(memory.fetchOpcode(registers.getPC()));
+
+        if((op.full & 0xF000) == 0xF000 && (op.nn == 0x33 || op.nn == 0x55)) {
+            if(op.nn == 0x33) {
+                storeBCD(op.x);
+            } else {
+                storeRegisters(op.x);
+            }
+            registers.incrementPC();
+            return;
+        }
+        instructions.execute(op);
+    }
+};
+
+// Motor que despacha para os blocos traduzidos e cai no interpretador
+// quando não há bloco no PC (alvos de BNNN, código fora da ROM), quando o
+// bloco foi sobrescrito ou quando a ROM carregada não é a da tradução.
+class RecompiledEngine : public ExecutionEngine {
+private:
+    const RecompiledProgram& program;
+    RecompiledContext ctx;
+    std::vector<int32_t> blockIndex;    // Endereço -> índice do bloco ou -1
+    uint64_t frameCount;
+    uint64_t compiledInstructions;
+    uint64_t interpretedInstructions;
+
+public:
+    explicit RecompiledEngine(const RecompiledProgram& prog)
+        : program(prog), ctx(prog), blockIndex(4096, -1), frameCount(0),
+          compiledInstructions(0), interpretedInstructions(0) {
+        for(size_t b = 0; b < program.blockCount; ++b) {
+            blockIndex[program.blocks[b].start & 0xFFF] = static_cast<int32_t>(b);
+        }
+    }
+
+    const char* getName() const override { return program.name; }
+
+    // Carrega a ROM embutida na tradução
+    bool start(uint32_t seed) {
+        return start(program.rom, program.romSize, seed);
+    }
+
+    bool start(const uint8_t* rom, size_t size, uint32_t seed) override {
+        ctx.memory.clear();
+        ctx.memory.loadFontset();
+        ctx.registers.reset();
+        ctx.display.clear();
+        ctx.input.clear();
+        ctx.instructions.seedRandom(seed);
+        frameCount = 0;
+        compiledInstructions = 0;
+        interpretedInstructions = 0;
+
+        if(!ctx.memory.loadProgram(rom, size)) return false;
+
+        // Com outra ROM só os blocos cujos bytes coincidem são usados
+        revalidate();
+        return true;
+    }
+
+    void execute(uint32_t count) override {
+        while(count > 0) {
+            uint16_t pc = ctx.registers.getPC();
+            int32_t index = pc < 4096 ? blockIndex[pc] : -1;
+
+            if(index >= 0 && ctx.isBlockValid(index)) {
+                uint32_t done = program.blocks[index].function(ctx, count);
+                compiledInstructions += done;
+                count -= done;
+            } else {
+                ctx.interpret();
+                ++interpretedInstructions;
+                --count;
+            }
+        }
+    }
+
+    void tickTimers() override {
+        ctx.registers.decrementDelayTimer();
+        ctx.registers.decrementSoundTimer();
+        ++frameCount;
+    }
+
+    void setKeyMask(uint16_t mask) override { ctx.input.setKeyMask(mask); }
+
+    void saveSnapshot(Chip8Snapshot& snapshot) const override {
+        snapshot.memory = ctx.memory;
+        snapshot.registers = ctx.registers;
+        snapshot.display = ctx.display;
+        snapshot.keyMask = ctx.input.getKeyMask();
+        snapshot.frameCount = frameCount;
+        snapshot.random = ctx.instructions.getRandomState();
+    }
+
+    void restoreSnapshot(const Chip8Snapshot& snapshot) override {
+        ctx.memory = snapshot.memory;
+        ctx.registers = snapshot.registers;
+        ctx.display = snapshot.display;
+        ctx.input.clear();
+        ctx.input.setKeyMask(snapshot.keyMask);
+        frameCount = snapshot.frameCount;
+        ctx.instructions.setRandomState(snapshot.random);
+        revalidate();
+    }
+
+    const Display& getDisplay() const { return ctx.display; }
+    const Registers& getRegisters() const { return ctx.registers; }
+    Input& getInput() { return ctx.input; }
+    uint64_t getCompiledInstructions() const { return compiledInstructions; }
+    uint64_t getInterpretedInstructions() const { return interpretedInstructions; }
+
+private:
+    // Um bloco só é usado enquanto os bytes em memória forem os traduzidos
+    void revalidate() {
+        for(size_t b = 0; b < program.blockCount; ++b) {
+            const RecompiledBlock& block = program.blocks[b];
+            const uint8_t* current = ctx.memory.getPointer(block.start, block.end - block.start);
+            bool same = current && std::memcmp(current, &program.rom[block.start - 0x200],
+                                               block.end - block.start) == 0;
+            ctx.setBlockValid(b, same);
+        }
+    }
+};
+
+#endif // RECOMPILED_ENGINE_H
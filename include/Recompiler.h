@@ -0,0 +1,70 @@
+// ============================================================================
+// Recompiler.h - Tradução estática de ROMs CHIP-8 para C++
+// ============================================================================
+#ifndef RECOMPILER_H
+#define RECOMPILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Bloco básico encontrado pela análise: sequência linear de instruções que
+// termina num desvio (1NNN, 2NNN, 00EE, BNNN), num skip, em FX0A ou no
+// limite de tamanho. Blocos podem se sobrepor quando há saltos para o meio
+// de uma sequência já traduzida.
+struct RecompilerBlock {
+    uint16_t start;
+    uint16_t end;                       // Exclusivo
+    std::vector<uint16_t> successors;   // Alvos estáticos dentro da ROM
+    std::vector<uint16_t> deadFlags;    // Instruções cujo flag em VF o bloco sobrescreve antes de ler
+};
+
+// Análise por travessia a partir de 0x200 seguindo saltos, chamadas,
+// retornos de chamada e os dois lados de cada skip. Alvos de BNNN não são
+// conhecidos estaticamente: ficam com o interpretador até o PC cair de novo
+// no início de um bloco traduzido, a menos que um perfil de execução
+// (RomProfile::translationRoots) os passe como raízes extras.
+class Recompiler {
+public:
+    static constexpr uint16_t PROGRAM_START = 0x200;
+    static constexpr size_t MAX_BLOCK_INSTRUCTIONS = 64;
+
+private:
+    std::vector<uint8_t> rom;
+    std::vector<RecompilerBlock> blocks;
+    size_t indirectJumps;
+
+    bool inRom(uint16_t address) const {
+        return address >= PROGRAM_START && address + 2u <= PROGRAM_START + rom.size();
+    }
+    uint16_t fetch(uint16_t address) const {
+        size_t offset = address - PROGRAM_START;
+        return static_cast<uint16_t>((rom[offset] << 8) | rom[offset + 1]);
+    }
+
+    // Liveness de VF de trás para frente no bloco; VF é vivo na saída
+    void findDeadFlags(RecompilerBlock& block) const;
+
+    void emitInstruction(std::ostream& out, uint16_t address, uint16_t opcode,
+                         uint32_t executed, bool last, bool checkBudget, bool flagDead) const;
+
+public:
+    Recompiler() : indirectJumps(0) {}
+
+    // false se a ROM for vazia ou maior que a memória
+    bool analyze(const uint8_t* data, size_t size);
+
+    // Também traduz a partir de roots; endereços fora da ROM são ignorados
+    bool analyze(const uint8_t* data, size_t size, const std::vector<uint16_t>& roots);
+
+    // Emite a unidade de tradução: ROM embutida, uma função por bloco e
+    // `extern const RecompiledProgram <symbol>`
+    void emit(std::ostream& out, const std::string& symbol, const std::string& source) const;
+
+    const std::vector<RecompilerBlock>& getBlocks() const { return blocks; }
+    size_t getIndirectJumpCount() const { return indirectJumps; }
+    size_t getDeadFlagCount() const;
+};
+
+#endif // RECOMPILER_H
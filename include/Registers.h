@@ -7,7 +7,12 @@
 #include <cstdint>
 #include <cstring>
 
-class Registers {
+#include "BusObserver.h"
+#include "Trap.h"
+
+// Observer: política de observação (ver BusObserver.h)
+template<typename Observer = DefaultObserver>
+class BasicRegisters : private Observer {
 private:
     uint8_t V[16];          // Registradores V0-VF
     uint16_t I;             // Registrador de índice
@@ -16,9 +21,10 @@ private:
     uint16_t stack[16];     // Stack
     uint8_t delayTimer;
     uint8_t soundTimer;
+    Trap trap;              // Primeira falha desde o último reset
 
 public:
-    Registers() {
+    BasicRegisters() {
         reset();
     }
     
@@ -30,39 +36,119 @@ public:
         SP = 0;
         delayTimer = 0;
         soundTimer = 0;
+        trap = Trap::None;
     }
     
     // Registradores V
     uint8_t getV(uint8_t index) const { return V[index & 0xF]; }
-    void setV(uint8_t index, uint8_t value) { V[index & 0xF] = value; }
+    void setV(uint8_t index, uint8_t value) {
+        V[index & 0xF] = value;
+        this->onRegisterWrite(TRACE_REGISTER_V, index & 0xF, value);
+    }
+    
+    // V0..V(count-1) em bloco (FX55/FX65)
+    const uint8_t* getVData() const { return V; }
+    void loadV(const uint8_t* values, size_t count) {
+        if(count > 16) count = 16;
+        std::memcpy(V, values, count);
+        for(size_t i = 0; i < count; ++i) {
+            this->onRegisterWrite(TRACE_REGISTER_V, static_cast<uint8_t>(i), V[i]);
+        }
+    }
     
     // Registrador I
     uint16_t getI() const { return I; }
-    void setI(uint16_t value) { I = value; }
-    void addI(uint16_t value) { I += value; }
+    void setI(uint16_t value) {
+        I = value;
+        this->onRegisterWrite(TRACE_REGISTER_I, 0, I);
+    }
+    void addI(uint16_t value) {
+        I += value;
+        this->onRegisterWrite(TRACE_REGISTER_I, 0, I);
+    }
     
     // Program Counter
     uint16_t getPC() const { return PC; }
-    void setPC(uint16_t value) { PC = value; }
-    void incrementPC() { PC += 2; }
-    void skipInstruction() { PC += 4; }
+    void setPC(uint16_t value) {
+        PC = value;
+        this->onRegisterWrite(TRACE_REGISTER_PC, 0, PC);
+    }
+    void incrementPC() {
+        PC += 2;
+        this->onRegisterWrite(TRACE_REGISTER_PC, 0, PC);
+    }
+    void skipInstruction() {
+        PC += 4;
+        this->onRegisterWrite(TRACE_REGISTER_PC, 0, PC);
+    }
     
     // Stack
-    void pushStack(uint16_t value) { 
+    // Fora dos limites a pilha não é tocada: a operação retorna false e
+    // registra o trap (popStack() sem destino devolve 0)
+    bool pushStack(uint16_t value) { 
+        if(SP >= 16) {
+            raiseTrap(Trap::StackOverflow);
+            return false;
+        }
         stack[SP++] = value; 
+        this->onRegisterWrite(TRACE_REGISTER_SP, 0, SP, value);
+        return true;
+    }
+    bool popStack(uint16_t& value) { 
+        if(SP == 0) {
+            raiseTrap(Trap::StackUnderflow);
+            return false;
+        }
+        value = stack[--SP];
+        this->onRegisterWrite(TRACE_REGISTER_SP, 0, SP, value);
+        return true;
     }
-    uint16_t popStack() { 
-        return stack[--SP]; 
+    uint16_t popStack() {
+        uint16_t value = 0;
+        popStack(value);
+        return value;
+    }
+    uint8_t getSP() const { return SP; }
+    uint16_t getStackEntry(uint8_t level) const { return stack[level & 0xF]; }
+    
+    // Traps (ver Trap.h)
+    void raiseTrap(Trap cause) {
+        if(trap == Trap::None) trap = cause;
+    }
+    Trap getTrap() const { return trap; }
+    bool isTrapped() const { return trap != Trap::None; }
+    bool hasStackFault() const {
+        return trap == Trap::StackOverflow || trap == Trap::StackUnderflow;
     }
     
     // Timers
     uint8_t getDelayTimer() const { return delayTimer; }
-    void setDelayTimer(uint8_t value) { delayTimer = value; }
-    void decrementDelayTimer() { if(delayTimer > 0) --delayTimer; }
+    void setDelayTimer(uint8_t value) {
+        delayTimer = value;
+        this->onRegisterWrite(TRACE_DELAY_TIMER, 0, delayTimer);
+    }
+    void decrementDelayTimer() {
+        if(delayTimer > 0) {
+            --delayTimer;
+            this->onRegisterWrite(TRACE_DELAY_TIMER, 0, delayTimer);
+        }
+    }
     
     uint8_t getSoundTimer() const { return soundTimer; }
-    void setSoundTimer(uint8_t value) { soundTimer = value; }
-    void decrementSoundTimer() { if(soundTimer > 0) --soundTimer; }
+    void setSoundTimer(uint8_t value) {
+        soundTimer = value;
+        this->onRegisterWrite(TRACE_SOUND_TIMER, 0, soundTimer);
+    }
+    void decrementSoundTimer() {
+        if(soundTimer > 0) {
+            --soundTimer;
+            this->onRegisterWrite(TRACE_SOUND_TIMER, 0, soundTimer);
+        }
+    }
+    
+    const Observer& getObserver() const { return *this; }
 };
 
+typedef BasicRegisters<> Registers;
+
 #endif // REGISTERS_H
@@ -0,0 +1,102 @@
+// ============================================================================
+// RomProfile.h - Perfil de execução por ROM para aquecer a recompilação
+// ============================================================================
+#ifndef ROM_PROFILE_H
+#define ROM_PROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Fnv1a.h"
+
+// Entradas de bloco (destinos de saltos, chamadas, retornos e skips) e
+// alvos de BNNN vistos em execução, com contagens. O perfil pertence a uma
+// ROM pelo hash do conteúdo: outro build da ROM não herda o perfil.
+class RomProfile {
+public:
+    static constexpr size_t ADDRESS_SPACE = 4096;
+
+private:
+    uint64_t romHash;
+    std::vector<uint32_t> entries;      // Endereço -> vezes em que um desvio chegou nele
+    std::vector<uint32_t> indirect;     // Endereço -> vezes em que um BNNN chegou nele
+
+public:
+    RomProfile() : romHash(0), entries(ADDRESS_SPACE, 0), indirect(ADDRESS_SPACE, 0) {}
+
+    // FNV-1a de 64 bits do conteúdo da ROM
+    static uint64_t hashRom(const uint8_t* data, size_t size) {
+        return fnv1a(data, size);
+    }
+
+    // <directory>/<hash em hex>.profile
+    static std::string pathFor(const std::string& directory, uint64_t hash);
+
+    // Perfil vazio para a ROM com esse hash
+    void reset(uint64_t hash) {
+        romHash = hash;
+        entries.assign(ADDRESS_SPACE, 0);
+        indirect.assign(ADDRESS_SPACE, 0);
+    }
+
+    void addEntry(uint16_t address, uint32_t count = 1) {
+        uint32_t& slot = entries[address & 0xFFF];
+        slot = count > UINT32_MAX - slot ? UINT32_MAX : slot + count;
+    }
+
+    void addIndirectTarget(uint16_t address, uint32_t count = 1) {
+        uint32_t& slot = indirect[address & 0xFFF];
+        slot = count > UINT32_MAX - slot ? UINT32_MAX : slot + count;
+    }
+
+    uint64_t getRomHash() const { return romHash; }
+    uint32_t getEntryCount(uint16_t address) const { return entries[address & 0xFFF]; }
+    uint32_t getIndirectCount(uint16_t address) const { return indirect[address & 0xFFF]; }
+    bool empty() const;
+
+    // Endereços a traduzir além dos achados pela análise estática: alvos de
+    // BNNN primeiro, depois entradas da mais quente para a mais fria
+    std::vector<uint16_t> translationRoots() const;
+
+    // Arquivo texto. load() soma as contagens do arquivo às do perfil (um
+    // perfil de outra ROM é descartado antes) e falha se o arquivo não
+    // existe, é inválido ou é de outra ROM.
+    bool load(const std::string& path, uint64_t expectedHash);
+    bool save(const std::string& path) const;
+};
+
+// Alimenta um RomProfile a partir de uma máquina em execução (Chip8 ou
+// qualquer tipo com getRegisters() e getMemory()). Chame step() depois de
+// cada instrução, p.ex. como hook de Chip8::runFrame:
+//
+//     machine.runFrame(cycles, [&]() { recorder.step(); });
+template<typename Machine>
+class ProfileRecorder {
+private:
+    RomProfile& profile;
+    const Machine& machine;
+    uint16_t lastPc;
+
+public:
+    ProfileRecorder(RomProfile& prof, const Machine& target)
+        : profile(prof), machine(target), lastPc(target.getRegisters().getPC()) {
+        profile.addEntry(lastPc);
+    }
+
+    void step() {
+        uint16_t pc = machine.getRegisters().getPC();
+
+        // Sequencial, FX0A esperando tecla ou trap: não é entrada de bloco
+        if(pc != static_cast<uint16_t>(lastPc + 2) && pc != lastPc) {
+            profile.addEntry(pc);
+            if((machine.getMemory().fetchOpcode(lastPc) & 0xF000) == 0xB000) {
+                profile.addIndirectTarget(pc);
+            }
+        }
+        lastPc = pc;
+    }
+};
+
+#endif // ROM_PROFILE_H
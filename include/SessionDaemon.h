@@ -0,0 +1,159 @@
+// ============================================================================
+// SessionDaemon.h - Muitas sessões Chip8 num processo, servidas por socket Unix
+// ============================================================================
+#ifndef SESSION_DAEMON_H
+#define SESSION_DAEMON_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Chip8.h"
+#include "DaemonProtocol.h"
+
+// Configuração do daemon
+struct DaemonOptions {
+    size_t workerThreads;       // 0 = um por núcleo
+    double speed;               // Múltiplo de 60 frames por segundo
+    size_t maxSessions;
+    size_t maxPendingOutput;    // Bytes por cliente antes de descartar frames
+    uint32_t maxCyclesPerFrame; // Create com 0 ou acima disso recebe Error
+
+    DaemonOptions() : workerThreads(0), speed(1.0), maxSessions(1024),
+                      maxPendingOutput(1 << 20), maxCyclesPerFrame(1000) {}
+};
+
+// Uma thread de I/O (epoll) aceita clientes, lê mensagens e escreve frames;
+// um pool de workers emula. A cada tick de 60 Hz as sessões são divididas
+// em lotes que os workers pegam por contador atômico; o último a terminar
+// acorda o event loop por um eventfd. Só então os frames que mudaram são
+// enfileirados por cliente, num único write por cliente e tick.
+//
+// Sessões só são criadas, destruídas ou recebem teclas entre ticks: as
+// mensagens lidas durante um tick ficam no buffer do cliente até ele
+// acabar, então os workers nunca disputam a tabela de sessões.
+//
+// Uma sessão que para num trap (ROM com bug) não afeta as outras: o dono
+// recebe uma mensagem Trap, uma vez, e a sessão fica parada até Destroy.
+//
+// Sessões ociosas (FX0A sem tecla, laço esperando o delay timer, trap)
+// saem do tick: o worker vê a espera no fim do frame (Chip8::idleWait()) e
+// a sessão fica estacionada, sem CPU, até uma tecla chegar ou até o frame
+// de 60 Hz em que o timer a libera. Ao acordar os frames perdidos são
+// pulados de uma vez (Chip8::skipIdleFrames()), com o mesmo estado que
+// emulá-los daria. Os ticks vêm de um timerfd armado só quando há sessão
+// rodando ou um despertar agendado: com tudo ocioso o daemon dorme.
+//
+// Frames vão como deltas de FrameCodec, codificados só quando enviados:
+// um cliente lento perde frames (contados em getFramesDropped()) em vez de
+// acumular memória no daemon, e o próximo delta cobre os descartados.
+class SessionDaemon {
+public:
+    explicit SessionDaemon(const DaemonOptions& options = DaemonOptions());
+    ~SessionDaemon();
+
+    SessionDaemon(const SessionDaemon&) = delete;
+    SessionDaemon& operator=(const SessionDaemon&) = delete;
+
+    // Cria o socket em path (removendo um socket antigo)
+    bool listen(const std::string& path);
+
+    // A thread chamadora vira o event loop até stop()
+    void run();
+
+    // Qualquer thread ou handler de sinal
+    void stop();
+
+    size_t getSessionCount() const { return sessionCount.load(); }
+    size_t getParkedCount() const { return parkedCount.load(); }
+    uint64_t getFramesSkipped() const { return framesSkipped.load(); }
+    uint64_t getFramesSent() const { return framesSent.load(); }
+    uint64_t getFramesDropped() const { return framesDropped.load(); }
+
+private:
+    struct Session {
+        uint32_t id;
+        uint64_t owner;             // Id da conexão
+        Chip8 machine;
+        RunOptions options;
+        bool redraw;                // Escrito pelo worker, lido entre ticks
+        bool trapReported;          // Mensagem Trap já enviada
+        uint8_t packed[FrameCodec::PACKED_SIZE];
+        FrameEncoder encoder;       // Só a thread de I/O
+        uint64_t nextFrame;         // Frame do daemon que a sessão roda a seguir
+        IdleWait wait;              // Vista pelo worker; != None = estacionada
+        uint32_t idleFrames;        // Frames que podem ser pulados (idleWait())
+        uint64_t wakeFrame;         // Despertar agendado (Timer)
+    };
+
+    struct Connection {
+        uint64_t id;
+        int fd;
+        bool closed;
+        bool wantWrite;
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output;
+        size_t outputOffset;
+    };
+
+    static constexpr size_t BATCH_SESSIONS = 16;
+
+    DaemonOptions options;
+    std::string socketPath;
+    int listenFd;
+    int epollFd;
+    int wakeFd;                     // eventfd: fim de tick e stop()
+    int timerFd;                    // timerfd: próximo tick
+    std::atomic<bool> stopRequested;
+
+    std::map<uint64_t, std::unique_ptr<Connection>> connections;
+    std::map<uint32_t, std::unique_ptr<Session>> sessions;
+    std::vector<Session*> active;   // Visto pelos workers durante o tick
+    std::multimap<uint64_t, Session*> timedWakes;   // wakeFrame -> sessão
+    uint64_t frameClock;            // Frames do daemon já agendados
+    uint64_t nextConnectionId;
+    uint32_t nextSessionId;
+    std::atomic<size_t> sessionCount;
+    std::atomic<uint64_t> framesSent;
+    std::atomic<uint64_t> framesDropped;
+    std::atomic<size_t> parkedCount;
+    std::atomic<uint64_t> framesSkipped;
+
+    std::vector<std::thread> workers;
+    std::mutex tickMutex;
+    std::condition_variable tickStart;
+    uint64_t tickGeneration;        // Protegido por tickMutex
+    uint64_t tickEnd;               // Frame do daemon em que o tick termina
+    bool workersStopping;
+    std::atomic<size_t> nextBatch;
+    std::atomic<size_t> workersDone;
+    bool tickInFlight;              // Só a thread de I/O
+
+    void workerLoop();
+    void startTick(uint64_t end);
+    void finishTick();
+    void armTimer(const FramePacer& pacer);
+    void park(Session& session);
+    void wake(Session& session, uint64_t frame);
+    void wakeTimers(uint64_t end);
+    void forget(Session& session);
+
+    void acceptClients();
+    void readClient(Connection& connection);
+    void flushClient(Connection& connection);
+    void closeClient(Connection& connection);
+    void updateInterest(Connection& connection);
+    void processMessages(Connection& connection);
+    bool handleMessage(Connection& connection, const DaemonMessageView& message);
+    void reapClosed();
+    void rebuildActive();
+    void shutdown();
+};
+
+#endif // SESSION_DAEMON_H
@@ -0,0 +1,85 @@
+// ============================================================================
+// SpscRing.h - Fila circular lock-free (um produtor, um consumidor)
+// ============================================================================
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Buffer circular sem locks para exatamente uma thread produtora e uma
+// consumidora. A capacidade é arredondada para potência de 2, então os
+// índices crescem livremente e são mascarados apenas no acesso.
+template<typename T>
+class SpscRing {
+private:
+    std::vector<T> buffer;
+    size_t mask;
+
+    // Separados em linhas de cache distintas para evitar false sharing
+    char padHead[64];
+    std::atomic<size_t> head;   // Escrito só pelo produtor
+    char padTail[64];
+    std::atomic<size_t> tail;   // Escrito só pelo consumidor
+
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 1;
+        while(result < value) result <<= 1;
+        return result;
+    }
+
+public:
+    explicit SpscRing(size_t capacity)
+        : buffer(roundUpPow2(capacity < 2 ? 2 : capacity)),
+          mask(buffer.size() - 1), head(0), tail(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Produtor: copia até count itens; retorna quantos couberam (nunca bloqueia)
+    size_t push(const T* items, size_t count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t t = tail.load(std::memory_order_acquire);
+        size_t space = buffer.size() - (h - t);
+        if(count > space) count = space;
+
+        for(size_t i = 0; i < count; ++i) {
+            buffer[(h + i) & mask] = items[i];
+        }
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+    bool tryPush(const T& item) {
+        return push(&item, 1) == 1;
+    }
+
+    // Consumidor: copia até count itens; retorna quantos estavam disponíveis
+    size_t pop(T* items, size_t count) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+        size_t available = h - t;
+        if(count > available) count = available;
+
+        for(size_t i = 0; i < count; ++i) {
+            items[i] = buffer[(t + i) & mask];
+        }
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+    bool tryPop(T& item) {
+        return pop(&item, 1) == 1;
+    }
+
+    // Aproximado quando chamado fora das threads produtora/consumidora
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return buffer.size(); }
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,74 @@
+// ============================================================================
+// TerminalRenderer.h - Tela no terminal com saída incremental
+// ============================================================================
+#ifndef TERMINAL_RENDERER_H
+#define TERMINAL_RENDERER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Display.h"
+
+enum class TerminalGlyphs {
+    HalfBlock,      // ▀ ▄ █: 1x2 pixels por célula (64x32 -> 64x16)
+    Braille         // ⠿: 2x4 pixels por célula (64x32 -> 32x8)
+};
+
+// Desenha o framebuffer com caracteres Unicode (UTF-8) e sequências ANSI.
+// O primeiro render() desenha o retângulo inteiro; os seguintes emitem só
+// as células que mudaram, cada uma precedida de um posicionamento do cursor.
+// Entre duas células alteradas na mesma linha, as de permeio são reescritas
+// quando isso gasta menos bytes que o posicionamento. Um frame sem mudanças
+// não gera nenhum byte.
+//
+// O renderer só escreve no seu retângulo (a partir de originRow,
+// originColumn, contados de 1), então vários podem dividir a tela, um por
+// sessão. Limpar a tela e esconder o cursor ficam com quem chama:
+//
+//     std::string out = TerminalRenderer::beginScreen();
+//     renderer.render(machine.getDisplay(), out);
+//     std::fwrite(out.data(), 1, out.size(), stdout);
+class TerminalRenderer {
+private:
+    TerminalGlyphs glyphs;
+    unsigned originRow;
+    unsigned originColumn;
+    size_t width;
+    size_t height;
+    size_t columns;
+    size_t rows;
+    std::vector<uint8_t> cells;         // Bits de pixel por célula
+    std::vector<uint8_t> shown;         // O que o terminal mostra
+    bool drawn;
+
+    void buildCells(const uint8_t* pixels);
+    void appendGlyph(uint8_t cell, std::string& out) const;
+    size_t glyphSize(uint8_t cell) const { return cell ? 3 : 1; }
+    void appendMove(size_t row, size_t column, std::string& out) const;
+
+public:
+    explicit TerminalRenderer(TerminalGlyphs glyphs = TerminalGlyphs::HalfBlock,
+                              unsigned originRow = 1, unsigned originColumn = 1,
+                              size_t width = Display::getWidth(),
+                              size_t height = Display::getHeight());
+
+    // Acrescenta a out os bytes para o terminal mostrar pixels (0/1);
+    // retorna quantos
+    size_t render(const uint8_t* pixels, std::string& out);
+    size_t render(const Display& display, std::string& out) {
+        return render(display.getPixels(), out);
+    }
+
+    // O próximo render() redesenha tudo (p.ex. depois de limpar a tela)
+    void invalidate() { drawn = false; }
+
+    size_t getColumns() const { return columns; }
+    size_t getRows() const { return rows; }
+
+    // Limpa a tela e esconde o cursor / mostra o cursor abaixo da linha row
+    static std::string beginScreen() { return "\x1b[2J\x1b[?25l"; }
+    static std::string endScreen(unsigned row);
+};
+
+#endif // TERMINAL_RENDERER_H
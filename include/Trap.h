@@ -0,0 +1,32 @@
+// ============================================================================
+// Trap.h - Falhas que interrompem a execução de uma instância
+// ============================================================================
+#ifndef TRAP_H
+#define TRAP_H
+
+#include <cstdint>
+
+// Registrada em Registers pela operação que falhou; só a primeira conta.
+// A instrução que gera o trap não altera o estado e deixa o PC nela
+// mesma, então executá-la de novo é inofensivo: a máquina fica parada
+// até reset() e o host só precisa consultar o trap entre frames.
+enum class Trap : uint8_t {
+    None = 0,
+    StackOverflow,      // 2NNN com 16 níveis ocupados
+    StackUnderflow,     // 00EE com a pilha vazia
+    InvalidOpcode,      // Opcode sem instrução definida
+    PcOutOfRange        // Instrução buscada além de 0xFFE
+};
+
+inline const char* trapName(Trap trap) {
+    switch(trap) {
+        case Trap::None: return "nenhum";
+        case Trap::StackOverflow: return "overflow da pilha";
+        case Trap::StackUnderflow: return "underflow da pilha";
+        case Trap::InvalidOpcode: return "opcode inválido";
+        case Trap::PcOutOfRange: return "PC fora da memória";
+    }
+    return "desconhecido";
+}
+
+#endif // TRAP_H
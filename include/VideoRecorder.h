@@ -0,0 +1,86 @@
+// ============================================================================
+// VideoRecorder.h - Exportação de vídeo headless do framebuffer
+// ============================================================================
+#ifndef VIDEO_RECORDER_H
+#define VIDEO_RECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Display.h"
+#include "FrameCodec.h"
+#include "SpscRing.h"
+
+enum class VideoFormat {
+    Y4M,            // YUV4MPEG2 4:2:0, lido por ffmpeg/mpv
+    PngSequence,    // prefixo_000000.png, prefixo_000001.png, ...
+    DeltaStream     // Formato intermediário compacto (.c8v)
+};
+
+class VideoSink;
+
+// Grava frames em disco numa thread de fundo. O chamador (thread de
+// emulação ou um leitor do FramePublisher) só empacota o frame em 1 bit por
+// pixel, faz XOR com o último frame enfileirado e comprime as séries de
+// zeros; um frame sem mudanças ocupa 2 bytes na fila. Se a fila estiver
+// cheia o frame é descartado e o próximo delta é feito contra o último
+// frame aceito, então a saída continua consistente.
+class VideoRecorder {
+public:
+    static constexpr size_t PACKED_SIZE = FrameCodec::PACKED_SIZE;
+
+    // Formato .c8v: "C8V1", largura e altura (u16 LE), e para cada frame um
+    // u16 LE com o tamanho seguido do delta RLE contra o frame anterior
+    // (o primeiro é contra um frame apagado).
+    static void packPixels(const uint8_t* pixels, uint8_t* packed);
+    static void unpackPixels(const uint8_t* packed, uint8_t* pixels);
+    static void encodeDelta(const uint8_t* previous, const uint8_t* current,
+                            std::vector<uint8_t>& out);
+    // Aplica (XOR) um delta sobre packed; false se o delta estiver corrompido
+    static bool applyDelta(const uint8_t* data, size_t size, uint8_t* packed);
+
+    // Reconverte um .c8v gravado para Y4M ou PNG
+    static bool convertDeltaStream(const char* input, const char* output,
+                                   VideoFormat format, unsigned scale = 4);
+
+    explicit VideoRecorder(size_t queueFrames = 64);
+    ~VideoRecorder();
+
+    VideoRecorder(const VideoRecorder&) = delete;
+    VideoRecorder& operator=(const VideoRecorder&) = delete;
+
+    bool open(const char* path, VideoFormat format, unsigned scale = 4);
+    void close();
+
+    // Thread produtora: nunca bloqueia
+    bool submit(const uint8_t* pixels);
+    bool submit(const Display& display) { return submit(display.getPixels()); }
+
+    bool isOpen() const { return running.load(); }
+    uint64_t getFramesWritten() const { return framesWritten.load(); }
+    uint64_t getDroppedFrames() const { return droppedFrames; }
+
+private:
+    SpscRing<std::vector<uint8_t>> queue;
+    uint8_t lastQueued[PACKED_SIZE];    // Referência do produtor
+    std::vector<uint8_t> encodeBuffer;
+    uint64_t droppedFrames;
+
+    std::unique_ptr<VideoSink> sink;
+    std::thread worker;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> framesWritten;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+
+    void workerLoop();
+};
+
+#endif // VIDEO_RECORDER_H
@@ -0,0 +1,121 @@
+// ============================================================================
+// VipTiming.h - Custo das instruções em ciclos de máquina do COSMAC VIP
+// ============================================================================
+#ifndef VIP_TIMING_H
+#define VIP_TIMING_H
+
+#include <cstdint>
+#include <vector>
+
+// Modelo de tempo do interpretador CHIP-8 original do COSMAC VIP. Um ciclo
+// de máquina do 1802 são 8 pulsos de 1,76 MHz; o vídeo interrompe a CPU a
+// cada 60 Hz e o DMA do display rouba parte de cada frame.
+//
+// Os custos são aproximados a partir da análise publicada do interpretador
+// do VIP e ficam todos em baseCost(), para ajuste num só lugar. A tabela é
+// indexada pelo opcode inteiro e montada uma vez por processo: o custo fixo
+// sai de uma consulta no decode e a contabilidade é uma soma por instrução.
+// Só skips, DXYN e FX33 passam por resolve() depois de executar.
+class VipTiming {
+public:
+    static constexpr uint32_t CYCLES_PER_FRAME = 3668;     // 1,76064 MHz / 8 / 60
+    static constexpr uint32_t DISPLAY_DMA_CYCLES = 1024;   // 128 linhas x 8 bytes
+    static constexpr uint32_t INTERRUPT_CYCLES = 96;       // Rotina de interrupção
+    static constexpr uint32_t CYCLES_AVAILABLE = CYCLES_PER_FRAME - DISPLAY_DMA_CYCLES - INTERRUPT_CYCLES;
+
+    static constexpr uint32_t FETCH_CYCLES = 40;           // Fetch/decode do interpretador
+    static constexpr uint32_t SKIP_TAKEN_CYCLES = 4;
+
+    // Bits de controle nas entradas da tabela e no retorno de CPU::step()
+    static constexpr uint32_t DYNAMIC = 0x8000;            // Custo depende da execução
+    static constexpr uint32_t WAIT_VBLANK = 0x4000;        // Espera a próxima interrupção
+    static constexpr uint32_t COST_MASK = 0x3FFF;
+
+private:
+    const uint16_t* table;
+
+    static uint32_t baseCost(uint16_t op) {
+        uint8_t x = (op >> 8) & 0xF;
+        uint8_t nn = op & 0xFF;
+
+        switch(op & 0xF000) {
+            case 0x0000:
+                if(op == 0x00E0) return 3078;           // Limpa 256 bytes em loop
+                if(op == 0x00EE) return 10;
+                return 0;                               // 0NNN: não emulado
+            case 0x1000: return 12;
+            case 0x2000: return 26;
+            case 0x3000:
+            case 0x4000: return 10 | DYNAMIC;
+            case 0x5000:
+            case 0x9000: return 14 | DYNAMIC;
+            case 0x6000: return 6;
+            case 0x7000: return 10;
+            case 0x8000: return 44;
+            case 0xA000: return 12;
+            case 0xB000: return 22;
+            case 0xC000: return 36;
+            case 0xD000: return 26 | DYNAMIC | WAIT_VBLANK;
+            case 0xE000:
+                if(nn == 0x9E || nn == 0xA1) return 14 | DYNAMIC;
+                return 0;
+            case 0xF000:
+                switch(nn) {
+                    case 0x07: return 10;
+                    case 0x0A: return 10;               // Por consulta ao teclado
+                    case 0x15: return 10;
+                    case 0x18: return 10;
+                    case 0x1E: return 16;
+                    case 0x29: return 16;
+                    case 0x33: return 80 | DYNAMIC;
+                    case 0x55:
+                    case 0x65: return 14 + 14 * (x + 1);
+                }
+                return 0;
+        }
+        return 0;
+    }
+
+    static const uint16_t* buildTable() {
+        static std::vector<uint16_t> entries;
+        entries.resize(0x10000);
+        for(uint32_t op = 0; op < 0x10000; ++op) {
+            uint32_t cost = baseCost(static_cast<uint16_t>(op));
+            entries[op] = static_cast<uint16_t>((cost & ~COST_MASK) | ((cost & COST_MASK) + FETCH_CYCLES));
+        }
+        return entries.data();
+    }
+
+    static const uint16_t* sharedTable() {
+        static const uint16_t* shared = buildTable();   // Inicialização thread-safe
+        return shared;
+    }
+
+public:
+    VipTiming() : table(sharedTable()) {}
+
+    // Entrada da tabela: custo fixo, com DYNAMIC/WAIT_VBLANK quando houver
+    uint32_t lookup(uint16_t opcode) const { return table[opcode]; }
+
+    // Custo final de uma entrada DYNAMIC. vx é o valor de VX antes de
+    // executar; skipped indica que o PC avançou 4.
+    static uint32_t resolve(uint16_t opcode, uint32_t entry, uint8_t vx, bool skipped) {
+        uint32_t cost = entry & COST_MASK;
+
+        switch(opcode & 0xF000) {
+            case 0xD000: {
+                // Sprites fora do alinhamento de byte são deslocados bit a
+                // bit e escritos em dois bytes por linha
+                uint32_t rows = opcode & 0xF;
+                cost += rows * ((vx & 7) ? 34 : 16);
+                return cost | WAIT_VBLANK;
+            }
+            case 0xF000:                                // FX33: divisões por subtração
+                return cost + 16 * (vx / 100 + (vx / 10) % 10 + vx % 10);
+            default:                                    // Skips
+                return skipped ? cost + SKIP_TAKEN_CYCLES : cost;
+        }
+    }
+};
+
+#endif // VIP_TIMING_H
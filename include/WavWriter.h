@@ -0,0 +1,102 @@
+// ============================================================================
+// WavWriter.h - Saída de áudio headless em arquivo WAV
+// ============================================================================
+#ifndef WAV_WRITER_H
+#define WAV_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+#include "SpscRing.h"
+
+// Grava PCM 16-bit mono em WAV. O cabeçalho é escrito com tamanho zero e
+// corrigido em close(), então o arquivo pode ser gravado em streaming.
+class WavWriter {
+private:
+    static constexpr size_t HEADER_SIZE = 44;
+    static constexpr size_t DRAIN_CHUNK = 1024;
+
+    std::ofstream file;
+    uint32_t sampleRate;
+    uint32_t samplesWritten;
+
+    void write16(uint16_t value) {
+        char bytes[2] = { static_cast<char>(value & 0xFF),
+                          static_cast<char>(value >> 8) };
+        file.write(bytes, 2);
+    }
+
+    void write32(uint32_t value) {
+        write16(value & 0xFFFF);
+        write16(value >> 16);
+    }
+
+    void writeHeader(uint32_t dataBytes) {
+        file.write("RIFF", 4);
+        write32(36 + dataBytes);
+        file.write("WAVE", 4);
+        file.write("fmt ", 4);
+        write32(16);                // Tamanho do bloco fmt
+        write16(1);                 // PCM
+        write16(1);                 // Mono
+        write32(sampleRate);
+        write32(sampleRate * 2);    // Byte rate
+        write16(2);                 // Block align
+        write16(16);                // Bits por amostra
+        file.write("data", 4);
+        write32(dataBytes);
+    }
+
+public:
+    WavWriter() : sampleRate(0), samplesWritten(0) {}
+    ~WavWriter() { close(); }
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    bool open(const char* filename, uint32_t rate) {
+        close();
+        file.open(filename, std::ios::binary | std::ios::trunc);
+        if(!file.is_open()) {
+            std::cerr << "Erro ao criar WAV: " << filename << std::endl;
+            return false;
+        }
+        sampleRate = rate;
+        samplesWritten = 0;
+        writeHeader(0);
+        return true;
+    }
+
+    void write(const int16_t* samples, size_t count) {
+        if(!file.is_open()) return;
+        for(size_t i = 0; i < count; ++i) {
+            write16(static_cast<uint16_t>(samples[i]));
+        }
+        samplesWritten += count;
+    }
+
+    // Consome tudo o que estiver no ring (lado consumidor)
+    size_t drain(SpscRing<int16_t>& ring) {
+        int16_t chunk[DRAIN_CHUNK];
+        size_t total = 0;
+        size_t got;
+        while((got = ring.pop(chunk, DRAIN_CHUNK)) > 0) {
+            write(chunk, got);
+            total += got;
+        }
+        return total;
+    }
+
+    void close() {
+        if(!file.is_open()) return;
+        file.seekp(0, std::ios::beg);
+        writeHeader(samplesWritten * 2);
+        file.close();
+    }
+
+    bool isOpen() const { return file.is_open(); }
+    uint32_t getSamplesWritten() const { return samplesWritten; }
+};
+
+#endif // WAV_WRITER_H
@@ -0,0 +1,111 @@
+/* ============================================================================
+ * libchip8.h - API C estável para embutir o emulador (FFI)
+ * ============================================================================
+ * Cada chamada faz o trabalho de pelo menos um frame de 60 Hz, nunca de uma
+ * instrução isolada: o custo de atravessar a fronteira da FFI é pago por
+ * frame (chip8_run_frames) ou por lote de instâncias (chip8_step_many).
+ *
+ * Ponteiros devolvidos (framebuffer) continuam válidos até chip8_destroy e
+ * refletem o estado atual. Uma instância não é thread-safe; instâncias
+ * diferentes podem rodar em threads diferentes.
+ */
+#ifndef LIBCHIP8_H
+#define LIBCHIP8_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && !defined(CHIP8_STATIC)
+#  ifdef CHIP8_BUILDING_LIBRARY
+#    define CHIP8_API __declspec(dllexport)
+#  else
+#    define CHIP8_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define CHIP8_API __attribute__((visibility("default")))
+#else
+#  define CHIP8_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incrementado a cada mudança incompatível da ABI */
+#define CHIP8_API_VERSION 2
+
+#define CHIP8_SCREEN_WIDTH  64
+#define CHIP8_SCREEN_HEIGHT 32
+
+/* Códigos de retorno */
+#define CHIP8_OK                     0
+#define CHIP8_ERROR_INVALID_ARGUMENT (-1)
+#define CHIP8_ERROR_ROM_TOO_LARGE    (-2)
+
+/* Falhas que param a instância até o próximo chip8_load_rom; o PC fica na
+ * instrução que falhou e chip8_run_frames passa a não fazer nada */
+#define CHIP8_TRAP_NONE            0
+#define CHIP8_TRAP_STACK_OVERFLOW  1
+#define CHIP8_TRAP_STACK_UNDERFLOW 2
+#define CHIP8_TRAP_INVALID_OPCODE  3
+#define CHIP8_TRAP_PC_OUT_OF_RANGE 4
+
+typedef struct chip8_instance chip8_instance;
+
+/* Cópia dos registradores visíveis ao programa */
+typedef struct chip8_state {
+    uint8_t v[16];
+    uint16_t i;
+    uint16_t pc;
+    uint16_t stack[16];
+    uint8_t sp;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t stack_fault;        /* 1 após overflow/underflow da pilha */
+    uint64_t frame_count;
+    uint64_t machine_cycles;    /* Só avança com timing do VIP */
+    uint8_t trap;               /* CHIP8_TRAP_* */
+} chip8_state;
+
+CHIP8_API int chip8_api_version(void);
+
+/* NULL se faltar memória */
+CHIP8_API chip8_instance* chip8_create(void);
+CHIP8_API void chip8_destroy(chip8_instance* instance);
+
+/* Reinicia a máquina e carrega a ROM em 0x200 */
+CHIP8_API int chip8_load_rom(chip8_instance* instance, const uint8_t* data, size_t size);
+
+/* Instruções por frame no modo padrão (10 se não configurado) */
+CHIP8_API void chip8_set_cycles_per_frame(chip8_instance* instance, uint32_t cycles);
+
+/* Diferente de zero: frames medidos em ciclos de máquina do COSMAC VIP */
+CHIP8_API void chip8_set_vip_timing(chip8_instance* instance, int enabled);
+
+CHIP8_API void chip8_seed_random(chip8_instance* instance, uint32_t seed);
+
+/* Bit n = tecla n pressionada */
+CHIP8_API void chip8_set_keys(chip8_instance* instance, uint16_t mask);
+
+/* Executa frames de 60 Hz (instruções + um tick dos timers cada) */
+CHIP8_API void chip8_run_frames(chip8_instance* instance, uint32_t frames);
+
+/* frames em cada uma das count instâncias; entradas NULL são ignoradas */
+CHIP8_API void chip8_step_many(chip8_instance* const* instances, size_t count, uint32_t frames);
+
+/* CHIP8_SCREEN_WIDTH * CHIP8_SCREEN_HEIGHT bytes, um por pixel (0 ou 1) */
+CHIP8_API const uint8_t* chip8_framebuffer(const chip8_instance* instance);
+
+/* CHIP8_TRAP_*; barato o bastante para consultar após cada lote */
+CHIP8_API int chip8_get_trap(const chip8_instance* instance);
+
+/* 1 se a tela mudou desde a última chamada */
+CHIP8_API int chip8_take_redraw(chip8_instance* instance);
+
+CHIP8_API void chip8_get_state(const chip8_instance* instance, chip8_state* state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCHIP8_H */
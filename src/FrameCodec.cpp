@@ -0,0 +1,173 @@
+// ============================================================================
+// FrameCodec.cpp - Deltas compactos do framebuffer para streaming
+// ============================================================================
+#include "FrameCodec.h"
+
+#include <cstring>
+
+constexpr size_t FrameCodec::ROW_BYTES;
+constexpr size_t FrameCodec::ROWS;
+constexpr size_t FrameCodec::PACKED_SIZE;
+constexpr size_t FrameCodec::HEADER_SIZE;
+constexpr uint8_t FrameCodec::FLAG_KEYFRAME;
+
+namespace {
+
+const size_t ROW_BYTES = FrameCodec::ROW_BYTES;
+const size_t ROWS = FrameCodec::ROWS;
+
+const uint8_t TOKEN_LAST = 0x80;
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for(int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+uint32_t getU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Tokens de uma linha com diferença; diff tem ROW_BYTES bytes de XOR
+void encodeRow(const uint8_t* diff, std::vector<uint8_t>& out) {
+    size_t last = ROW_BYTES;
+    while(last > 0 && diff[last - 1] == 0) --last;
+
+    size_t pos = 0;
+    while(pos < last) {
+        size_t skip = 0;
+        while(diff[pos + skip] == 0) ++skip;
+        size_t start = pos + skip;
+        size_t end = start;
+        while(end < last && diff[end] != 0) ++end;
+
+        size_t tokenIndex = out.size();
+        out.push_back(static_cast<uint8_t>((skip << 4) | (end - start)));
+        out.insert(out.end(), diff + start, diff + end);
+        pos = end;
+        if(pos == last) out[tokenIndex] |= TOKEN_LAST;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Encoder
+// ============================================================================
+FrameEncoder::FrameEncoder(uint32_t interval) : keyframeInterval(interval) {
+    reset();
+}
+
+void FrameEncoder::reset() {
+    std::memset(reference, 0, sizeof(reference));
+    sequence = 0;
+    sinceKeyframe = 0;
+    forceKeyframe = true;
+}
+
+void FrameEncoder::encode(const uint8_t* pixels, std::vector<uint8_t>& out) {
+    uint8_t packed[FrameCodec::PACKED_SIZE];
+    FrameCodec::packPixels(pixels, packed);
+    encodePacked(packed, out);
+}
+
+void FrameEncoder::encodePacked(const uint8_t* packed, std::vector<uint8_t>& out) {
+    bool keyframe = forceKeyframe || (keyframeInterval > 0 && sinceKeyframe >= keyframeInterval);
+    if(keyframe) {
+        std::memset(reference, 0, sizeof(reference));
+        sinceKeyframe = 0;
+        forceKeyframe = false;
+    }
+
+    uint8_t diff[FrameCodec::PACKED_SIZE];
+    uint32_t rows = 0;
+    for(size_t r = 0; r < ROWS; ++r) {
+        uint8_t any = 0;
+        for(size_t b = 0; b < ROW_BYTES; ++b) {
+            size_t i = r * ROW_BYTES + b;
+            diff[i] = reference[i] ^ packed[i];
+            any |= diff[i];
+        }
+        if(any) rows |= 1u << r;
+    }
+
+    ++sequence;
+    ++sinceKeyframe;
+    out.push_back(keyframe ? FrameCodec::FLAG_KEYFRAME : 0);
+    putU32(out, sequence);
+    putU32(out, rows);
+    for(size_t r = 0; r < ROWS; ++r) {
+        if(rows & (1u << r)) encodeRow(diff + r * ROW_BYTES, out);
+    }
+
+    std::memcpy(reference, packed, sizeof(reference));
+}
+
+// ============================================================================
+// Decoder
+// ============================================================================
+FrameDecoder::FrameDecoder() {
+    reset();
+}
+
+void FrameDecoder::reset() {
+    std::memset(packed, 0, sizeof(packed));
+    sequence = 0;
+    synced = false;
+}
+
+FrameDecodeStatus FrameDecoder::decode(const uint8_t* data, size_t size, size_t& consumed) {
+    consumed = 0;
+    if(size < FrameCodec::HEADER_SIZE) return FrameDecodeStatus::Incomplete;
+
+    uint8_t flags = data[0];
+    if(flags & ~FrameCodec::FLAG_KEYFRAME) return FrameDecodeStatus::Corrupt;
+    bool keyframe = (flags & FrameCodec::FLAG_KEYFRAME) != 0;
+    uint32_t packetSequence = getU32(data + 1);
+    uint32_t rows = getU32(data + 5);
+    if(rows & ~static_cast<uint32_t>((static_cast<uint64_t>(1) << ROWS) - 1)) {
+        return FrameDecodeStatus::Corrupt;
+    }
+
+    // Aplica numa cópia: só altera o estado com o pacote inteiro e válido
+    uint8_t next[FrameCodec::PACKED_SIZE];
+    if(keyframe) {
+        std::memset(next, 0, sizeof(next));
+    } else {
+        std::memcpy(next, packed, sizeof(next));
+    }
+
+    size_t pos = FrameCodec::HEADER_SIZE;
+    for(size_t r = 0; r < ROWS; ++r) {
+        if(!(rows & (1u << r))) continue;
+
+        uint8_t* row = next + r * ROW_BYTES;
+        size_t column = 0;
+        for(;;) {
+            if(pos >= size) return FrameDecodeStatus::Incomplete;
+            uint8_t token = data[pos++];
+            size_t skip = (token >> 4) & 0x7;
+            size_t count = token & 0xF;
+            if(count == 0 || column + skip + count > ROW_BYTES) return FrameDecodeStatus::Corrupt;
+            if(pos + count > size) return FrameDecodeStatus::Incomplete;
+
+            column += skip;
+            for(size_t k = 0; k < count; ++k) {
+                row[column + k] ^= data[pos + k];
+            }
+            column += count;
+            pos += count;
+            if(token & TOKEN_LAST) break;
+        }
+    }
+    consumed = pos;
+
+    if(!keyframe && (!synced || packetSequence != static_cast<uint32_t>(sequence + 1))) {
+        synced = false;
+        return FrameDecodeStatus::NeedKeyframe;
+    }
+
+    std::memcpy(packed, next, sizeof(packed));
+    sequence = packetSequence;
+    synced = true;
+    return FrameDecodeStatus::Frame;
+}
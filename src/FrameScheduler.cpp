@@ -0,0 +1,292 @@
+// ============================================================================
+// FrameScheduler.cpp - EDF particionado com workers presos a núcleos
+// ============================================================================
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+const int64_t JITTER_GAIN = 16;     // RFC 3550: J += (|D| - J) / 16
+
+int64_t nanoseconds(FramePacer::Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+} // namespace
+
+FrameScheduler::FrameScheduler(const FrameSchedulerOptions& opts, const FrameCallback& callback)
+    : options(opts), onFrame(callback), stopping(false), pinned(false), started(false),
+      nextSessionId(1) {
+    if(options.workerThreads == 0) {
+        options.workerThreads = std::thread::hardware_concurrency();
+        if(options.workerThreads == 0) options.workerThreads = 1;
+    }
+    if(options.maxLateFrames == 0) options.maxLateFrames = 1;
+
+    for(size_t i = 0; i < options.workerThreads; ++i) {
+        workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+}
+
+FrameScheduler::~FrameScheduler() {
+    stop();
+}
+
+void FrameScheduler::start() {
+    if(started) return;
+    started = true;
+    stopping.store(false);
+    pinned.store(options.pinWorkers);
+    for(size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->thread = std::thread(&FrameScheduler::workerLoop, this, i);
+    }
+}
+
+void FrameScheduler::stop() {
+    if(!started) return;
+    stopping.store(true);
+    for(size_t i = 0; i < workers.size(); ++i) {
+        std::lock_guard<std::mutex> lock(workers[i]->mutex);
+        workers[i]->wake.notify_all();
+    }
+    for(size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->thread.join();
+    }
+    started = false;
+}
+
+// ============================================================================
+// Sessões
+// ============================================================================
+
+uint32_t FrameScheduler::addSession(const uint8_t* rom, size_t size, const RunOptions& runOptions) {
+    std::unique_ptr<Session> session(new Session());
+    session->machine.initialize();
+    if(size == 0 || !session->machine.loadROM(rom, size)) {
+        std::cerr << "ROM vazia ou muito grande para a sessão" << std::endl;
+        return 0;
+    }
+    session->options = runOptions;
+    session->period = FramePacer(runOptions.speed).getFramePeriod();
+    session->running = false;
+    session->removed = false;
+
+    // Ordem dos locks: registro, depois worker (o worker nunca pega o registro)
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    Worker* target = nullptr;
+    size_t fewest = 0;
+    for(size_t i = 0; i < workers.size(); ++i) {
+        std::lock_guard<std::mutex> lock(workers[i]->mutex);
+        if(!target || workers[i]->sessions.size() < fewest) {
+            target = workers[i].get();
+            fewest = workers[i]->sessions.size();
+        }
+    }
+
+    uint32_t id = nextSessionId++;
+    session->id = id;
+    session->release = Clock::now();
+    session->deadline = session->release + session->period;
+    session->lastDone = Clock::time_point();
+    registry[id] = target;
+
+    std::lock_guard<std::mutex> lock(target->mutex);
+    target->pending.push_back(session.get());
+    std::push_heap(target->pending.begin(), target->pending.end(), laterRelease);
+    target->sessions[id] = std::move(session);
+    target->wake.notify_one();
+    return id;
+}
+
+bool FrameScheduler::removeSession(uint32_t id) {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    std::map<uint32_t, Worker*>::iterator entry = registry.find(id);
+    if(entry == registry.end()) return false;
+    Worker& worker = *entry->second;
+    registry.erase(entry);
+
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    std::map<uint32_t, std::unique_ptr<Session>>::iterator it = worker.sessions.find(id);
+    Session* session = it->second.get();
+    if(session->running) {
+        session->removed = true;        // O worker descarta ao terminar o frame
+        return true;
+    }
+    std::vector<Session*>::iterator queued = std::find(worker.ready.begin(), worker.ready.end(), session);
+    if(queued != worker.ready.end()) {
+        worker.ready.erase(queued);
+        std::make_heap(worker.ready.begin(), worker.ready.end(), laterDeadline);
+    } else {
+        worker.pending.erase(std::find(worker.pending.begin(), worker.pending.end(), session));
+        std::make_heap(worker.pending.begin(), worker.pending.end(), laterRelease);
+    }
+    worker.sessions.erase(it);
+    return true;
+}
+
+bool FrameScheduler::postKey(uint32_t id, uint8_t key, bool pressed) {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    Worker* worker = findWorker(id);
+    if(!worker) return false;
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    // A fila de Input aceita produtores de qualquer thread
+    return worker->sessions[id]->machine.getInput().postKey(key, pressed);
+}
+
+bool FrameScheduler::getStats(uint32_t id, FrameStats& stats) const {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    Worker* worker = findWorker(id);
+    if(!worker) return false;
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    stats = worker->sessions.find(id)->second->stats;
+    return true;
+}
+
+FrameStats FrameScheduler::getTotals() const {
+    FrameStats totals;
+    for(size_t i = 0; i < workers.size(); ++i) {
+        std::lock_guard<std::mutex> lock(workers[i]->mutex);
+        std::map<uint32_t, std::unique_ptr<Session>>::const_iterator it = workers[i]->sessions.begin();
+        for(; it != workers[i]->sessions.end(); ++it) {
+            const FrameStats& stats = it->second->stats;
+            totals.frames += stats.frames;
+            totals.misses += stats.misses;
+            totals.dropped += stats.dropped;
+            totals.worstLateness = std::max(totals.worstLateness, stats.worstLateness);
+            totals.jitter = std::max(totals.jitter, stats.jitter);
+        }
+    }
+    return totals;
+}
+
+size_t FrameScheduler::getSessionCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return registry.size();
+}
+
+// Com registryMutex
+FrameScheduler::Worker* FrameScheduler::findWorker(uint32_t id) const {
+    std::map<uint32_t, Worker*>::const_iterator it = registry.find(id);
+    return it == registry.end() ? nullptr : it->second;
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+void FrameScheduler::workerLoop(size_t index) {
+    if(options.pinWorkers && !pinToCore(index)) {
+        pinned.store(false);
+    }
+
+    Worker& worker = *workers[index];
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while(!stopping.load()) {
+        // Liberadas passam para a fila de prontas
+        Clock::time_point now = Clock::now();
+        while(!worker.pending.empty() && worker.pending.front()->release <= now) {
+            std::pop_heap(worker.pending.begin(), worker.pending.end(), laterRelease);
+            worker.ready.push_back(worker.pending.back());
+            worker.pending.pop_back();
+            std::push_heap(worker.ready.begin(), worker.ready.end(), laterDeadline);
+        }
+
+        // Nenhuma pronta: dorme até a próxima liberação ou uma sessão nova
+        if(worker.ready.empty()) {
+            if(worker.pending.empty()) {
+                worker.wake.wait(lock);
+            } else {
+                worker.wake.wait_until(lock, worker.pending.front()->release);
+            }
+            continue;
+        }
+
+        Session* session = worker.ready.front();
+        std::pop_heap(worker.ready.begin(), worker.ready.end(), laterDeadline);
+        worker.ready.pop_back();
+        session->running = true;
+        lock.unlock();
+
+        session->machine.runFrame(session->options);
+        if(onFrame) onFrame(session->id, session->machine);
+        Clock::time_point done = Clock::now();
+
+        lock.lock();
+        session->running = false;
+        if(session->removed) {
+            worker.sessions.erase(session->id);
+            continue;
+        }
+        account(*session, done);
+        worker.pending.push_back(session);
+        std::push_heap(worker.pending.begin(), worker.pending.end(), laterRelease);
+    }
+}
+
+// Com o mutex do worker: estatísticas do frame e deadline do próximo
+void FrameScheduler::account(Session& session, Clock::time_point done) {
+    FrameStats& stats = session.stats;
+    int64_t lateness = nanoseconds(done - session.deadline);
+    ++stats.frames;
+    if(lateness > 0) ++stats.misses;
+    stats.worstLateness = std::max(stats.worstLateness, lateness);
+
+    if(stats.frames > 1) {
+        int64_t deviation = nanoseconds(done - session.lastDone) - nanoseconds(session.period);
+        if(deviation < 0) deviation = -deviation;
+        stats.jitter += (deviation - stats.jitter) / JITTER_GAIN;
+    }
+    session.lastDone = done;
+
+    // O próximo frame já pode estar liberado (atraso): roda em seguida. Com
+    // a liberação mais de maxLateFrames no passado, os perdidos são pulados.
+    session.release = session.deadline;
+    Clock::duration behind = done - session.release;
+    if(behind >= session.period * options.maxLateFrames) {
+        uint64_t skipped = static_cast<uint64_t>(behind / session.period);
+        session.release += session.period * skipped;
+        stats.dropped += skipped;
+    }
+    session.deadline = session.release + session.period;
+}
+
+// Worker i no i-ésimo núcleo permitido ao processo (módulo a quantidade)
+bool FrameScheduler::pinToCore(size_t index) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+        std::cerr << "Erro ao ler afinidade: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    size_t wanted = index % CPU_COUNT(&allowed);
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if(!CPU_ISSET(cpu, &allowed) || wanted-- > 0) continue;
+
+        cpu_set_t single;
+        CPU_ZERO(&single);
+        CPU_SET(cpu, &single);
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(single), &single);
+        if(error != 0) {
+            std::cerr << "Erro ao prender worker ao núcleo " << cpu << ": "
+                      << std::strerror(error) << std::endl;
+            return false;
+        }
+        return true;
+    }
+    return false;
+#else
+    (void)index;
+    return false;
+#endif
+}
@@ -0,0 +1,689 @@
+// ============================================================================
+// GoldenSuite.cpp - Regressão ponta a ponta por hashes de ROMs executadas
+// ============================================================================
+#include "GoldenSuite.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+#include "Fnv1a.h"
+
+namespace {
+
+// ============================================================================
+// Montagem das ROMs geradas
+// ============================================================================
+uint16_t jp(uint16_t address) { return 0x1000 | (address & 0xFFF); }
+uint16_t call(uint16_t address) { return 0x2000 | (address & 0xFFF); }
+uint16_t se(uint8_t x, uint8_t nn) { return 0x3000 | (x << 8) | nn; }
+uint16_t sne(uint8_t x, uint8_t nn) { return 0x4000 | (x << 8) | nn; }
+uint16_t seReg(uint8_t x, uint8_t y) { return 0x5000 | (x << 8) | (y << 4); }
+uint16_t ld(uint8_t x, uint8_t nn) { return 0x6000 | (x << 8) | nn; }
+uint16_t add(uint8_t x, uint8_t nn) { return 0x7000 | (x << 8) | nn; }
+uint16_t alu(uint8_t x, uint8_t y, uint8_t n) { return 0x8000 | (x << 8) | (y << 4) | n; }
+uint16_t sneReg(uint8_t x, uint8_t y) { return 0x9000 | (x << 8) | (y << 4); }
+uint16_t ldI(uint16_t address) { return 0xA000 | (address & 0xFFF); }
+uint16_t jpV0(uint16_t address) { return 0xB000 | (address & 0xFFF); }
+uint16_t rnd(uint8_t x, uint8_t nn) { return 0xC000 | (x << 8) | nn; }
+uint16_t drw(uint8_t x, uint8_t y, uint8_t n) { return 0xD000 | (x << 8) | (y << 4) | n; }
+uint16_t sknp(uint8_t x) { return 0xE0A1 | (x << 8); }
+uint16_t fx(uint8_t x, uint8_t nn) { return 0xF000 | (x << 8) | nn; }
+
+const uint16_t CLS = 0x00E0;
+const uint16_t RET = 0x00EE;
+
+class RomBuilder {
+public:
+    std::vector<uint8_t> rom;
+
+    uint16_t here() const { return static_cast<uint16_t>(0x200 + rom.size()); }
+
+    void op(uint16_t opcode) {
+        rom.push_back(static_cast<uint8_t>(opcode >> 8));
+        rom.push_back(static_cast<uint8_t>(opcode & 0xFF));
+    }
+
+    void patch(uint16_t address, uint16_t opcode) {
+        rom[address - 0x200] = static_cast<uint8_t>(opcode >> 8);
+        rom[address - 0x200 + 1] = static_cast<uint8_t>(opcode & 0xFF);
+    }
+
+    void halt() { op(jp(here())); }
+};
+
+// ROM de verificações no estilo das ROMs de teste de opcodes: cada
+// verificação desenha C (certo) ou E (erro) numa grade de 12 colunas.
+// VA, VB, VE e VF são do relatório; as verificações usam os demais.
+class CheckRom {
+private:
+    RomBuilder builder;
+    uint16_t report;
+    unsigned count;
+
+public:
+    CheckRom() : count(0) {
+        builder.op(jp(0));
+        report = builder.here();
+        builder.op(fx(0xE, 0x29));          // Glifo em VE
+        builder.op(drw(0xA, 0xB, 5));
+        builder.op(RET);
+        builder.patch(0x200, jp(builder.here()));
+    }
+
+    RomBuilder& code() { return builder; }
+
+    // Desenha o glifo em VE na próxima posição da grade
+    void draw() {
+        builder.op(ld(0xA, static_cast<uint8_t>((count % 12) * 5 + 2)));
+        builder.op(ld(0xB, static_cast<uint8_t>((count / 12) * 6 + 1)));
+        builder.op(call(report));
+        ++count;
+    }
+
+    void expect(uint8_t reg, uint8_t value) {
+        builder.op(ld(0xE, 0xE));
+        builder.op(sne(reg, value));
+        builder.op(ld(0xE, 0xC));
+        draw();
+    }
+
+    // Resultado em reg e flag (copiada antes que o DRW do relatório a mude)
+    void expectWithFlag(uint8_t reg, uint8_t value, uint8_t flag) {
+        builder.op(alu(3, 0xF, 0));
+        expect(reg, value);
+        expect(3, flag);
+    }
+
+    void expectSkip(uint16_t skipOp) {
+        builder.op(ld(0xE, 0xC));
+        builder.op(skipOp);
+        builder.op(ld(0xE, 0xE));
+        draw();
+    }
+
+    void expectNoSkip(uint16_t skipOp) {
+        builder.op(ld(0xE, 0xE));
+        builder.op(skipOp);
+        builder.op(ld(0xE, 0xC));
+        draw();
+    }
+
+    std::vector<uint8_t> finish() {
+        builder.halt();
+        return builder.rom;
+    }
+};
+
+std::vector<uint8_t> opcodeRom() {
+    CheckRom checks;
+    RomBuilder& b = checks.code();
+
+    b.op(ld(1, 0x2A));
+    checks.expect(1, 0x2A);
+    b.op(ld(1, 0xFF));
+    b.op(add(1, 2));
+    checks.expect(1, 0x01);
+    b.op(ld(0xF, 0x55));                    // 7XNN não altera VF
+    b.op(add(1, 1));
+    checks.expect(0xF, 0x55);
+
+    b.op(ld(2, 7));
+    b.op(alu(1, 2, 0x0));
+    checks.expect(1, 7);
+    b.op(ld(1, 0x0F));
+    b.op(ld(2, 0xF0));
+    b.op(alu(1, 2, 0x1));
+    checks.expect(1, 0xFF);
+    b.op(ld(1, 0x3C));
+    b.op(ld(2, 0x0F));
+    b.op(alu(1, 2, 0x2));
+    checks.expect(1, 0x0C);
+    b.op(ld(1, 0xFF));
+    b.op(alu(1, 2, 0x3));
+    checks.expect(1, 0xF0);
+
+    // Aritmética com flag, nos dois sentidos
+    b.op(ld(1, 0xFF));
+    b.op(ld(2, 0x02));
+    b.op(alu(1, 2, 0x4));
+    checks.expectWithFlag(1, 0x01, 1);
+    b.op(ld(1, 0x10));
+    b.op(ld(2, 0x20));
+    b.op(alu(1, 2, 0x4));
+    checks.expectWithFlag(1, 0x30, 0);
+    b.op(ld(1, 0x30));
+    b.op(ld(2, 0x10));
+    b.op(alu(1, 2, 0x5));
+    checks.expectWithFlag(1, 0x20, 1);
+    b.op(ld(1, 0x10));
+    b.op(ld(2, 0x30));
+    b.op(alu(1, 2, 0x5));
+    checks.expectWithFlag(1, 0xE0, 0);
+    b.op(ld(1, 0x05));
+    b.op(alu(1, 1, 0x6));
+    checks.expectWithFlag(1, 0x02, 1);
+    b.op(ld(1, 0x10));
+    b.op(ld(2, 0x30));
+    b.op(alu(1, 2, 0x7));
+    checks.expectWithFlag(1, 0x20, 1);
+    b.op(ld(1, 0x30));
+    b.op(ld(2, 0x10));
+    b.op(alu(1, 2, 0x7));
+    checks.expectWithFlag(1, 0xE0, 0);
+    b.op(ld(1, 0x81));
+    b.op(alu(1, 1, 0xE));
+    checks.expectWithFlag(1, 0x02, 1);
+    b.op(ld(1, 0x41));
+    b.op(alu(1, 1, 0xE));
+    checks.expectWithFlag(1, 0x82, 0);
+
+    // Saltos condicionais
+    b.op(ld(1, 5));
+    b.op(ld(2, 5));
+    checks.expectSkip(se(1, 5));
+    checks.expectNoSkip(se(1, 6));
+    checks.expectSkip(sne(1, 6));
+    checks.expectNoSkip(sne(1, 5));
+    checks.expectSkip(seReg(1, 2));
+    checks.expectNoSkip(sneReg(1, 2));
+    b.op(ld(2, 6));
+    checks.expectSkip(sneReg(1, 2));
+    checks.expectNoSkip(seReg(1, 2));
+
+    // CALL/RET, inclusive aninhados
+    uint16_t over = b.here();
+    b.op(jp(0));
+    uint16_t inner = b.here();
+    b.op(ld(1, 0x99));
+    b.op(RET);
+    uint16_t outer = b.here();
+    b.op(call(inner));
+    b.op(add(1, 1));
+    b.op(RET);
+    b.patch(over, jp(b.here()));
+    b.op(ld(1, 0));
+    b.op(call(inner));
+    checks.expect(1, 0x99);
+    b.op(call(outer));
+    checks.expect(1, 0x9A);
+
+    // BNNN: V0 = 4 pula o caminho de erro
+    b.op(ld(0, 4));
+    uint16_t jump = b.here();
+    b.op(jpV0(jump + 2));
+    b.op(ld(0xE, 0xE));
+    b.op(jp(jump + 8));
+    b.op(ld(0xE, 0xC));
+    checks.draw();
+
+    // ANNN, FX1E, FX55, FX65
+    b.op(ld(0, 0x42));
+    b.op(ldI(0x310));
+    b.op(fx(0, 0x55));
+    b.op(ldI(0x300));
+    b.op(ld(1, 0x10));
+    b.op(fx(1, 0x1E));
+    b.op(ld(0, 0));
+    b.op(fx(0, 0x65));
+    checks.expect(0, 0x42);
+
+    // FX33
+    b.op(ld(1, 234));
+    b.op(ldI(0x320));
+    b.op(fx(1, 0x33));
+    b.op(fx(2, 0x65));
+    checks.expect(0, 2);
+    checks.expect(1, 3);
+    checks.expect(2, 4);
+
+    // FX29: primeira linha do glifo 1 é 0x20
+    b.op(ld(1, 1));
+    b.op(fx(1, 0x29));
+    b.op(fx(0, 0x65));
+    checks.expect(0, 0x20);
+
+    // DXYN: colisão só no segundo desenho, que apaga o primeiro
+    b.op(ld(1, 40));
+    b.op(ld(2, 26));
+    b.op(ld(4, 8));
+    b.op(fx(4, 0x29));
+    b.op(drw(1, 2, 5));
+    b.op(alu(4, 0xF, 0));
+    b.op(drw(1, 2, 5));
+    b.op(alu(5, 0xF, 0));
+    checks.expect(4, 0);
+    checks.expect(5, 1);
+
+    // CXNN com máscara 0 independe do gerador
+    b.op(ld(1, 0xFF));
+    b.op(rnd(1, 0x00));
+    checks.expect(1, 0);
+
+    return checks.finish();
+}
+
+// Comportamentos que variam entre interpretadores, desenhados como dígitos
+// (0 = CHIP-48/SCHIP e modernos, 1 = COSMAC VIP, salvo indicação)
+std::vector<uint8_t> quirksRom() {
+    CheckRom digits;
+    RomBuilder& b = digits.code();
+
+    // VF como destino: 0 = resultado por último, 1 = flag por último
+    b.op(ld(0xF, 0xFF));
+    b.op(ld(1, 1));
+    b.op(alu(0xF, 1, 0x4));
+    b.op(alu(0xE, 0xF, 0));
+    digits.draw();
+
+    // Shift: 2 = desloca VX, 0 = desloca VY
+    b.op(ld(1, 0x04));
+    b.op(ld(2, 0x01));
+    b.op(alu(1, 2, 0x6));
+    b.op(alu(0xE, 1, 0));
+    digits.draw();
+
+    // FX55/FX65: 7 = I inalterado, 0 = I avança
+    b.op(ld(0, 7));
+    b.op(ld(1, 9));
+    b.op(ldI(0x300));
+    b.op(fx(1, 0x55));
+    b.op(fx(0, 0x65));
+    b.op(alu(0xE, 0, 0));
+    digits.draw();
+
+    // 8XY1 zera VF: 5 = mantém, 0 = zera
+    b.op(ld(0xF, 5));
+    b.op(alu(1, 2, 0x1));
+    b.op(alu(0xE, 0xF, 0));
+    digits.draw();
+
+    // BNNN: 0 = soma V0, 1 = soma VX (BXNN)
+    b.op(ld(0, 0));
+    b.op(ld(2, 4));
+    uint16_t jump = b.here();
+    b.op(jpV0(jump + 2));
+    b.op(ld(0xE, 0));
+    b.op(jp(jump + 8));
+    b.op(ld(0xE, 1));
+    digits.draw();
+
+    // Sprites na borda: recorte ou wrap ficam na tela final
+    b.op(ld(4, 0));
+    b.op(fx(4, 0x29));
+    b.op(ld(1, 62));
+    b.op(ld(2, 12));
+    b.op(drw(1, 2, 5));
+    b.op(ld(1, 40));
+    b.op(ld(2, 30));
+    b.op(drw(1, 2, 5));
+
+    return digits.finish();
+}
+
+std::vector<uint8_t> fontRom() {
+    RomBuilder b;
+    for(uint8_t d = 0; d < 16; ++d) {
+        b.op(ld(1, d));
+        b.op(fx(1, 0x29));
+        b.op(ld(0xA, static_cast<uint8_t>((d % 8) * 6 + 4)));
+        b.op(ld(0xB, static_cast<uint8_t>((d / 8) * 7 + 2)));
+        b.op(drw(0xA, 0xB, 5));
+    }
+
+    // Sprite de 15 linhas vindo da ROM, como o logo das ROMs clássicas
+    uint16_t load = b.here();
+    b.op(ldI(0));
+    b.op(ld(0xA, 52));
+    b.op(ld(0xB, 16));
+    b.op(drw(0xA, 0xB, 15));
+    b.halt();
+    b.patch(load, ldI(b.here()));
+    const uint8_t logo[15] = {0xFF, 0x81, 0xBD, 0xA5, 0xA5, 0xBD, 0x81, 0xFF,
+                              0x18, 0x3C, 0x7E, 0xFF, 0x7E, 0x3C, 0x18};
+    b.rom.insert(b.rom.end(), logo, logo + sizeof(logo));
+    return b.rom;
+}
+
+// Espera tecla, desenha o dígito e espera soltar
+std::vector<uint8_t> keypadRom() {
+    RomBuilder b;
+    b.op(ld(0xA, 2));
+    b.op(ld(0xB, 2));
+    uint16_t loop = b.here();
+    b.op(fx(0, 0x0A));
+    b.op(fx(0, 0x29));
+    b.op(drw(0xA, 0xB, 5));
+    b.op(add(0xA, 5));
+    uint16_t release = b.here();
+    b.op(sknp(0));
+    b.op(jp(release));
+    b.op(jp(loop));
+    return b.rom;
+}
+
+// Conta voltas até o delay timer zerar e mostra a contagem em decimal
+std::vector<uint8_t> timersRom() {
+    RomBuilder b;
+    b.op(ld(1, 30));
+    b.op(fx(1, 0x15));
+    b.op(ld(3, 0));
+    uint16_t loop = b.here();
+    b.op(fx(2, 0x07));
+    b.op(add(3, 1));
+    b.op(se(2, 0));
+    b.op(jp(loop));
+
+    b.op(ldI(0x300));
+    b.op(fx(3, 0x33));
+    b.op(fx(2, 0x65));
+    b.op(ld(0xB, 10));
+    for(uint8_t d = 0; d < 3; ++d) {
+        b.op(fx(d, 0x29));
+        b.op(ld(0xA, static_cast<uint8_t>(20 + d * 6)));
+        b.op(drw(0xA, 0xB, 5));
+    }
+    b.op(ld(1, 10));
+    b.op(fx(1, 0x18));
+    b.halt();
+    return b.rom;
+}
+
+// Wrap de coordenadas, sobreposição, DXY0 e 00E0 no meio do desenho
+std::vector<uint8_t> spritesRom() {
+    RomBuilder b;
+    b.op(ld(4, 8));
+    b.op(fx(4, 0x29));
+    b.op(ld(1, 10));
+    b.op(ld(2, 10));
+    b.op(drw(1, 2, 5));
+    b.op(CLS);
+
+    b.op(ld(1, 70));                // Coordenada inicial faz wrap: (6, 8)
+    b.op(ld(2, 40));
+    b.op(drw(1, 2, 5));
+    b.op(ld(1, 60));
+    b.op(ld(2, 0));
+    b.op(drw(1, 2, 5));
+    b.op(ld(1, 0));
+    b.op(ld(2, 29));
+    b.op(drw(1, 2, 5));
+
+    b.op(ld(4, 0));                 // 0 sobre 8, na mesma posição
+    b.op(fx(4, 0x29));
+    b.op(ld(1, 30));
+    b.op(ld(2, 12));
+    b.op(drw(1, 2, 5));
+    b.op(ld(4, 8));
+    b.op(fx(4, 0x29));
+    b.op(drw(1, 2, 5));
+    b.op(alu(5, 0xF, 0));
+    b.op(fx(5, 0x29));
+    b.op(ld(1, 40));
+    b.op(drw(1, 2, 5));
+    b.op(drw(1, 2, 0));
+    b.halt();
+    return b.rom;
+}
+
+std::vector<uint8_t> stackOverflowRom() {
+    RomBuilder b;
+    b.op(ld(1, 0));
+    uint16_t recurse = b.here();
+    b.op(add(1, 1));
+    b.op(call(recurse));
+    return b.rom;
+}
+
+std::vector<uint8_t> invalidOpcodeRom() {
+    RomBuilder b;
+    b.op(ld(1, 3));
+    b.op(fx(1, 0x29));
+    b.op(drw(1, 1, 5));
+    b.op(fx(1, 0xFF));
+    return b.rom;
+}
+
+std::vector<uint8_t> pcOverflowRom() {
+    RomBuilder b;
+    b.op(jp(0xFF0));                // Memória zerada (SYS) até o fim
+    return b.rom;
+}
+
+GoldenCase makeCase(const char* name, const std::vector<uint8_t>& rom, uint32_t frames) {
+    GoldenCase test;
+    test.name = name;
+    test.rom = rom;
+    test.frames = frames;
+    return test;
+}
+
+// ============================================================================
+// Hashes
+// ============================================================================
+void putValue(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for(int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+uint64_t hashState(const Chip8& machine) {
+    const Registers& registers = machine.getRegisters();
+    std::vector<uint8_t> state;
+    for(uint8_t n = 0; n < 16; ++n) {
+        putValue(state, registers.getV(n), 1);
+        putValue(state, registers.getStackEntry(n), 2);
+    }
+    putValue(state, registers.getI(), 2);
+    putValue(state, registers.getPC(), 2);
+    putValue(state, registers.getSP(), 1);
+    putValue(state, registers.getDelayTimer(), 1);
+    putValue(state, registers.getSoundTimer(), 1);
+    putValue(state, static_cast<uint8_t>(registers.getTrap()), 1);
+    putValue(state, machine.getFrameCount(), 8);
+    putValue(state, machine.getMachineCycles(), 8);
+
+    uint64_t hash = fnv1a(state.data(), state.size());
+    return fnv1a(machine.getMemory().getPointer(0, 4096), 4096, hash);
+}
+
+} // namespace
+
+// ============================================================================
+// Corpus
+// ============================================================================
+std::vector<GoldenCase> GoldenSuite::builtinCases() {
+    std::vector<GoldenCase> cases;
+    cases.push_back(makeCase("opcodes", opcodeRom(), 120));
+
+    GoldenCase vip = makeCase("opcodes_vip", opcodeRom(), 120);
+    vip.vipTiming = true;
+    cases.push_back(vip);
+
+    cases.push_back(makeCase("quirks", quirksRom(), 30));
+    cases.push_back(makeCase("font", fontRom(), 30));
+
+    GoldenCase keypad = makeCase("keypad", keypadRom(), 40);
+    const GoldenInput script[] = {
+        {5, 1 << 0x5}, {8, 0}, {12, 1 << 0xA}, {15, 0},
+        {20, (1 << 0x3) | (1 << 0xC)}, {24, 0}, {30, 1 << 0xF}, {33, 0}
+    };
+    keypad.input.assign(script, script + sizeof(script) / sizeof(script[0]));
+    cases.push_back(keypad);
+
+    cases.push_back(makeCase("timers", timersRom(), 60));
+    cases.push_back(makeCase("sprites", spritesRom(), 10));
+    cases.push_back(makeCase("trap_stack_overflow", stackOverflowRom(), 10));
+    cases.push_back(makeCase("trap_invalid_opcode", invalidOpcodeRom(), 10));
+
+    GoldenCase runaway = makeCase("trap_pc_out_of_range", pcOverflowRom(), 10);
+    runaway.cyclesPerFrame = 500;
+    cases.push_back(runaway);
+    return cases;
+}
+
+bool GoldenSuite::addRomFile(const std::string& path, std::vector<GoldenCase>& cases) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if(!file.is_open()) {
+        std::cerr << "Erro ao abrir ROM: " << path << std::endl;
+        return false;
+    }
+
+    GoldenCase test;
+    size_t slash = path.find_last_of("/\\");
+    test.name = slash == std::string::npos ? path : path.substr(slash + 1);
+    test.rom.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    cases.push_back(test);
+    return true;
+}
+
+// ============================================================================
+// Execução
+// ============================================================================
+GoldenResult GoldenSuite::run(const GoldenCase& test, Chip8& machine) {
+    machine.initialize();
+    machine.seedRandom(0);
+    machine.loadROM(test.rom.data(), test.rom.size());
+
+    RunOptions options;
+    options.cyclesPerFrame = test.cyclesPerFrame;
+    options.vipTiming = test.vipTiming;
+
+    size_t nextInput = 0;
+    for(uint32_t frame = 0; frame < test.frames; ++frame) {
+        while(nextInput < test.input.size() && test.input[nextInput].frame <= frame) {
+            machine.getInput().setKeyMask(test.input[nextInput].keyMask);
+            ++nextInput;
+        }
+        machine.runFrame(options);
+    }
+
+    GoldenResult result;
+    result.name = test.name;
+    result.frameHash = fnv1a(machine.getDisplay().getPixels(), Display::getWidth() * Display::getHeight());
+    result.stateHash = hashState(machine);
+    result.trap = machine.getTrap();
+    return result;
+}
+
+GoldenResult GoldenSuite::run(const GoldenCase& test) {
+    Chip8 machine;
+    return run(test, machine);
+}
+
+std::vector<GoldenResult> GoldenSuite::runAll(const std::vector<GoldenCase>& cases, size_t jobs) {
+    std::vector<GoldenResult> results(cases.size());
+    if(jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min(jobs, cases.size());
+
+    // Casos têm durações bem diferentes: cada thread pega o próximo livre
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < jobs; ++t) {
+        threads.push_back(std::thread([&]() {
+            for(size_t i = next.fetch_add(1); i < cases.size(); i = next.fetch_add(1)) {
+                results[i] = run(cases[i]);
+            }
+        }));
+    }
+    for(size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    return results;
+}
+
+// ============================================================================
+// Arquivo de goldens
+// ============================================================================
+bool GoldenSuite::load(const std::string& path, GoldenTable& table) {
+    std::ifstream file(path.c_str());
+    if(!file.is_open()) {
+        std::cerr << "Erro ao abrir goldens: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    for(size_t number = 1; std::getline(file, line); ++number) {
+        if(line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        GoldenResult result;
+        unsigned trap = 0;
+        if(!(fields >> result.name >> std::hex >> result.frameHash >> result.stateHash >> std::dec >> trap) ||
+           trap > static_cast<unsigned>(Trap::PcOutOfRange)) {
+            std::cerr << "Linha de golden inválida em " << path << ":" << number << std::endl;
+            return false;
+        }
+        result.trap = static_cast<Trap>(trap);
+        table[result.name] = result;
+    }
+    return true;
+}
+
+bool GoldenSuite::save(const std::string& path, const std::vector<GoldenResult>& results) {
+    std::ofstream file(path.c_str());
+    if(!file.is_open()) {
+        std::cerr << "Erro ao gravar goldens: " << path << std::endl;
+        return false;
+    }
+
+    file << "# Goldens do chip8-golden: nome, hash da tela, hash do estado, trap\n";
+    for(size_t i = 0; i < results.size(); ++i) {
+        char hashes[40];
+        std::snprintf(hashes, sizeof(hashes), "%016llx %016llx",
+                      static_cast<unsigned long long>(results[i].frameHash),
+                      static_cast<unsigned long long>(results[i].stateHash));
+        file << results[i].name << " " << hashes << " " << static_cast<unsigned>(results[i].trap) << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+size_t GoldenSuite::compare(const std::vector<GoldenResult>& results, const GoldenTable& table,
+                            std::string& out) {
+    std::ostringstream report;
+    size_t failures = 0;
+    for(size_t i = 0; i < results.size(); ++i) {
+        const GoldenResult& result = results[i];
+        GoldenTable::const_iterator it = table.find(result.name);
+        if(it == table.end()) {
+            report << result.name << ": sem golden\n";
+            ++failures;
+            continue;
+        }
+
+        const GoldenResult& golden = it->second;
+        bool same = true;
+        if(result.frameHash != golden.frameHash) {
+            report << result.name << ": tela " << std::hex << result.frameHash << " != "
+                   << golden.frameHash << std::dec << "\n";
+            same = false;
+        }
+        if(result.stateHash != golden.stateHash) {
+            report << result.name << ": estado " << std::hex << result.stateHash << " != "
+                   << golden.stateHash << std::dec << "\n";
+            same = false;
+        }
+        if(result.trap != golden.trap) {
+            report << result.name << ": trap " << trapName(result.trap) << " != "
+                   << trapName(golden.trap) << "\n";
+            same = false;
+        }
+        if(!same) ++failures;
+    }
+    out = report.str();
+    return failures;
+}
+
+std::string GoldenSuite::renderFrame(const Display& display) {
+    std::string text;
+    const uint8_t* pixels = display.getPixels();
+    for(size_t y = 0; y < Display::getHeight(); ++y) {
+        for(size_t x = 0; x < Display::getWidth(); ++x) {
+            text += pixels[y * Display::getWidth() + x] ? '#' : '.';
+        }
+        text += '\n';
+    }
+    return text;
+}
@@ -0,0 +1,129 @@
+// ============================================================================
+// HeadlessRunner.cpp - Script de entrada e dump do estado final
+// ============================================================================
+#include "HeadlessRunner.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+const size_t MEMORY_SIZE = 4096;
+
+} // namespace
+
+const char* HeadlessRunner::exitName(RunnerExit exit) {
+    switch(exit) {
+        case RunnerExit::Frames: return "frames";
+        case RunnerExit::Cycles: return "cycles";
+        case RunnerExit::Pc: return "pc";
+        case RunnerExit::Halt: return "halt";
+        case RunnerExit::Memory: return "memory";
+        case RunnerExit::FrameHash: return "frame-hash";
+        case RunnerExit::Trap: return "trap";
+    }
+    return "unknown";
+}
+
+bool HeadlessRunner::parseInputScript(std::istream& in, std::vector<RunnerKeyEvent>& events) {
+    std::string line;
+    size_t number = 0;
+    while(std::getline(in, line)) {
+        ++number;
+        size_t comment = line.find('#');
+        if(comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        std::string frame, key, action, extra;
+        if(!(fields >> frame)) continue;     // Linha vazia
+
+        char* end = nullptr;
+        RunnerKeyEvent event;
+        event.frame = std::strtoull(frame.c_str(), &end, 10);
+        bool valid = *end == '\0' && frame[0] != '-' && (fields >> key >> action) && !(fields >> extra);
+        if(valid) {
+            unsigned long value = std::strtoul(key.c_str(), &end, 16);
+            valid = *end == '\0' && value < 16 && (action == "down" || action == "up");
+            event.key = static_cast<uint8_t>(value);
+            event.pressed = action == "down";
+        }
+        if(!valid) {
+            std::cerr << "Script de entrada inválido na linha " << number << ": " << line << std::endl;
+            return false;
+        }
+        events.push_back(event);
+    }
+
+    // Estável: eventos do mesmo frame mantêm a ordem do arquivo
+    std::stable_sort(events.begin(), events.end(),
+                     [](const RunnerKeyEvent& a, const RunnerKeyEvent& b) { return a.frame < b.frame; });
+    return true;
+}
+
+bool HeadlessRunner::loadInputScript(const std::string& path, std::vector<RunnerKeyEvent>& events) {
+    std::ifstream file(path);
+    if(!file.is_open()) {
+        std::cerr << "Erro ao abrir script de entrada: " << path << std::endl;
+        return false;
+    }
+    return parseInputScript(file, events);
+}
+
+void HeadlessRunner::dumpJson(const Chip8& machine, const RunnerResult& result, std::ostream& out) {
+    const Registers& registers = machine.getRegisters();
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx",
+                  static_cast<unsigned long long>(frameHash(machine.getDisplay())));
+
+    out << "{\n";
+    out << "  \"exit\": \"" << exitName(result.exit) << "\",\n";
+    out << "  \"frames\": " << result.frames << ",\n";
+    out << "  \"cycles\": " << result.cycles << ",\n";
+    out << "  \"trap\": " << static_cast<unsigned>(registers.getTrap()) << ",\n";
+    out << "  \"pc\": " << registers.getPC() << ",\n";
+    out << "  \"i\": " << registers.getI() << ",\n";
+    out << "  \"sp\": " << static_cast<unsigned>(registers.getSP()) << ",\n";
+    out << "  \"dt\": " << static_cast<unsigned>(registers.getDelayTimer()) << ",\n";
+    out << "  \"st\": " << static_cast<unsigned>(registers.getSoundTimer()) << ",\n";
+
+    out << "  \"v\": [";
+    for(uint8_t i = 0; i < 16; ++i) {
+        out << (i ? ", " : "") << static_cast<unsigned>(registers.getV(i));
+    }
+    out << "],\n";
+
+    out << "  \"stack\": [";
+    for(uint8_t level = 0; level < registers.getSP(); ++level) {
+        out << (level ? ", " : "") << registers.getStackEntry(level);
+    }
+    out << "],\n";
+
+    out << "  \"keys\": " << machine.getInput().getKeyMask() << ",\n";
+    out << "  \"frameHash\": \"" << hash << "\",\n";
+
+    // Uma string de '0'/'1' por linha da tela
+    const uint8_t* pixels = machine.getDisplay().getPixels();
+    size_t width = Display::getWidth();
+    size_t height = Display::getHeight();
+    out << "  \"display\": [\n";
+    for(size_t y = 0; y < height; ++y) {
+        out << "    \"";
+        for(size_t x = 0; x < width; ++x) out << (pixels[y * width + x] ? '1' : '0');
+        out << (y + 1 < height ? "\",\n" : "\"\n");
+    }
+    out << "  ],\n";
+
+    static const char HEX[] = "0123456789abcdef";
+    const uint8_t* memory = machine.getMemory().getPointer(0, MEMORY_SIZE);
+    std::string text(MEMORY_SIZE * 2, '0');
+    for(size_t i = 0; i < MEMORY_SIZE; ++i) {
+        text[2 * i] = HEX[memory[i] >> 4];
+        text[2 * i + 1] = HEX[memory[i] & 0xF];
+    }
+    out << "  \"memory\": \"" << text << "\"\n";
+    out << "}\n";
+}
@@ -1,7 +1,10 @@
 // ============================================================================
 // InstructionSet.cpp - Implementação das instruções
 // ============================================================================
-#include <iostream>
+#include "InstructionSet.h"
+
+#include "Input.h"
+#include "Opcode.h"
 
 void InstructionSet::execute(const Opcode& op) {
     switch(op.full & 0xF000) {
@@ -10,8 +13,8 @@ void InstructionSet::execute(const Opcode& op) {
             registers.setPC(op.nnn);
             break;
         case 0x2000: // 2NNN - CALL addr
-            registers.pushStack(registers.getPC());
-            registers.setPC(op.nnn);
+            if(registers.pushStack(registers.getPC()))
+                registers.setPC(op.nnn);
             break;
         case 0x3000: // 3XNN - SE Vx, byte
             if(registers.getV(op.x) == op.nn)
@@ -54,7 +57,7 @@ void InstructionSet::execute(const Opcode& op) {
             registers.setPC(op.nnn + registers.getV(0));
             break;
         case 0xC000: // CXNN - RND Vx, byte
-            registers.setV(op.x, randByte(rng) & op.nn);
+            registers.setV(op.x, randomByte() & op.nn);
             registers.incrementPC();
             break;
         case 0xD000: { // DXYN - DRW Vx, Vy, N
@@ -62,9 +65,12 @@ void InstructionSet::execute(const Opcode& op) {
             uint8_t y = registers.getV(op.y);
             uint16_t addr = registers.getI();
             
-            uint8_t sprite[15];
-            for(int i = 0; i < op.n; ++i) {
-                sprite[i] = memory.read(addr + i);
+            // Sem wrap, o sprite é lido direto da memória
+            uint8_t buffer[15];
+            const uint8_t* sprite = memory.getPointer(addr, op.n);
+            if(!sprite) {
+                memory.readSpan(addr, buffer, op.n);
+                sprite = buffer;
             }
             
             bool collision = display.drawSprite(x, y, sprite, op.n);
@@ -75,21 +81,31 @@ void InstructionSet::execute(const Opcode& op) {
         case 0xE000: executeExxx(op); break;
         case 0xF000: executeFxxx(op); break;
         default:
-            std::cerr << "Opcode desconhecido: 0x" << std::hex << op.full << std::endl;
-            registers.incrementPC();
+            invalidOpcode();
     }
 }
 
+// Sem efeito e com o PC parado no opcode, como toda instrução que gera
+// trap. O opcode de guarda de Memory::fetchOpcode indica PC fora da memória.
+void InstructionSet::invalidOpcode() {
+    bool outside = registers.getPC() > Memory::getLastInstruction();
+    registers.raiseTrap(outside ? Trap::PcOutOfRange : Trap::InvalidOpcode);
+}
+
 void InstructionSet::execute0xxx(const Opcode& op) {
     switch(op.nn) {
         case 0xE0: // 00E0 - CLS
             display.clear();
             registers.incrementPC();
             break;
-        case 0xEE: // 00EE - RET
-            registers.setPC(registers.popStack());
-            registers.incrementPC();
+        case 0xEE: { // 00EE - RET
+            uint16_t address;
+            if(registers.popStack(address)) {
+                registers.setPC(address);
+                registers.incrementPC();
+            }
             break;
+        }
         default:
             registers.incrementPC();
     }
@@ -126,6 +142,9 @@ void InstructionSet::execute8xxx(const Opcode& op) {
             registers.setV(0xF, (vx & 0x80) >> 7);
             registers.setV(op.x, vx << 1);
             break;
+        default:
+            invalidOpcode();
+            return;
     }
     registers.incrementPC();
 }
@@ -147,7 +166,7 @@ void InstructionSet::executeExxx(const Opcode& op) {
                 registers.incrementPC();
             break;
         default:
-            registers.incrementPC();
+            invalidOpcode();
     }
 }
 
@@ -183,26 +202,33 @@ void InstructionSet::executeFxxx(const Opcode& op) {
             break;
         case 0x33: {
             uint8_t val = registers.getV(op.x);
-            uint16_t addr = registers.getI();
-            memory.write(addr, val / 100);
-            memory.write(addr + 1, (val / 10) % 10);
-            memory.write(addr + 2, val % 10);
+            uint8_t bcd[3] = {
+                static_cast<uint8_t>(val / 100),
+                static_cast<uint8_t>((val / 10) % 10),
+                static_cast<uint8_t>(val % 10)
+            };
+            memory.writeSpan(registers.getI(), bcd, 3);
             registers.incrementPC();
             break;
         }
         case 0x55:
-            for(int i = 0; i <= op.x; ++i) {
-                memory.write(registers.getI() + i, registers.getV(i));
-            }
+            memory.writeSpan(registers.getI(), registers.getVData(), op.x + 1);
             registers.incrementPC();
             break;
-        case 0x65:
-            for(int i = 0; i <= op.x; ++i) {
-                registers.setV(i, memory.read(registers.getI() + i));
+        case 0x65: {
+            uint16_t addr = registers.getI();
+            const uint8_t* src = memory.getPointer(addr, op.x + 1);
+            if(src) {
+                registers.loadV(src, op.x + 1);
+            } else {
+                uint8_t values[16];
+                memory.readSpan(addr, values, op.x + 1);
+                registers.loadV(values, op.x + 1);
             }
             registers.incrementPC();
             break;
+        }
         default:
-            registers.incrementPC();
+            invalidOpcode();
     }
 }
@@ -0,0 +1,331 @@
+// ============================================================================
+// InstructionTrace.cpp - Arquivos de trace, desmontagem e diff
+// ============================================================================
+#include "InstructionTrace.h"
+
+#include <cerrno>
+#include <deque>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define CHIP8_TRACE_MMAP 1
+#endif
+
+constexpr uint8_t InstructionRecord::REG_I;
+constexpr uint8_t InstructionRecord::REG_SP;
+constexpr uint8_t InstructionRecord::REG_DT;
+constexpr uint8_t InstructionRecord::REG_ST;
+constexpr uint8_t InstructionRecord::NO_REGISTER;
+constexpr uint8_t InstructionRecord::MEMORY_WRITTEN;
+constexpr size_t TraceWriter::BUFFER_RECORDS;
+constexpr uint64_t TraceWriter::MAX_RING_RECORDS;
+
+namespace {
+
+const char TRACE_MAGIC[8] = {'C', '8', 'T', 'R', 'A', 'C', 'E', '1'};
+
+TraceFileHeader makeHeader(uint64_t capacity) {
+    TraceFileHeader header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.recordSize = sizeof(InstructionRecord);
+    header.reserved = 0;
+    header.capacity = capacity;
+    header.total = 0;
+    return header;
+}
+
+} // namespace
+
+// ============================================================================
+// Gravação
+// ============================================================================
+
+bool TraceWriter::open(const std::string& path, uint64_t ringCapacity) {
+    close();
+    total = 0;
+
+    if(ringCapacity == 0) {
+        file = std::fopen(path.c_str(), "wb");
+        if(!file) {
+            std::cerr << "Erro ao criar trace: " << path << std::endl;
+            return false;
+        }
+        TraceFileHeader header = makeHeader(0);
+        if(std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            std::cerr << "Erro ao gravar trace: " << path << std::endl;
+            close();
+            return false;
+        }
+        buffer.resize(BUFFER_RECORDS);
+        buffered = 0;
+        return true;
+    }
+
+    // Acima disso o arredondamento não termina ou o tamanho do arquivo
+    // estoura size_t
+    if(ringCapacity > MAX_RING_RECORDS ||
+       ringCapacity > (SIZE_MAX - sizeof(TraceFileHeader)) / sizeof(InstructionRecord)) {
+        std::cerr << "Anel de trace grande demais: " << ringCapacity << " registros (máximo "
+                  << MAX_RING_RECORDS << ")" << std::endl;
+        return false;
+    }
+
+#ifdef CHIP8_TRACE_MMAP
+    uint64_t capacity = 1;
+    while(capacity < ringCapacity) capacity <<= 1;
+    size_t size = sizeof(TraceFileHeader) + capacity * sizeof(InstructionRecord);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        std::cerr << "Erro ao criar trace: " << path << ": " << std::strerror(errno) << std::endl;
+        if(fd >= 0) ::close(fd);
+        return false;
+    }
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);        // O mapeamento mantém o arquivo
+    if(base == MAP_FAILED) {
+        std::cerr << "Erro ao mapear trace: " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    mapping = base;
+    mappingSize = size;
+    mappedHeader = static_cast<TraceFileHeader*>(base);
+    *mappedHeader = makeHeader(capacity);
+    ring = reinterpret_cast<InstructionRecord*>(mappedHeader + 1);
+    ringMask = capacity - 1;
+    return true;
+#else
+    std::cerr << "Trace em anel requer mmap (POSIX): " << path << std::endl;
+    return false;
+#endif
+}
+
+// No arquivo linear: grava o bloco pendente e o total do cabeçalho
+bool TraceWriter::flush() {
+    if(!file) return true;
+
+    bool ok = buffered == 0 || std::fwrite(buffer.data(), sizeof(InstructionRecord), buffered, file) == buffered;
+    buffered = 0;
+
+    long end = std::ftell(file);
+    ok = ok && std::fseek(file, offsetof(TraceFileHeader, total), SEEK_SET) == 0 &&
+         std::fwrite(&total, sizeof(total), 1, file) == 1 &&
+         std::fseek(file, end, SEEK_SET) == 0 && std::fflush(file) == 0;
+    if(!ok) std::cerr << "Erro ao gravar trace" << std::endl;
+    return ok;
+}
+
+bool TraceWriter::close() {
+    bool ok = true;
+    if(file) {
+        ok = flush();
+        ok = std::fclose(file) == 0 && ok;
+        file = nullptr;
+    }
+#ifdef CHIP8_TRACE_MMAP
+    if(mapping) {
+        ::munmap(mapping, mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    mappedHeader = nullptr;
+    ring = nullptr;
+    return ok;
+}
+
+// ============================================================================
+// Leitura
+// ============================================================================
+
+bool TraceReader::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "rb");
+    if(!file) {
+        std::cerr << "Erro ao abrir trace: " << path << std::endl;
+        return false;
+    }
+
+    if(std::fread(&header, sizeof(header), 1, file) != 1 ||
+       std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+       header.recordSize != sizeof(InstructionRecord)) {
+        std::cerr << "Arquivo de trace inválido: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if(header.capacity) {
+        count = header.total < header.capacity ? header.total : header.capacity;
+    } else {
+        // Linear: o tamanho do arquivo vale mais que um total não atualizado
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        count = (static_cast<uint64_t>(size) - sizeof(header)) / sizeof(InstructionRecord);
+        header.total = count;
+    }
+    position = 0;
+    return seekSlot(0);
+}
+
+void TraceReader::close() {
+    if(file) std::fclose(file);
+    file = nullptr;
+    count = 0;
+    position = 0;
+}
+
+// Posiciona o arquivo no index-ésimo registro retido
+bool TraceReader::seekSlot(uint64_t index) {
+    uint64_t slot = index;
+    if(header.capacity) {
+        uint64_t oldest = header.total > header.capacity ? header.total % header.capacity : 0;
+        slot = (oldest + index) % header.capacity;
+    }
+    return std::fseek(file, static_cast<long>(sizeof(header) + slot * sizeof(InstructionRecord)),
+                      SEEK_SET) == 0;
+}
+
+bool TraceReader::next(InstructionRecord& record) {
+    if(!file || position >= count) return false;
+    // No anel, o registro mais novo pode estar antes do mais antigo
+    if(header.capacity && position > 0 && (header.total - count + position) % header.capacity == 0) {
+        if(!seekSlot(position)) return false;
+    }
+    if(std::fread(&record, sizeof(record), 1, file) != 1) return false;
+    ++position;
+    return true;
+}
+
+// ============================================================================
+// Decodificação
+// ============================================================================
+
+namespace InstructionTrace {
+
+std::string disassemble(uint16_t opcode) {
+    char text[32];
+    unsigned x = (opcode >> 8) & 0xF;
+    unsigned y = (opcode >> 4) & 0xF;
+    unsigned n = opcode & 0xF;
+    unsigned nn = opcode & 0xFF;
+    unsigned nnn = opcode & 0xFFF;
+
+    static const char* const ALU[16] = {
+        "LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", nullptr,
+        nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "SHL", nullptr
+    };
+
+    switch(opcode >> 12) {
+        case 0x0:
+            if(opcode == 0x00E0) return "CLS";
+            if(opcode == 0x00EE) return "RET";
+            std::snprintf(text, sizeof(text), "SYS 0x%03X", nnn);
+            return text;
+        case 0x1: std::snprintf(text, sizeof(text), "JP 0x%03X", nnn); return text;
+        case 0x2: std::snprintf(text, sizeof(text), "CALL 0x%03X", nnn); return text;
+        case 0x3: std::snprintf(text, sizeof(text), "SE V%X, 0x%02X", x, nn); return text;
+        case 0x4: std::snprintf(text, sizeof(text), "SNE V%X, 0x%02X", x, nn); return text;
+        case 0x5:
+            if(n != 0) break;
+            std::snprintf(text, sizeof(text), "SE V%X, V%X", x, y);
+            return text;
+        case 0x6: std::snprintf(text, sizeof(text), "LD V%X, 0x%02X", x, nn); return text;
+        case 0x7: std::snprintf(text, sizeof(text), "ADD V%X, 0x%02X", x, nn); return text;
+        case 0x8:
+            if(n == 0x7) {
+                std::snprintf(text, sizeof(text), "SUBN V%X, V%X", x, y);
+                return text;
+            }
+            if(!ALU[n]) break;
+            std::snprintf(text, sizeof(text), "%s V%X, V%X", ALU[n], x, y);
+            return text;
+        case 0x9:
+            if(n != 0) break;
+            std::snprintf(text, sizeof(text), "SNE V%X, V%X", x, y);
+            return text;
+        case 0xA: std::snprintf(text, sizeof(text), "LD I, 0x%03X", nnn); return text;
+        case 0xB: std::snprintf(text, sizeof(text), "JP V0, 0x%03X", nnn); return text;
+        case 0xC: std::snprintf(text, sizeof(text), "RND V%X, 0x%02X", x, nn); return text;
+        case 0xD: std::snprintf(text, sizeof(text), "DRW V%X, V%X, %u", x, y, n); return text;
+        case 0xE:
+            if(nn == 0x9E) { std::snprintf(text, sizeof(text), "SKP V%X", x); return text; }
+            if(nn == 0xA1) { std::snprintf(text, sizeof(text), "SKNP V%X", x); return text; }
+            break;
+        case 0xF: {
+            const char* format = nullptr;
+            switch(nn) {
+                case 0x07: format = "LD V%X, DT"; break;
+                case 0x0A: format = "LD V%X, K"; break;
+                case 0x15: format = "LD DT, V%X"; break;
+                case 0x18: format = "LD ST, V%X"; break;
+                case 0x1E: format = "ADD I, V%X"; break;
+                case 0x29: format = "LD F, V%X"; break;
+                case 0x33: format = "LD B, V%X"; break;
+                case 0x55: format = "LD [I], V%X"; break;
+                case 0x65: format = "LD V%X, [I]"; break;
+            }
+            if(!format) break;
+            std::snprintf(text, sizeof(text), format, x);
+            return text;
+        }
+    }
+    std::snprintf(text, sizeof(text), "DW 0x%04X", opcode);
+    return text;
+}
+
+void formatRecord(std::ostream& out, const InstructionRecord& record) {
+    char field[64];
+    std::snprintf(field, sizeof(field), "%12llu  %03X  %04X  %-16s",
+                  static_cast<unsigned long long>(record.getCycle()), record.pc, record.opcode,
+                  disassemble(record.opcode).c_str());
+    std::string line = field;
+
+    uint8_t reg = record.getRegister();
+    if(reg < 16) {
+        std::snprintf(field, sizeof(field), "  V%X=%02X", reg, record.value);
+        line += field;
+    } else if(reg != InstructionRecord::NO_REGISTER) {
+        static const char* const NAMES[] = {"I", "SP", "DT", "ST"};
+        std::snprintf(field, sizeof(field), "  %s=%0*X", NAMES[reg - InstructionRecord::REG_I],
+                      reg == InstructionRecord::REG_I ? 3 : 2, record.value);
+        line += field;
+    }
+    if(record.wroteMemory()) {
+        std::snprintf(field, sizeof(field), "  [%03X+%u]=%02X", record.getMemoryAddress(),
+                      static_cast<unsigned>(record.getMemoryCount()), record.memoryValue);
+        line += field;
+    }
+    line.erase(line.find_last_not_of(' ') + 1);
+    out << line << "\n";
+}
+
+bool diff(TraceReader& first, TraceReader& second, TraceDivergence& divergence, size_t contextRecords) {
+    std::deque<InstructionRecord> context;
+    InstructionRecord a, b;
+    for(uint64_t index = 0;; ++index) {
+        bool hasA = first.next(a);
+        bool hasB = second.next(b);
+        if(!hasA && !hasB) return true;
+
+        if(!hasA || !hasB || a != b) {
+            divergence.index = index;
+            divergence.endOfFirst = !hasA;
+            divergence.endOfSecond = !hasB;
+            if(hasA) divergence.first = a;
+            if(hasB) divergence.second = b;
+            divergence.context.assign(context.begin(), context.end());
+            return false;
+        }
+
+        if(contextRecords) {
+            if(context.size() == contextRecords) context.pop_front();
+            context.push_back(a);
+        }
+    }
+}
+
+} // namespace InstructionTrace
@@ -0,0 +1,270 @@
+// ============================================================================
+// Lockstep.cpp - Execução diferencial entre motores de execução
+// ============================================================================
+#include "Lockstep.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+
+const size_t WIDTH = Display::getWidth();
+const size_t HEIGHT = Display::getHeight();
+const uint16_t MEMORY_SIZE = 4096;
+
+std::string hex(unsigned value, int digits) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%0*X", digits, value);
+    return text;
+}
+
+bool eventBefore(const KeyEvent& a, const KeyEvent& b) {
+    return a.timestamp < b.timestamp;
+}
+
+} // namespace
+
+void LockstepHarness::setInputScript(const std::vector<KeyEvent>& events) {
+    script = events;
+    std::stable_sort(script.begin(), script.end(), eventBefore);
+}
+
+uint16_t LockstepHarness::keyMaskAtFrame(uint64_t frame) const {
+    uint16_t mask = 0;
+    for(size_t i = 0; i < script.size() && script[i].timestamp <= frame; ++i) {
+        uint16_t bit = static_cast<uint16_t>(1u << (script[i].key & 0xF));
+        if(script[i].pressed) {
+            mask |= bit;
+        } else {
+            mask &= ~bit;
+        }
+    }
+    return mask;
+}
+
+// Executa count instruções a partir da posição global position, respeitando
+// as fronteiras de frame: teclas no início, timers no fim
+void LockstepHarness::advance(ExecutionEngine& engine, uint64_t position, uint64_t count) const {
+    const uint32_t perFrame = options.cyclesPerFrame ? options.cyclesPerFrame : 1;
+
+    while(count > 0) {
+        uint64_t offset = position % perFrame;
+        if(offset == 0) {
+            engine.setKeyMask(keyMaskAtFrame(position / perFrame));
+        }
+
+        uint64_t chunk = std::min<uint64_t>(count, perFrame - offset);
+        engine.execute(static_cast<uint32_t>(chunk));
+        position += chunk;
+        count -= chunk;
+
+        if(position % perFrame == 0) {
+            engine.tickTimers();
+        }
+    }
+}
+
+bool LockstepHarness::run(const uint8_t* rom, size_t size, LockstepResult& result) {
+    result.diverged = false;
+    result.instructions = 0;
+    result.pc = 0;
+    result.opcode = 0;
+    result.differences.clear();
+
+    if(!reference.start(rom, size, options.seed) || !candidate.start(rom, size, options.seed)) {
+        result.differences = "ROM rejeitada\n";
+        return false;
+    }
+
+    const uint32_t interval = options.checkInterval ? options.checkInterval : 1;
+    Chip8Snapshot referenceCheckpoint;
+    Chip8Snapshot candidateCheckpoint;
+    uint64_t position = 0;
+
+    reference.saveSnapshot(result.reference);
+    candidate.saveSnapshot(result.candidate);
+    std::string initial = compare(result.reference, result.candidate);
+    if(!initial.empty()) {
+        result.diverged = true;
+        result.differences = initial;
+        result.before = result.reference;
+        return false;
+    }
+
+    while(position < options.maxInstructions) {
+        reference.saveSnapshot(referenceCheckpoint);
+        candidate.saveSnapshot(candidateCheckpoint);
+
+        uint64_t count = std::min<uint64_t>(interval, options.maxInstructions - position);
+        advance(reference, position, count);
+        advance(candidate, position, count);
+
+        reference.saveSnapshot(result.reference);
+        candidate.saveSnapshot(result.candidate);
+        if(compare(result.reference, result.candidate).empty()) {
+            position += count;
+            continue;
+        }
+
+        // Busca binária: após low instruções os estados são iguais, após high não
+        uint64_t low = 0;
+        uint64_t high = count;
+        while(high - low > 1) {
+            uint64_t middle = low + (high - low) / 2;
+            reference.restoreSnapshot(referenceCheckpoint);
+            candidate.restoreSnapshot(candidateCheckpoint);
+            advance(reference, position, middle);
+            advance(candidate, position, middle);
+
+            reference.saveSnapshot(result.reference);
+            candidate.saveSnapshot(result.candidate);
+            if(compare(result.reference, result.candidate).empty()) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+
+        reference.restoreSnapshot(referenceCheckpoint);
+        candidate.restoreSnapshot(candidateCheckpoint);
+        advance(reference, position, low);
+        advance(candidate, position, low);
+        reference.saveSnapshot(result.before);
+
+        advance(reference, position + low, 1);
+        advance(candidate, position + low, 1);
+        reference.saveSnapshot(result.reference);
+        candidate.saveSnapshot(result.candidate);
+
+        const Memory& memory = result.before.memory;
+        result.diverged = true;
+        result.instructions = position + high;
+        result.pc = result.before.registers.getPC();
+        result.opcode = static_cast<uint16_t>((memory.read(result.pc) << 8) | memory.read(result.pc + 1));
+        result.differences = compare(result.reference, result.candidate);
+        return false;
+    }
+
+    result.instructions = position;
+    return true;
+}
+
+std::string LockstepHarness::compare(const Chip8Snapshot& a, const Chip8Snapshot& b) {
+    std::ostringstream out;
+    const Registers& ra = a.registers;
+    const Registers& rb = b.registers;
+
+    for(uint8_t i = 0; i < 16; ++i) {
+        if(ra.getV(i) != rb.getV(i)) {
+            out << "V" << hex(i, 1) << ": " << hex(ra.getV(i), 2) << " != " << hex(rb.getV(i), 2) << "\n";
+        }
+    }
+    if(ra.getI() != rb.getI()) {
+        out << "I: " << hex(ra.getI(), 4) << " != " << hex(rb.getI(), 4) << "\n";
+    }
+    if(ra.getPC() != rb.getPC()) {
+        out << "PC: " << hex(ra.getPC(), 4) << " != " << hex(rb.getPC(), 4) << "\n";
+    }
+    if(ra.getSP() != rb.getSP()) {
+        out << "SP: " << hex(ra.getSP(), 2) << " != " << hex(rb.getSP(), 2) << "\n";
+    }
+    for(uint8_t i = 0; i < ra.getSP() && i < 16; ++i) {
+        if(ra.getStackEntry(i) != rb.getStackEntry(i)) {
+            out << "stack[" << static_cast<int>(i) << "]: " << hex(ra.getStackEntry(i), 4)
+                << " != " << hex(rb.getStackEntry(i), 4) << "\n";
+        }
+    }
+    if(ra.getDelayTimer() != rb.getDelayTimer()) {
+        out << "DT: " << hex(ra.getDelayTimer(), 2) << " != " << hex(rb.getDelayTimer(), 2) << "\n";
+    }
+    if(ra.getSoundTimer() != rb.getSoundTimer()) {
+        out << "ST: " << hex(ra.getSoundTimer(), 2) << " != " << hex(rb.getSoundTimer(), 2) << "\n";
+    }
+    if(ra.getTrap() != rb.getTrap()) {
+        out << "trap: " << trapName(ra.getTrap()) << " != " << trapName(rb.getTrap()) << "\n";
+    }
+    if(a.keyMask != b.keyMask) {
+        out << "keys: " << hex(a.keyMask, 4) << " != " << hex(b.keyMask, 4) << "\n";
+    }
+
+    for(uint16_t addr = 0; addr < MEMORY_SIZE; ++addr) {
+        uint8_t va = a.memory.read(addr);
+        uint8_t vb = b.memory.read(addr);
+        if(va != vb) {
+            out << "mem[" << hex(addr, 3) << "]: " << hex(va, 2) << " != " << hex(vb, 2) << "\n";
+        }
+    }
+
+    const uint8_t* pa = a.display.getPixels();
+    const uint8_t* pb = b.display.getPixels();
+    for(size_t y = 0; y < HEIGHT; ++y) {
+        for(size_t x = 0; x < WIDTH; ++x) {
+            size_t index = y * WIDTH + x;
+            if((pa[index] != 0) != (pb[index] != 0)) {
+                out << "pixel(" << x << "," << y << "): " << (pa[index] != 0)
+                    << " != " << (pb[index] != 0) << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+void LockstepHarness::dumpState(std::ostream& out, const Chip8Snapshot& state) {
+    const Registers& r = state.registers;
+
+    for(uint8_t i = 0; i < 16; ++i) {
+        out << "V" << hex(i, 1) << "=" << hex(r.getV(i), 2) << (i % 8 == 7 ? "\n" : " ");
+    }
+    out << "I=" << hex(r.getI(), 4) << " PC=" << hex(r.getPC(), 4)
+        << " SP=" << hex(r.getSP(), 2) << " DT=" << hex(r.getDelayTimer(), 2)
+        << " ST=" << hex(r.getSoundTimer(), 2) << " keys=" << hex(state.keyMask, 4)
+        << " frame=" << state.frameCount << "\n";
+
+    out << "stack:";
+    for(uint8_t i = 0; i < r.getSP() && i < 16; ++i) {
+        out << " " << hex(r.getStackEntry(i), 4);
+    }
+    out << "\n";
+
+    const uint8_t* pixels = state.display.getPixels();
+    for(size_t y = 0; y < HEIGHT; ++y) {
+        for(size_t x = 0; x < WIDTH; ++x) {
+            out << (pixels[y * WIDTH + x] ? '#' : '.');
+        }
+        out << "\n";
+    }
+
+    for(uint16_t line = 0; line < MEMORY_SIZE; line += 16) {
+        bool empty = true;
+        for(uint16_t i = 0; i < 16; ++i) {
+            if(state.memory.read(line + i)) empty = false;
+        }
+        if(empty) continue;
+
+        out << hex(line, 3) << ":";
+        for(uint16_t i = 0; i < 16; ++i) {
+            out << " " << hex(state.memory.read(line + i), 2);
+        }
+        out << "\n";
+    }
+}
+
+void LockstepHarness::dumpResult(std::ostream& out, const LockstepResult& result,
+                                 const char* referenceName, const char* candidateName) {
+    if(!result.diverged) {
+        out << "Sem divergência em " << result.instructions << " instruções\n";
+        return;
+    }
+
+    out << "Divergência na instrução " << result.instructions
+        << " (PC=" << hex(result.pc, 4) << ", opcode " << hex(result.opcode, 4) << ")\n"
+        << "Diferenças (" << referenceName << " != " << candidateName << "):\n"
+        << result.differences
+        << "\n--- Estado anterior ---\n";
+    dumpState(out, result.before);
+    out << "\n--- " << referenceName << " ---\n";
+    dumpState(out, result.reference);
+    out << "\n--- " << candidateName << " ---\n";
+    dumpState(out, result.candidate);
+}
@@ -0,0 +1,125 @@
+// ============================================================================
+// PhosphorFilter.cpp - Laço de intensidade em SIMD
+// ============================================================================
+#include "PhosphorFilter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CHIP8_PHOSPHOR_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CHIP8_PHOSPHOR_NEON 1
+#endif
+
+namespace {
+
+const size_t LANES = 16;
+
+// Um pixel; os laços vetoriais dão exatamente o mesmo resultado
+inline void phosphorPixel(uint8_t pixel, uint8_t& previous, uint8_t& intensity, uint8_t& lit,
+                          const PhosphorOptions& options) {
+    unsigned target = pixel ? 255 : 0;
+    if(options.blend) target = (target + (previous ? 255 : 0) + 1) >> 1;
+    unsigned decayed = (static_cast<unsigned>(intensity) * options.decay) >> 8;
+    intensity = static_cast<uint8_t>(target > decayed ? target : decayed);
+    lit = intensity >= options.threshold ? 1 : 0;
+    previous = pixel;
+}
+
+// Processa os primeiros count - count % LANES pixels; retorna quantos
+size_t phosphorVector(const uint8_t* pixels, uint8_t* previous, uint8_t* intensity, uint8_t* lit,
+                      size_t count, const PhosphorOptions& options) {
+    size_t vectorCount = count - count % LANES;
+#if defined(CHIP8_PHOSPHOR_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i decay = _mm_set1_epi16(options.decay);
+    const __m128i threshold = _mm_set1_epi8(static_cast<char>(options.threshold));
+    for(size_t i = 0; i < vectorCount; i += LANES) {
+        __m128i now = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        __m128i before = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i));
+        __m128i level = _mm_loadu_si128(reinterpret_cast<const __m128i*>(intensity + i));
+
+        // 0/1 -> 0/255; média arredondada para cima com o anterior
+        __m128i target = _mm_sub_epi8(zero, now);
+        if(options.blend) target = _mm_avg_epu8(target, _mm_sub_epi8(zero, before));
+
+        __m128i low = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(level, zero), decay), 8);
+        __m128i high = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(level, zero), decay), 8);
+        level = _mm_max_epu8(target, _mm_packus_epi16(low, high));
+
+        __m128i on = _mm_cmpeq_epi8(_mm_max_epu8(level, threshold), level);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(intensity + i), level);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lit + i), _mm_and_si128(on, one));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(previous + i), now);
+    }
+    return vectorCount;
+#elif defined(CHIP8_PHOSPHOR_NEON)
+    const uint8x16_t zero = vdupq_n_u8(0);
+    const uint8x16_t one = vdupq_n_u8(1);
+    const uint8x8_t decay = vdup_n_u8(options.decay);
+    const uint8x16_t threshold = vdupq_n_u8(options.threshold);
+    for(size_t i = 0; i < vectorCount; i += LANES) {
+        uint8x16_t now = vld1q_u8(pixels + i);
+        uint8x16_t before = vld1q_u8(previous + i);
+        uint8x16_t level = vld1q_u8(intensity + i);
+
+        uint8x16_t target = vsubq_u8(zero, now);
+        if(options.blend) target = vrhaddq_u8(target, vsubq_u8(zero, before));
+
+        uint8x8_t low = vshrn_n_u16(vmull_u8(vget_low_u8(level), decay), 8);
+        uint8x8_t high = vshrn_n_u16(vmull_u8(vget_high_u8(level), decay), 8);
+        level = vmaxq_u8(target, vcombine_u8(low, high));
+
+        vst1q_u8(intensity + i, level);
+        vst1q_u8(lit + i, vandq_u8(vcgeq_u8(level, threshold), one));
+        vst1q_u8(previous + i, now);
+    }
+    return vectorCount;
+#else
+    (void)pixels; (void)previous; (void)intensity; (void)lit; (void)options; (void)vectorCount;
+    return 0;
+#endif
+}
+
+} // namespace
+
+PhosphorFilter::PhosphorFilter(const PhosphorOptions& opts, size_t w, size_t h)
+    : width(w), height(h), options(opts),
+      intensity(w * h), previous(w * h), lit(w * h) {
+    reset();
+}
+
+void PhosphorFilter::reset() {
+    std::fill(intensity.begin(), intensity.end(), 0);
+    std::fill(previous.begin(), previous.end(), 0);
+    std::fill(lit.begin(), lit.end(), 0);
+}
+
+const uint8_t* PhosphorFilter::process(const uint8_t* pixels) {
+    size_t count = intensity.size();
+    size_t done = phosphorVector(pixels, previous.data(), intensity.data(), lit.data(),
+                                 count, options);
+    for(size_t i = done; i < count; ++i) {
+        phosphorPixel(pixels[i], previous[i], intensity[i], lit[i], options);
+    }
+    return intensity.data();
+}
+
+// Cada linha é ampliada uma vez e copiada scale - 1 vezes
+void PhosphorFilter::upscale(unsigned scale, uint8_t* out) const {
+    size_t outWidth = width * scale;
+    for(size_t y = 0; y < height; ++y) {
+        uint8_t* row = out + y * scale * outWidth;
+        const uint8_t* source = intensity.data() + y * width;
+        for(size_t x = 0; x < width; ++x) {
+            std::memset(row + x * scale, source[x], scale);
+        }
+        for(unsigned copy = 1; copy < scale; ++copy) {
+            std::memcpy(row + copy * outWidth, row, outWidth);
+        }
+    }
+}
@@ -0,0 +1,469 @@
+// ============================================================================
+// Recompiler.cpp - Tradução estática de ROMs CHIP-8 para C++
+// ============================================================================
+#include "Recompiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+constexpr uint16_t Recompiler::PROGRAM_START;
+constexpr size_t Recompiler::MAX_BLOCK_INSTRUCTIONS;
+
+namespace {
+
+std::string hex(unsigned value, int digits) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "0x%0*X", digits, value);
+    return text;
+}
+
+bool isSkip(uint16_t op) {
+    switch(op & 0xF000) {
+        case 0x3000:
+        case 0x4000:
+        case 0x5000:
+        case 0x9000:
+            return true;
+        case 0xE000:
+            return (op & 0xFF) == 0x9E || (op & 0xFF) == 0xA1;
+        default:
+            return false;
+    }
+}
+
+// Opcodes que o interpretador trata como inválidos (trap)
+bool isInvalid(uint16_t op) {
+    switch(op & 0xF000) {
+        case 0x8000:
+            return (op & 0xF) > 0x7 && (op & 0xF) != 0xE;
+        case 0xE000:
+            return (op & 0xFF) != 0x9E && (op & 0xFF) != 0xA1;
+        case 0xF000:
+            switch(op & 0xFF) {
+                case 0x07: case 0x0A: case 0x15: case 0x18: case 0x1E:
+                case 0x29: case 0x33: case 0x55: case 0x65:
+                    return false;
+                default:
+                    return true;
+            }
+        default:
+            return false;
+    }
+}
+
+// Instruções que definem o próximo PC por conta própria e encerram o bloco
+bool isControl(uint16_t op) {
+    return (op & 0xF000) == 0x1000 || (op & 0xF000) == 0x2000 ||
+           (op & 0xF000) == 0xB000 || op == 0x00EE ||
+           (op & 0xF0FF) == 0xF00A || isSkip(op) || isInvalid(op);
+}
+
+const uint8_t VF = 0xF;
+
+// Carry, borrow, bit deslocado ou colisão em VF
+bool setsFlag(uint16_t op) {
+    if((op & 0xF000) == 0xD000) return true;
+    if((op & 0xF000) != 0x8000) return false;
+    uint8_t n = op & 0xF;
+    return (n >= 0x4 && n <= 0x7) || n == 0xE;
+}
+
+// FX33 e FX55 contam como leitura: podem devolver o controle no meio do
+// bloco (escrita em código), e FX55 com X = F grava VF na memória
+bool readsVF(uint16_t op) {
+    uint8_t x = (op >> 8) & 0xF;
+    uint8_t y = (op >> 4) & 0xF;
+    switch(op & 0xF000) {
+        case 0x3000:
+        case 0x4000:
+        case 0x7000:
+        case 0xE000:
+            return x == VF;
+        case 0x5000:
+        case 0x9000:
+        case 0xD000:
+            return x == VF || y == VF;
+        case 0x8000:
+            return y == VF || (x == VF && (op & 0xF) != 0x0);
+        case 0xF000:
+            switch(op & 0xFF) {
+                case 0x33: case 0x55:
+                    return true;
+                case 0x15: case 0x18: case 0x1E: case 0x29:
+                    return x == VF;
+                default:
+                    return false;
+            }
+        default:
+            return false;
+    }
+}
+
+// Sobrescreve VF sempre. FX0A não conta: esperando tecla não escreve.
+bool writesVF(uint16_t op) {
+    if(isInvalid(op)) return false;
+    uint8_t x = (op >> 8) & 0xF;
+    switch(op & 0xF000) {
+        case 0x6000:
+        case 0x7000:
+        case 0xC000:
+            return x == VF;
+        case 0x8000:
+            return x == VF || setsFlag(op);
+        case 0xD000:
+            return true;
+        case 0xF000:
+            return x == VF && ((op & 0xFF) == 0x07 || (op & 0xFF) == 0x65);
+        default:
+            return false;
+    }
+}
+
+bool blockBefore(const RecompilerBlock& a, const RecompilerBlock& b) {
+    return a.start < b.start;
+}
+
+std::string blockName(uint16_t address) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "block_%03X", address);
+    return text;
+}
+
+} // namespace
+
+bool Recompiler::analyze(const uint8_t* data, size_t size) {
+    return analyze(data, size, std::vector<uint16_t>());
+}
+
+bool Recompiler::analyze(const uint8_t* data, size_t size, const std::vector<uint16_t>& roots) {
+    blocks.clear();
+    indirectJumps = 0;
+
+    if(size < 2 || size > 4096 - PROGRAM_START) return false;
+    rom.assign(data, data + size);
+
+    std::vector<uint8_t> queued(4096, 0);
+    std::vector<uint16_t> pending;
+    pending.push_back(PROGRAM_START);
+    queued[PROGRAM_START] = 1;
+    for(size_t i = 0; i < roots.size(); ++i) {
+        uint16_t root = roots[i] & 0xFFF;
+        if(!queued[root]) {
+            queued[root] = 1;
+            pending.push_back(root);
+        }
+    }
+
+    while(!pending.empty()) {
+        uint16_t start = pending.back();
+        pending.pop_back();
+        if(!inRom(start)) continue;
+
+        RecompilerBlock block;
+        block.start = start;
+        std::vector<uint16_t> targets;
+
+        uint16_t pc = start;
+        for(size_t count = 1; ; ++count) {
+            uint16_t op = fetch(pc);
+            uint16_t next = static_cast<uint16_t>(pc + 2);
+
+            if((op & 0xF000) == 0x1000) {
+                targets.push_back(op & 0x0FFF);
+            } else if((op & 0xF000) == 0x2000) {
+                targets.push_back(op & 0x0FFF);
+                targets.push_back(next);            // Volta do 00EE
+            } else if((op & 0xF000) == 0xB000) {
+                ++indirectJumps;
+            } else if(isSkip(op)) {
+                targets.push_back(next);
+                targets.push_back(static_cast<uint16_t>(pc + 4));
+            } else if((op & 0xF0FF) == 0xF00A) {
+                targets.push_back(pc);              // Ainda esperando tecla
+                targets.push_back(next);
+            } else if(op != 0x00EE && !isInvalid(op)) {
+                if(count < MAX_BLOCK_INSTRUCTIONS && inRom(next)) {
+                    pc = next;
+                    continue;
+                }
+                targets.push_back(next);
+            }
+
+            block.end = next;
+            break;
+        }
+
+        for(size_t i = 0; i < targets.size(); ++i) {
+            uint16_t target = targets[i];
+            if(!inRom(target)) continue;
+            block.successors.push_back(target);
+            if(!queued[target]) {
+                queued[target] = 1;
+                pending.push_back(target);
+            }
+        }
+        findDeadFlags(block);
+        blocks.push_back(block);
+    }
+
+    std::sort(blocks.begin(), blocks.end(), blockBefore);
+    return true;
+}
+
+void Recompiler::findDeadFlags(RecompilerBlock& block) const {
+    bool live = true;
+    for(uint16_t pc = block.end - 2; ; pc -= 2) {
+        uint16_t op = fetch(pc);
+
+        // Em 8FYn o resultado sobrescreve o próprio flag
+        bool flagDead = setsFlag(op) && (!live || ((op & 0xF000) == 0x8000 && ((op >> 8) & 0xF) == VF));
+        if(flagDead) block.deadFlags.push_back(pc);
+
+        live = readsVF(op) || (live && !writesVF(op));
+        if(pc == block.start) break;
+    }
+    std::reverse(block.deadFlags.begin(), block.deadFlags.end());
+}
+
+size_t Recompiler::getDeadFlagCount() const {
+    size_t count = 0;
+    for(size_t b = 0; b < blocks.size(); ++b) {
+        count += blocks[b].deadFlags.size();
+    }
+    return count;
+}
+
+void Recompiler::emitInstruction(std::ostream& out, uint16_t address, uint16_t op,
+                                 uint32_t executed, bool last, bool checkBudget, bool flagDead) const {
+    const std::string x = hex((op >> 8) & 0xF, 1);
+    const std::string y = hex((op >> 4) & 0xF, 1);
+    const std::string nn = hex(op & 0xFF, 2);
+    const std::string nnn = hex(op & 0xFFF, 3);
+    const std::string next = hex((address + 2) & 0xFFFF, 3);
+    const std::string skip = hex((address + 4) & 0xFFFF, 3);
+    const std::string early = "        r.setPC(" + next + ");\n        return " +
+                              std::to_string(executed) + ";\n";
+
+    out << "    // " << hex(address, 3) << ": " << hex(op, 4) << "\n";
+
+    // O interpretador registra o trap e deixa o PC no opcode
+    if(isInvalid(op)) {
+        out << "    r.setPC(" << hex(address, 3) << ");\n"
+            << "    ctx.instructions.execute(Opcode(" << hex(op, 4) << "));\n";
+        return;
+    }
+
+    switch(op & 0xF000) {
+        case 0x0000:
+            if(op == 0x00E0) {
+                out << "    ctx.display.clear();\n";
+            } else if(op == 0x00EE) {
+                out << "    {\n"
+                    << "        uint16_t ret;\n"
+                    << "        r.setPC(r.popStack(ret) ? static_cast<uint16_t>(ret + 2) : " << hex(address, 3) << ");\n"
+                    << "    }\n";
+            }
+            break;
+        case 0x1000:
+            out << "    r.setPC(" << nnn << ");\n";
+            break;
+        case 0x2000:
+            out << "    r.setPC(r.pushStack(" << hex(address, 3) << ") ? " << nnn << " : "
+                << hex(address, 3) << ");\n";
+            break;
+        case 0x3000:
+            out << "    r.setPC(r.getV(" << x << ") == " << nn << " ? " << skip << " : " << next << ");\n";
+            break;
+        case 0x4000:
+            out << "    r.setPC(r.getV(" << x << ") != " << nn << " ? " << skip << " : " << next << ");\n";
+            break;
+        case 0x5000:
+            out << "    r.setPC(r.getV(" << x << ") == r.getV(" << y << ") ? " << skip << " : " << next << ");\n";
+            break;
+        case 0x6000:
+            out << "    r.setV(" << x << ", " << nn << ");\n";
+            break;
+        case 0x7000:
+            out << "    r.setV(" << x << ", static_cast<uint8_t>(r.getV(" << x << ") + " << nn << "));\n";
+            break;
+        case 0x8000: {
+            if(flagDead) {
+                switch(op & 0xF) {
+                    case 0x4: out << "    r.setV(" << x << ", static_cast<uint8_t>(r.getV(" << x << ") + r.getV(" << y << ")));\n"; break;
+                    case 0x5: out << "    r.setV(" << x << ", static_cast<uint8_t>(r.getV(" << x << ") - r.getV(" << y << ")));\n"; break;
+                    case 0x6: out << "    r.setV(" << x << ", r.getV(" << x << ") >> 1);\n"; break;
+                    case 0x7: out << "    r.setV(" << x << ", static_cast<uint8_t>(r.getV(" << y << ") - r.getV(" << x << ")));\n"; break;
+                    case 0xE: out << "    r.setV(" << x << ", static_cast<uint8_t>(r.getV(" << x << ") << 1));\n"; break;
+                }
+                break;
+            }
+            const std::string loads = "        uint8_t vx = r.getV(" + x + ");\n"
+                                      "        uint8_t vy = r.getV(" + y + ");\n";
+            switch(op & 0xF) {
+                case 0x0: out << "    r.setV(" << x << ", r.getV(" << y << "));\n"; break;
+                case 0x1: out << "    r.setV(" << x << ", r.getV(" << x << ") | r.getV(" << y << "));\n"; break;
+                case 0x2: out << "    r.setV(" << x << ", r.getV(" << x << ") & r.getV(" << y << "));\n"; break;
+                case 0x3: out << "    r.setV(" << x << ", r.getV(" << x << ") ^ r.getV(" << y << "));\n"; break;
+                case 0x4:
+                    out << "    {\n" << loads
+                        << "        uint16_t sum = vx + vy;\n"
+                        << "        r.setV(0xF, sum > 255 ? 1 : 0);\n"
+                        << "        r.setV(" << x << ", sum & 0xFF);\n"
+                        << "    }\n";
+                    break;
+                case 0x5:
+                    out << "    {\n" << loads
+                        << "        r.setV(0xF, vx > vy ? 1 : 0);\n"
+                        << "        r.setV(" << x << ", static_cast<uint8_t>(vx - vy));\n"
+                        << "    }\n";
+                    break;
+                case 0x6:
+                    out << "    {\n"
+                        << "        uint8_t vx = r.getV(" << x << ");\n"
+                        << "        r.setV(0xF, vx & 0x1);\n"
+                        << "        r.setV(" << x << ", vx >> 1);\n"
+                        << "    }\n";
+                    break;
+                case 0x7:
+                    out << "    {\n" << loads
+                        << "        r.setV(0xF, vy > vx ? 1 : 0);\n"
+                        << "        r.setV(" << x << ", static_cast<uint8_t>(vy - vx));\n"
+                        << "    }\n";
+                    break;
+                case 0xE:
+                    out << "    {\n"
+                        << "        uint8_t vx = r.getV(" << x << ");\n"
+                        << "        r.setV(0xF, (vx & 0x80) >> 7);\n"
+                        << "        r.setV(" << x << ", static_cast<uint8_t>(vx << 1));\n"
+                        << "    }\n";
+                    break;
+            }
+            break;
+        }
+        case 0x9000:
+            out << "    r.setPC(r.getV(" << x << ") != r.getV(" << y << ") ? " << skip << " : " << next << ");\n";
+            break;
+        case 0xA000:
+            out << "    r.setI(" << nnn << ");\n";
+            break;
+        case 0xB000:
+            out << "    r.setPC(static_cast<uint16_t>(" << nnn << " + r.getV(0)));\n";
+            break;
+        case 0xC000:
+            out << "    r.setV(" << x << ", ctx.random() & " << nn << ");\n";
+            break;
+        case 0xD000:
+            out << "    ctx." << (flagDead ? "drawWithoutFlag(" : "draw(") << x << ", " << y << ", "
+                << (op & 0xF) << ");\n";
+            break;
+        case 0xE000:
+            if((op & 0xFF) == 0x9E) {
+                out << "    r.setPC(ctx.input.isKeyPressed(r.getV(" << x << ")) ? " << skip << " : " << next << ");\n";
+            } else if((op & 0xFF) == 0xA1) {
+                out << "    r.setPC(!ctx.input.isKeyPressed(r.getV(" << x << ")) ? " << skip << " : " << next << ");\n";
+            }
+            break;
+        case 0xF000:
+            switch(op & 0xFF) {
+                case 0x07: out << "    r.setV(" << x << ", r.getDelayTimer());\n"; break;
+                case 0x0A:
+                    out << "    {\n"
+                        << "        int key = ctx.input.getAnyKeyPressed();\n"
+                        << "        if(key >= 0) {\n"
+                        << "            r.setV(" << x << ", static_cast<uint8_t>(key));\n"
+                        << "            r.setPC(" << next << ");\n"
+                        << "        } else {\n"
+                        << "            r.setPC(" << hex(address, 3) << ");\n"
+                        << "        }\n"
+                        << "    }\n";
+                    break;
+                case 0x15: out << "    r.setDelayTimer(r.getV(" << x << "));\n"; break;
+                case 0x18: out << "    r.setSoundTimer(r.getV(" << x << "));\n"; break;
+                case 0x1E: out << "    r.addI(r.getV(" << x << "));\n"; break;
+                case 0x29: out << "    r.setI(r.getV(" << x << ") * 5);\n"; break;
+                case 0x33:
+                    // Se sobrescreveu código traduzido, o resto do bloco
+                    // pode estar obsoleto: devolve o controle
+                    out << "    if(ctx.storeBCD(" << x << ")) {\n" << early << "    }\n";
+                    break;
+                case 0x55:
+                    out << "    if(ctx.storeRegisters(" << x << ")) {\n" << early << "    }\n";
+                    break;
+                case 0x65: out << "    ctx.loadRegisters(" << x << ");\n"; break;
+            }
+            break;
+    }
+
+    if(isControl(op)) return;
+
+    if(last) {
+        out << "    r.setPC(" << next << ");\n";
+    } else if(checkBudget) {
+        out << "    if(budget == " << executed << ") {\n" << early << "    }\n";
+    }
+}
+
+void Recompiler::emit(std::ostream& out, const std::string& symbol, const std::string& source) const {
+    out << "// Gerado por recompile-rom a partir de " << source << ". Não editar.\n"
+        << "#include \"RecompiledEngine.h\"\n\n"
+        << "extern const RecompiledProgram " << symbol << ";\n\n"
+        << "namespace {\n\n"
+        << "const uint8_t ROM[] = {";
+
+    for(size_t i = 0; i < rom.size(); ++i) {
+        out << (i % 12 == 0 ? "\n    " : " ") << hex(rom[i], 2) << ",";
+    }
+    out << "\n};\n";
+
+    for(size_t b = 0; b < blocks.size(); ++b) {
+        const RecompilerBlock& block = blocks[b];
+        uint32_t length = (block.end - block.start) / 2;
+        const std::string name = blockName(block.start);
+
+        // Versão para o bloco inteiro: sem saídas por budget, VF só precisa
+        // estar certo no fim, então os flags mortos não são calculados
+        if(!block.deadFlags.empty()) {
+            out << "\n// Flags mortos:";
+            for(size_t i = 0; i < block.deadFlags.size(); ++i) {
+                out << " " << hex(block.deadFlags[i], 3);
+            }
+            out << "\nuint32_t " << name << "_full(RecompiledContext& ctx) {\n"
+                << "    Registers& r = ctx.registers;\n";
+
+            uint32_t executed = 0;
+            for(uint16_t pc = block.start; pc < block.end; pc += 2) {
+                ++executed;
+                bool flagDead = std::find(block.deadFlags.begin(), block.deadFlags.end(), pc) !=
+                                block.deadFlags.end();
+                emitInstruction(out, pc, fetch(pc), executed, executed == length, false, flagDead);
+            }
+            out << "    return " << length << ";\n}\n";
+        }
+
+        out << "\nuint32_t " << name << "(RecompiledContext& ctx, uint32_t budget) {\n";
+        if(!block.deadFlags.empty()) {
+            out << "    if(budget >= " << length << ") return " << name << "_full(ctx);\n";
+        } else if(length == 1) {
+            out << "    (void)budget;\n";
+        }
+        out << "    Registers& r = ctx.registers;\n";
+
+        uint32_t executed = 0;
+        for(uint16_t pc = block.start; pc < block.end; pc += 2) {
+            ++executed;
+            emitInstruction(out, pc, fetch(pc), executed, executed == length, true, false);
+        }
+        out << "    return " << length << ";\n}\n";
+    }
+
+    out << "\nconst RecompiledBlock BLOCKS[] = {\n";
+    for(size_t b = 0; b < blocks.size(); ++b) {
+        out << "    {" << hex(blocks[b].start, 3) << ", " << hex(blocks[b].end, 3) << ", "
+            << blockName(blocks[b].start) << "},\n";
+    }
+    out << "};\n\n"
+        << "} // namespace\n\n"
+        << "const RecompiledProgram " << symbol << " = {\n"
+        << "    \"" << symbol << "\", ROM, sizeof(ROM), BLOCKS, sizeof(BLOCKS) / sizeof(BLOCKS[0])\n"
+        << "};\n";
+}
@@ -0,0 +1,131 @@
+// ============================================================================
+// RomProfile.cpp - Persistência do perfil de execução por ROM
+// ============================================================================
+#include "RomProfile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+constexpr size_t RomProfile::ADDRESS_SPACE;
+
+namespace {
+
+struct HotEntry {
+    uint16_t address;
+    uint32_t count;
+};
+
+bool hotterFirst(const HotEntry& a, const HotEntry& b) {
+    return a.count != b.count ? a.count > b.count : a.address < b.address;
+}
+
+} // namespace
+
+std::string RomProfile::pathFor(const std::string& directory, uint64_t hash) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.profile", static_cast<unsigned long long>(hash));
+    if(directory.empty()) return name;
+    char last = directory[directory.size() - 1];
+    return directory + (last == '/' || last == '\\' ? "" : "/") + name;
+}
+
+bool RomProfile::empty() const {
+    for(size_t a = 0; a < ADDRESS_SPACE; ++a) {
+        if(entries[a] || indirect[a]) return false;
+    }
+    return true;
+}
+
+std::vector<uint16_t> RomProfile::translationRoots() const {
+    std::vector<uint16_t> roots;
+    std::vector<HotEntry> hot;
+    for(size_t a = 0; a < ADDRESS_SPACE; ++a) {
+        if(indirect[a]) {
+            roots.push_back(static_cast<uint16_t>(a));
+        } else if(entries[a]) {
+            HotEntry entry = {static_cast<uint16_t>(a), entries[a]};
+            hot.push_back(entry);
+        }
+    }
+
+    std::sort(hot.begin(), hot.end(), hotterFirst);
+    for(size_t i = 0; i < hot.size(); ++i) {
+        roots.push_back(hot[i].address);
+    }
+    return roots;
+}
+
+bool RomProfile::load(const std::string& path, uint64_t expectedHash) {
+    if(romHash != expectedHash) reset(expectedHash);
+
+    std::ifstream file(path.c_str());
+    if(!file.is_open()) return false;
+
+    std::vector<uint32_t> loadedEntries(ADDRESS_SPACE, 0);
+    std::vector<uint32_t> loadedIndirect(ADDRESS_SPACE, 0);
+    bool sameRom = false;
+
+    std::string line;
+    for(size_t number = 1; std::getline(file, line); ++number) {
+        if(line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if(kind == "rom") {
+            uint64_t hash = 0;
+            fields >> std::hex >> hash;
+            sameRom = !fields.fail() && hash == expectedHash;
+            if(!sameRom) {
+                std::cerr << "Perfil de outra ROM ignorado: " << path << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        unsigned address = 0;
+        unsigned long count = 0;
+        fields >> std::hex >> address >> std::dec >> count;
+        if(fields.fail() || !sameRom || address >= ADDRESS_SPACE ||
+           (kind != "entry" && kind != "indirect")) {
+            std::cerr << "Linha de perfil inválida em " << path << ":" << number << std::endl;
+            return false;
+        }
+        uint32_t clamped = count > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(count);
+        (kind == "entry" ? loadedEntries : loadedIndirect)[address] = clamped;
+    }
+
+    if(!sameRom) {
+        std::cerr << "Perfil sem hash de ROM: " << path << std::endl;
+        return false;
+    }
+
+    for(size_t a = 0; a < ADDRESS_SPACE; ++a) {
+        addEntry(static_cast<uint16_t>(a), loadedEntries[a]);
+        addIndirectTarget(static_cast<uint16_t>(a), loadedIndirect[a]);
+    }
+    return true;
+}
+
+bool RomProfile::save(const std::string& path) const {
+    std::ofstream file(path.c_str(), std::ios::trunc);
+    if(!file.is_open()) {
+        std::cerr << "Erro ao gravar perfil: " << path << std::endl;
+        return false;
+    }
+
+    char hash[24];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(romHash));
+    file << "# Perfil de execução: entradas de bloco e alvos de BNNN (endereço, contagem)\n";
+    file << "rom " << hash << "\n";
+    for(size_t a = 0; a < ADDRESS_SPACE; ++a) {
+        if(entries[a]) file << "entry " << std::hex << a << std::dec << " " << entries[a] << "\n";
+    }
+    for(size_t a = 0; a < ADDRESS_SPACE; ++a) {
+        if(indirect[a]) file << "indirect " << std::hex << a << std::dec << " " << indirect[a] << "\n";
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,623 @@
+// ============================================================================
+// SessionDaemon.cpp - Event loop epoll + pool de workers de emulação
+// ============================================================================
+#include "SessionDaemon.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+constexpr size_t SessionDaemon::BATCH_SESSIONS;
+
+namespace {
+
+// Valores de epoll_event.data.u64 que não são conexões
+const uint64_t LISTEN_TOKEN = 0;
+const uint64_t WAKE_TOKEN = 1;
+const uint64_t TIMER_TOKEN = 2;
+const uint64_t FIRST_CONNECTION_ID = 3;
+
+const size_t MAX_EVENTS = 64;
+const size_t READ_CHUNK = 16384;
+const size_t MAX_ROM_SIZE = 4096 - 0x200;
+
+} // namespace
+
+SessionDaemon::SessionDaemon(const DaemonOptions& opts)
+    : options(opts), listenFd(-1), epollFd(-1), wakeFd(-1), timerFd(-1), stopRequested(false),
+      frameClock(0), nextConnectionId(FIRST_CONNECTION_ID), nextSessionId(1), sessionCount(0),
+      framesSent(0), framesDropped(0), parkedCount(0), framesSkipped(0),
+      tickGeneration(0), tickEnd(0),
+      workersStopping(false), nextBatch(0), workersDone(0), tickInFlight(false) {
+    if(options.workerThreads == 0) {
+        options.workerThreads = std::thread::hardware_concurrency();
+        if(options.workerThreads == 0) options.workerThreads = 1;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(epollFd >= 0 && wakeFd >= 0 && timerFd >= 0) {
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = WAKE_TOKEN;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+        event.data.u64 = TIMER_TOKEN;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event);
+    }
+}
+
+SessionDaemon::~SessionDaemon() {
+    shutdown();
+    if(timerFd >= 0) ::close(timerFd);
+    if(wakeFd >= 0) ::close(wakeFd);
+    if(epollFd >= 0) ::close(epollFd);
+}
+
+bool SessionDaemon::listen(const std::string& path) {
+    if(epollFd < 0 || wakeFd < 0 || timerFd < 0) {
+        std::cerr << "Erro ao criar epoll/eventfd/timerfd: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Caminho de socket inválido: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+        std::cerr << "Erro ao criar socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    ::unlink(path.c_str());
+    if(bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+       ::listen(fd, SOMAXCONN) < 0) {
+        std::cerr << "Erro ao escutar em " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_TOKEN;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+
+    listenFd = fd;
+    socketPath = path;
+    return true;
+}
+
+void SessionDaemon::stop() {
+    stopRequested.store(true);
+    uint64_t one = 1;
+    if(wakeFd >= 0) {
+        ssize_t ignored = ::write(wakeFd, &one, sizeof(one));   // Seguro em handler de sinal
+        (void)ignored;
+    }
+}
+
+void SessionDaemon::run() {
+    typedef FramePacer::Clock Clock;
+
+    workersStopping = false;
+    for(size_t i = 0; i < options.workerThreads; ++i) {
+        workers.push_back(std::thread(&SessionDaemon::workerLoop, this));
+    }
+
+    FramePacer pacer(options.speed);
+    epoll_event events[MAX_EVENTS];
+
+    while(!stopRequested.load()) {
+        if(!tickInFlight) armTimer(pacer);
+
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if(count < 0 && errno != EINTR) {
+            std::cerr << "Erro em epoll_wait: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        for(int i = 0; i < count; ++i) {
+            uint64_t token = events[i].data.u64;
+            if(token == LISTEN_TOKEN) {
+                acceptClients();
+            } else if(token == WAKE_TOKEN) {
+                uint64_t value;
+                while(::read(wakeFd, &value, sizeof(value)) > 0) {}
+                if(tickInFlight && workersDone.load() == workers.size()) {
+                    finishTick();
+                }
+            } else if(token == TIMER_TOKEN) {
+                uint64_t expirations;
+                while(::read(timerFd, &expirations, sizeof(expirations)) > 0) {}
+            } else {
+                std::map<uint64_t, std::unique_ptr<Connection>>::iterator it = connections.find(token);
+                if(it == connections.end() || it->second->closed) continue;
+                Connection& connection = *it->second;
+
+                if(events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    readClient(connection);     // Lê o que chegou antes de fechar
+                    closeClient(connection);
+                    continue;
+                }
+                if(events[i].events & EPOLLIN) readClient(connection);
+                if(!connection.closed && (events[i].events & EPOLLOUT)) flushClient(connection);
+            }
+        }
+
+        if(tickInFlight) continue;
+
+        // Sem sessão rodando não há catch-up: o tempo dormido conta inteiro
+        // para as estacionadas
+        if(active.empty()) frameClock += pacer.skipIdle(Clock::now());
+
+        // Entre ticks: aplica as mensagens e descarta clientes fechados
+        for(std::map<uint64_t, std::unique_ptr<Connection>>::iterator it = connections.begin();
+            it != connections.end(); ++it) {
+            if(!it->second->closed) processMessages(*it->second);
+        }
+        reapClosed();
+
+        uint32_t due = pacer.framesDue(Clock::now());
+        if(due > 0) {
+            pacer.advance(due);
+            frameClock += due;
+            wakeTimers(frameClock);
+            if(!active.empty()) startTick(frameClock);
+        }
+    }
+
+    shutdown();
+}
+
+// ============================================================================
+// Emulação
+// ============================================================================
+
+void SessionDaemon::workerLoop() {
+    uint64_t seen = 0;
+    for(;;) {
+        uint64_t end;
+        {
+            std::unique_lock<std::mutex> lock(tickMutex);
+            tickStart.wait(lock, [&]() { return workersStopping || tickGeneration != seen; });
+            if(workersStopping) return;
+            seen = tickGeneration;
+            end = tickEnd;
+        }
+
+        for(;;) {
+            size_t first = nextBatch.fetch_add(BATCH_SESSIONS);
+            if(first >= active.size()) break;
+            size_t last = std::min(first + BATCH_SESSIONS, active.size());
+
+            for(size_t i = first; i < last; ++i) {
+                // Uma sessão que acabou de acordar pode dever frames
+                Session& session = *active[i];
+                while(session.nextFrame < end) {
+                    session.machine.runFrame(session.options);
+                    ++session.nextFrame;
+                    session.wait = session.machine.idleWait(session.options, session.idleFrames);
+                    if(session.wait != IdleWait::None) break;
+                }
+                if(session.machine.takeRedraw()) {
+                    FrameCodec::packPixels(session.machine.getDisplay().getPixels(), session.packed);
+                    session.redraw = true;
+                }
+            }
+        }
+
+        if(workersDone.fetch_add(1) + 1 == workers.size()) {
+            uint64_t one = 1;
+            ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+}
+
+void SessionDaemon::startTick(uint64_t end) {
+    nextBatch.store(0);
+    workersDone.store(0);
+    tickInFlight = true;
+    {
+        std::lock_guard<std::mutex> lock(tickMutex);
+        tickEnd = end;
+        ++tickGeneration;
+    }
+    tickStart.notify_all();
+}
+
+void SessionDaemon::finishTick() {
+    tickInFlight = false;
+
+    // Frames do tick agrupados por cliente: um write por cliente
+    for(size_t i = 0; i < active.size(); ++i) {
+        Session& session = *active[i];
+        bool trapped = !session.trapReported && session.machine.getTrap() != Trap::None;
+        if(!session.redraw && !trapped) continue;
+        bool redraw = session.redraw;
+        session.redraw = false;
+
+        std::map<uint64_t, std::unique_ptr<Connection>>::iterator it = connections.find(session.owner);
+        if(it == connections.end() || it->second->closed) continue;
+        Connection& connection = *it->second;
+
+        if(redraw) {
+            if(connection.output.size() - connection.outputOffset > options.maxPendingOutput) {
+                ++framesDropped;
+            } else {
+                DaemonProtocol::appendFrame(connection.output, session.id, session.machine.getFrameCount(),
+                                            session.encoder, session.packed);
+                ++framesSent;
+            }
+        }
+        // Não é descartado por back-pressure: sai uma vez por sessão
+        if(trapped) {
+            session.trapReported = true;
+            DaemonProtocol::appendTrap(connection.output, session.id,
+                                       static_cast<uint8_t>(session.machine.getTrap()),
+                                       session.machine.getRegisters().getPC());
+        }
+    }
+
+    for(std::map<uint64_t, std::unique_ptr<Connection>>::iterator it = connections.begin();
+        it != connections.end(); ++it) {
+        Connection& connection = *it->second;
+        if(!connection.closed && connection.output.size() > connection.outputOffset) {
+            flushClient(connection);
+        }
+    }
+
+    // Depois do Trap enviado: as sessões que o worker viu ociosas saem do tick
+    size_t kept = 0;
+    for(size_t i = 0; i < active.size(); ++i) {
+        if(active[i]->wait == IdleWait::None) {
+            active[kept++] = active[i];
+        } else {
+            park(*active[i]);
+        }
+    }
+    active.resize(kept);
+}
+
+// Próximo tick: o frame seguinte se há sessão rodando, senão o primeiro
+// despertar agendado; sem nenhum dos dois o timer fica desarmado
+void SessionDaemon::armTimer(const FramePacer& pacer) {
+    typedef FramePacer::Clock Clock;
+
+    itimerspec spec;
+    std::memset(&spec, 0, sizeof(spec));
+    if(!active.empty() || !timedWakes.empty()) {
+        Clock::time_point deadline = pacer.getNextFrameTime();
+        uint64_t first = active.empty() ? timedWakes.begin()->first : frameClock;
+        if(first > frameClock) deadline += pacer.getFramePeriod() * (first - frameClock);
+
+        std::chrono::nanoseconds since = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            deadline.time_since_epoch());
+        if(since.count() <= 0) since = std::chrono::nanoseconds(1);
+        spec.it_value.tv_sec = static_cast<time_t>(since.count() / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(since.count() % 1000000000);
+    }
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void SessionDaemon::park(Session& session) {
+    ++parkedCount;
+    if(session.wait == IdleWait::Timer) {
+        session.wakeFrame = session.nextFrame + session.idleFrames;
+        timedWakes.insert(std::make_pair(session.wakeFrame, &session));
+    }
+}
+
+// Pula os frames ociosos até frame (no máximo os que a espera garante) e
+// devolve a sessão ao tick; o worker roda o que faltar até o fim dele
+void SessionDaemon::wake(Session& session, uint64_t frame) {
+    forget(session);
+
+    uint64_t idle = frame > session.nextFrame ? frame - session.nextFrame : 0;
+    uint32_t skip = idle < session.idleFrames ? static_cast<uint32_t>(idle) : session.idleFrames;
+    session.machine.skipIdleFrames(skip, session.options);
+    session.nextFrame += skip;
+    framesSkipped += skip;
+
+    session.wait = IdleWait::None;
+    active.push_back(&session);
+}
+
+// Acorda as sessões cujo timer libera algum frame antes de end
+void SessionDaemon::wakeTimers(uint64_t end) {
+    while(!timedWakes.empty() && timedWakes.begin()->first < end) {
+        Session& session = *timedWakes.begin()->second;
+        wake(session, session.wakeFrame);
+    }
+}
+
+// ============================================================================
+// Clientes
+// ============================================================================
+
+void SessionDaemon::acceptClients() {
+    for(;;) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(fd < 0) {
+            if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Erro em accept: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->id = nextConnectionId++;
+        connection->fd = fd;
+        connection->closed = false;
+        connection->wantWrite = false;
+        connection->outputOffset = 0;
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = connection->id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        connections[connection->id] = std::move(connection);
+    }
+}
+
+void SessionDaemon::readClient(Connection& connection) {
+    uint8_t buffer[READ_CHUNK];
+    for(;;) {
+        ssize_t received = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+        if(received > 0) {
+            connection.input.insert(connection.input.end(), buffer, buffer + received);
+            continue;
+        }
+        if(received < 0 && errno == EINTR) continue;
+        if(received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        closeClient(connection);    // EOF ou erro
+        return;
+    }
+}
+
+void SessionDaemon::flushClient(Connection& connection) {
+    while(connection.outputOffset < connection.output.size()) {
+        ssize_t sent = ::send(connection.fd, &connection.output[connection.outputOffset],
+                              connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+        if(sent > 0) {
+            connection.outputOffset += sent;
+            continue;
+        }
+        if(sent < 0 && errno == EINTR) continue;
+        if(sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        closeClient(connection);
+        return;
+    }
+
+    if(connection.outputOffset == connection.output.size()) {
+        connection.output.clear();
+        connection.outputOffset = 0;
+    }
+    updateInterest(connection);
+}
+
+void SessionDaemon::updateInterest(Connection& connection) {
+    bool wantWrite = connection.outputOffset < connection.output.size();
+    if(wantWrite == connection.wantWrite) return;
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    if(wantWrite) event.events |= EPOLLOUT;
+    event.data.u64 = connection.id;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.wantWrite = wantWrite;
+}
+
+// O fd é fechado na hora; a conexão e suas sessões só somem entre ticks
+void SessionDaemon::closeClient(Connection& connection) {
+    if(connection.closed) return;
+    connection.closed = true;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+    ::close(connection.fd);
+    connection.fd = -1;
+}
+
+void SessionDaemon::processMessages(Connection& connection) {
+    size_t offset = 0;
+    while(!connection.closed) {
+        DaemonMessageView message;
+        long used = DaemonProtocol::parse(connection.input.data() + offset,
+                                          connection.input.size() - offset, message);
+        if(used == 0) break;
+        if(used < 0 || !handleMessage(connection, message)) {
+            DaemonProtocol::appendError(connection.output, "mensagem inválida");
+            flushClient(connection);
+            closeClient(connection);
+            break;
+        }
+        offset += used;
+    }
+    if(connection.closed) return;
+
+    connection.input.erase(connection.input.begin(), connection.input.begin() + offset);
+    if(connection.output.size() > connection.outputOffset) flushClient(connection);
+}
+
+// false = erro de protocolo (o cliente é desconectado)
+bool SessionDaemon::handleMessage(Connection& connection, const DaemonMessageView& message) {
+    switch(message.type) {
+        case DaemonMessage::Create: {
+            if(message.size < 4) return false;
+            size_t romSize = message.size - 4;
+            if(romSize == 0 || romSize > MAX_ROM_SIZE) {
+                DaemonProtocol::appendError(connection.output, "ROM vazia ou muito grande");
+                return true;
+            }
+            uint32_t cyclesPerFrame = DaemonProtocol::getU32(message.payload);
+            if(cyclesPerFrame == 0 || cyclesPerFrame > options.maxCyclesPerFrame) {
+                DaemonProtocol::appendError(connection.output, "ciclos por frame fora do limite");
+                return true;
+            }
+            if(sessions.size() >= options.maxSessions) {
+                DaemonProtocol::appendError(connection.output, "limite de sessões atingido");
+                return true;
+            }
+
+            std::unique_ptr<Session> session(new Session());
+            session->id = nextSessionId++;
+            session->owner = connection.id;
+            session->options.cyclesPerFrame = cyclesPerFrame;
+            session->redraw = false;
+            session->trapReported = false;
+            session->nextFrame = frameClock;
+            session->wait = IdleWait::None;
+            session->idleFrames = 0;
+            session->wakeFrame = 0;
+            session->machine.initialize();
+            session->machine.loadROM(message.payload + 4, romSize);
+
+            DaemonProtocol::appendSession(connection.output, DaemonMessage::Created, session->id);
+            sessions[session->id] = std::move(session);
+            rebuildActive();
+            return true;
+        }
+
+        case DaemonMessage::Key: {
+            if(message.size != 6) return false;
+            std::map<uint32_t, std::unique_ptr<Session>>::iterator it =
+                sessions.find(DaemonProtocol::getU32(message.payload));
+            if(it == sessions.end() || it->second->owner != connection.id) {
+                DaemonProtocol::appendError(connection.output, "sessão desconhecida");
+                return true;
+            }
+            // Aplicada no início do próximo frame da sessão. Só FX0A acorda:
+            // um laço de timer não lê teclas, e a tecla esperar na fila até
+            // ele acabar dá o mesmo estado
+            Session& session = *it->second;
+            session.machine.getInput().postKey(message.payload[4], message.payload[5] != 0);
+            if(session.wait == IdleWait::Key) wake(session, frameClock);
+            return true;
+        }
+
+        case DaemonMessage::Keyframe: {
+            if(message.size != 4) return false;
+            std::map<uint32_t, std::unique_ptr<Session>>::iterator it =
+                sessions.find(DaemonProtocol::getU32(message.payload));
+            if(it == sessions.end() || it->second->owner != connection.id) {
+                DaemonProtocol::appendError(connection.output, "sessão desconhecida");
+                return true;
+            }
+            it->second->encoder.requestKeyframe();
+            return true;
+        }
+
+        case DaemonMessage::Destroy: {
+            if(message.size != 4) return false;
+            uint32_t id = DaemonProtocol::getU32(message.payload);
+            std::map<uint32_t, std::unique_ptr<Session>>::iterator it = sessions.find(id);
+            if(it == sessions.end() || it->second->owner != connection.id) {
+                DaemonProtocol::appendError(connection.output, "sessão desconhecida");
+                return true;
+            }
+            forget(*it->second);
+            sessions.erase(it);
+            rebuildActive();
+            DaemonProtocol::appendSession(connection.output, DaemonMessage::Closed, id);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void SessionDaemon::reapClosed() {
+    bool removedSessions = false;
+    std::map<uint64_t, std::unique_ptr<Connection>>::iterator it = connections.begin();
+    while(it != connections.end()) {
+        if(!it->second->closed) {
+            ++it;
+            continue;
+        }
+
+        uint64_t owner = it->first;
+        std::map<uint32_t, std::unique_ptr<Session>>::iterator s = sessions.begin();
+        while(s != sessions.end()) {
+            if(s->second->owner == owner) {
+                forget(*s->second);
+                s = sessions.erase(s);
+                removedSessions = true;
+            } else {
+                ++s;
+            }
+        }
+        it = connections.erase(it);
+    }
+    if(removedSessions) rebuildActive();
+}
+
+// Tira uma sessão estacionada das estruturas de espera (ao acordar ou
+// antes de destruí-la)
+void SessionDaemon::forget(Session& session) {
+    if(session.wait == IdleWait::None) return;
+    if(session.wait == IdleWait::Timer) {
+        std::pair<std::multimap<uint64_t, Session*>::iterator,
+                  std::multimap<uint64_t, Session*>::iterator> range =
+            timedWakes.equal_range(session.wakeFrame);
+        for(std::multimap<uint64_t, Session*>::iterator it = range.first; it != range.second; ++it) {
+            if(it->second == &session) {
+                timedWakes.erase(it);
+                break;
+            }
+        }
+    }
+    --parkedCount;
+}
+
+void SessionDaemon::rebuildActive() {
+    active.clear();
+    for(std::map<uint32_t, std::unique_ptr<Session>>::iterator it = sessions.begin();
+        it != sessions.end(); ++it) {
+        if(it->second->wait == IdleWait::None) active.push_back(it->second.get());
+    }
+    sessionCount.store(sessions.size());
+}
+
+void SessionDaemon::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(tickMutex);
+        workersStopping = true;
+    }
+    tickStart.notify_all();
+    for(size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    workers.clear();
+    tickInFlight = false;
+
+    for(std::map<uint64_t, std::unique_ptr<Connection>>::iterator it = connections.begin();
+        it != connections.end(); ++it) {
+        closeClient(*it->second);
+    }
+    connections.clear();
+    sessions.clear();
+    active.clear();
+    timedWakes.clear();
+    sessionCount.store(0);
+    parkedCount.store(0);
+
+    if(listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+        listenFd = -1;
+    }
+}
@@ -0,0 +1,112 @@
+// ============================================================================
+// TerminalRenderer.cpp - Células, glifos e diff entre frames
+// ============================================================================
+#include "TerminalRenderer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Bit de cada ponto Braille (U+2800 + bits) por linha e coluna da célula
+const uint8_t BRAILLE_DOTS[4][2] = {
+    {0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}
+};
+
+// ▀ ▄ █ por (cima | baixo << 1); a célula vazia é um espaço
+const char* const HALF_BLOCKS[4] = {" ", "\xE2\x96\x80", "\xE2\x96\x84", "\xE2\x96\x88"};
+
+} // namespace
+
+TerminalRenderer::TerminalRenderer(TerminalGlyphs g, unsigned row, unsigned column,
+                                   size_t w, size_t h)
+    : glyphs(g), originRow(row), originColumn(column), width(w), height(h),
+      columns(g == TerminalGlyphs::Braille ? (w + 1) / 2 : w),
+      rows(g == TerminalGlyphs::Braille ? (h + 3) / 4 : (h + 1) / 2),
+      cells(columns * rows), shown(columns * rows), drawn(false) {}
+
+void TerminalRenderer::buildCells(const uint8_t* pixels) {
+    std::fill(cells.begin(), cells.end(), 0);
+    if(glyphs == TerminalGlyphs::HalfBlock) {
+        for(size_t y = 0; y < height; ++y) {
+            uint8_t bit = static_cast<uint8_t>(1 << (y & 1));
+            uint8_t* cell = &cells[(y / 2) * columns];
+            const uint8_t* line = pixels + y * width;
+            for(size_t x = 0; x < width; ++x) {
+                if(line[x]) cell[x] |= bit;
+            }
+        }
+        return;
+    }
+    for(size_t y = 0; y < height; ++y) {
+        const uint8_t* dots = BRAILLE_DOTS[y & 3];
+        uint8_t* cell = &cells[(y / 4) * columns];
+        const uint8_t* line = pixels + y * width;
+        for(size_t x = 0; x < width; ++x) {
+            if(line[x]) cell[x / 2] |= dots[x & 1];
+        }
+    }
+}
+
+void TerminalRenderer::appendGlyph(uint8_t cell, std::string& out) const {
+    if(glyphs == TerminalGlyphs::HalfBlock) {
+        out += HALF_BLOCKS[cell];
+    } else if(cell == 0) {
+        out += ' ';
+    } else {
+        // U+2800 + cell em UTF-8
+        out += '\xE2';
+        out += static_cast<char>(0xA0 | (cell >> 6));
+        out += static_cast<char>(0x80 | (cell & 0x3F));
+    }
+}
+
+void TerminalRenderer::appendMove(size_t row, size_t column, std::string& out) const {
+    char move[32];
+    int size = std::snprintf(move, sizeof(move), "\x1b[%u;%uH",
+                             static_cast<unsigned>(originRow + row),
+                             static_cast<unsigned>(originColumn + column));
+    out.append(move, size);
+}
+
+size_t TerminalRenderer::render(const uint8_t* pixels, std::string& out) {
+    size_t start = out.size();
+    buildCells(pixels);
+
+    std::string move;
+    for(size_t row = 0; row < rows; ++row) {
+        const uint8_t* now = &cells[row * columns];
+        uint8_t* before = &shown[row * columns];
+        size_t cursor = columns + 1;     // Fora desta linha
+
+        for(size_t column = 0; column < columns; ++column) {
+            if(drawn && now[column] == before[column]) continue;
+
+            // Entre o cursor e esta célula: reescrever as de permeio ou
+            // posicionar, o que gastar menos bytes
+            if(cursor != column) {
+                size_t gap = cursor < column ? 0 : SIZE_MAX;
+                for(size_t c = cursor; c < column; ++c) gap += glyphSize(now[c]);
+                move.clear();
+                appendMove(row, column, move);
+                if(gap <= move.size()) {
+                    for(size_t c = cursor; c < column; ++c) appendGlyph(now[c], out);
+                } else {
+                    out += move;
+                }
+            }
+
+            appendGlyph(now[column], out);
+            before[column] = now[column];
+            cursor = column + 1;
+        }
+    }
+    drawn = true;
+    return out.size() - start;
+}
+
+std::string TerminalRenderer::endScreen(unsigned row) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "\x1b[%u;1H\x1b[?25h", row);
+    return text;
+}
@@ -0,0 +1,397 @@
+// ============================================================================
+// VideoRecorder.cpp - Exportação de vídeo headless do framebuffer
+// ============================================================================
+#include "VideoRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const size_t WIDTH = Display::getWidth();
+const size_t HEIGHT = Display::getHeight();
+const size_t PACKED = VideoRecorder::PACKED_SIZE;
+
+const uint8_t PIXEL_ON = 0xFF;
+const uint8_t PIXEL_OFF = 0x00;
+
+bool packedPixel(const uint8_t* packed, size_t x, size_t y) {
+    size_t index = y * WIDTH + x;
+    return (packed[index >> 3] & (0x80 >> (index & 7))) != 0;
+}
+
+// Gera a imagem em tons de cinza ampliada (scale x scale por pixel)
+void rasterize(const uint8_t* packed, unsigned scale, std::vector<uint8_t>& out) {
+    size_t outWidth = WIDTH * scale;
+    out.resize(outWidth * HEIGHT * scale);
+
+    for(size_t y = 0; y < HEIGHT; ++y) {
+        uint8_t* row = &out[y * scale * outWidth];
+        for(size_t x = 0; x < WIDTH; ++x) {
+            std::memset(row + x * scale, packedPixel(packed, x, y) ? PIXEL_ON : PIXEL_OFF, scale);
+        }
+        for(unsigned r = 1; r < scale; ++r) {
+            std::memcpy(row + r * outWidth, row, outWidth);
+        }
+    }
+}
+
+void putU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+}
+
+void putU32BE(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(value >> 24);
+    out.push_back((value >> 16) & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+    out.push_back(value & 0xFF);
+}
+
+struct CrcTable {
+    uint32_t entries[256];
+
+    CrcTable() {
+        for(uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for(int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+    }
+};
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc) {
+    static const CrcTable table;
+
+    crc = ~crc;
+    for(size_t i = 0; i < size; ++i) {
+        crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+} // namespace
+
+// ============================================================================
+// Sinks de saída (executados apenas na thread de fundo)
+// ============================================================================
+class VideoSink {
+public:
+    virtual ~VideoSink() {}
+    virtual bool good() const = 0;
+    virtual void writeFrame(const uint8_t* packed, const uint8_t* delta, size_t deltaSize) = 0;
+};
+
+namespace {
+
+class Y4MSink : public VideoSink {
+private:
+    std::ofstream file;
+    unsigned scale;
+    std::vector<uint8_t> luma;
+    std::vector<uint8_t> chroma;
+
+public:
+    Y4MSink(const char* path, unsigned s) : file(path, std::ios::binary | std::ios::trunc), scale(s) {
+        size_t w = WIDTH * scale;
+        size_t h = HEIGHT * scale;
+        chroma.assign((w / 2) * (h / 2) * 2, 128);
+        file << "YUV4MPEG2 W" << w << " H" << h << " F60:1 Ip A1:1 C420jpeg\n";
+    }
+
+    bool good() const override { return file.good(); }
+
+    void writeFrame(const uint8_t* packed, const uint8_t*, size_t) override {
+        rasterize(packed, scale, luma);
+        file.write("FRAME\n", 6);
+        file.write(reinterpret_cast<const char*>(luma.data()), luma.size());
+        file.write(reinterpret_cast<const char*>(chroma.data()), chroma.size());
+    }
+};
+
+class PngSequenceSink : public VideoSink {
+private:
+    std::string prefix;
+    unsigned scale;
+    uint32_t index;
+    bool ok;
+    std::vector<uint8_t> image;
+    std::vector<uint8_t> png;
+
+    void chunk(const char* type, const uint8_t* data, size_t size) {
+        putU32BE(png, static_cast<uint32_t>(size));
+        size_t start = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data, data + size);
+        putU32BE(png, crc32(&png[start], size + 4, 0));
+    }
+
+public:
+    PngSequenceSink(const char* path, unsigned s) : prefix(path), scale(s), index(0), ok(true) {}
+
+    bool good() const override { return ok; }
+
+    void writeFrame(const uint8_t* packed, const uint8_t*, size_t) override {
+        rasterize(packed, scale, image);
+        uint32_t w = static_cast<uint32_t>(WIDTH * scale);
+        uint32_t h = static_cast<uint32_t>(HEIGHT * scale);
+
+        // Dados brutos: byte de filtro 0 + linha
+        std::vector<uint8_t> raw;
+        raw.reserve((w + 1) * h);
+        for(uint32_t y = 0; y < h; ++y) {
+            raw.push_back(0);
+            raw.insert(raw.end(), &image[y * w], &image[y * w] + w);
+        }
+
+        // zlib com blocos deflate "stored": sem dependência de zlib
+        std::vector<uint8_t> z;
+        z.push_back(0x78);
+        z.push_back(0x01);
+        size_t pos = 0;
+        do {
+            size_t len = std::min<size_t>(raw.size() - pos, 65535);
+            bool last = pos + len == raw.size();
+            z.push_back(last ? 1 : 0);
+            putU16(z, static_cast<uint16_t>(len));
+            putU16(z, static_cast<uint16_t>(~len));
+            z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+            pos += len;
+        } while(pos < raw.size());
+
+        uint32_t a = 1, b = 0;
+        for(size_t i = 0; i < raw.size(); ++i) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        putU32BE(z, (b << 16) | a);
+
+        static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        png.assign(SIGNATURE, SIGNATURE + 8);
+
+        std::vector<uint8_t> ihdr;
+        putU32BE(ihdr, w);
+        putU32BE(ihdr, h);
+        ihdr.push_back(8);      // Bits por canal
+        ihdr.push_back(0);      // Tons de cinza
+        ihdr.push_back(0);
+        ihdr.push_back(0);
+        ihdr.push_back(0);
+        chunk("IHDR", ihdr.data(), ihdr.size());
+        chunk("IDAT", z.data(), z.size());
+        chunk("IEND", nullptr, 0);
+
+        char name[16];
+        std::snprintf(name, sizeof(name), "_%06u.png", index++);
+        std::ofstream file((prefix + name).c_str(), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(png.data()), png.size());
+        ok = ok && file.good();
+    }
+};
+
+class DeltaStreamSink : public VideoSink {
+private:
+    std::ofstream file;
+
+public:
+    explicit DeltaStreamSink(const char* path) : file(path, std::ios::binary | std::ios::trunc) {
+        std::vector<uint8_t> header;
+        header.push_back('C');
+        header.push_back('8');
+        header.push_back('V');
+        header.push_back('1');
+        putU16(header, static_cast<uint16_t>(WIDTH));
+        putU16(header, static_cast<uint16_t>(HEIGHT));
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    }
+
+    bool good() const override { return file.good(); }
+
+    void writeFrame(const uint8_t*, const uint8_t* delta, size_t deltaSize) override {
+        std::vector<uint8_t> length;
+        putU16(length, static_cast<uint16_t>(deltaSize));
+        file.write(reinterpret_cast<const char*>(length.data()), 2);
+        file.write(reinterpret_cast<const char*>(delta), deltaSize);
+    }
+};
+
+VideoSink* createSink(const char* path, VideoFormat format, unsigned scale) {
+    if(scale == 0) scale = 1;
+    switch(format) {
+        case VideoFormat::Y4M: return new Y4MSink(path, scale);
+        case VideoFormat::PngSequence: return new PngSequenceSink(path, scale);
+        case VideoFormat::DeltaStream: return new DeltaStreamSink(path);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// ============================================================================
+// Codificação do formato intermediário
+// ============================================================================
+void VideoRecorder::packPixels(const uint8_t* pixels, uint8_t* packed) {
+    FrameCodec::packPixels(pixels, packed);
+}
+
+void VideoRecorder::unpackPixels(const uint8_t* packed, uint8_t* pixels) {
+    FrameCodec::unpackPixels(packed, pixels);
+}
+
+// Tokens: 0x00-0x7F = (n + 1) bytes iguais; 0x80-0xFF = (n - 0x7F) bytes
+// de XOR literais em seguida
+void VideoRecorder::encodeDelta(const uint8_t* previous, const uint8_t* current,
+                                std::vector<uint8_t>& out) {
+    out.clear();
+    size_t i = 0;
+    while(i < PACKED) {
+        size_t run = 0;
+        while(i + run < PACKED && run < 128 && previous[i + run] == current[i + run]) {
+            ++run;
+        }
+        if(run > 0) {
+            out.push_back(static_cast<uint8_t>(run - 1));
+            i += run;
+            continue;
+        }
+
+        size_t start = i;
+        while(i < PACKED && i - start < 128 && previous[i] != current[i]) {
+            ++i;
+        }
+        out.push_back(static_cast<uint8_t>(0x80 | (i - start - 1)));
+        for(size_t k = start; k < i; ++k) {
+            out.push_back(previous[k] ^ current[k]);
+        }
+    }
+}
+
+bool VideoRecorder::applyDelta(const uint8_t* data, size_t size, uint8_t* packed) {
+    size_t pos = 0;
+    size_t out = 0;
+    while(pos < size) {
+        uint8_t token = data[pos++];
+        size_t count = (token & 0x7F) + 1;
+        if(out + count > PACKED) return false;
+
+        if(token & 0x80) {
+            if(pos + count > size) return false;
+            for(size_t k = 0; k < count; ++k) {
+                packed[out + k] ^= data[pos + k];
+            }
+            pos += count;
+        }
+        out += count;
+    }
+    return out == PACKED;
+}
+
+bool VideoRecorder::convertDeltaStream(const char* input, const char* output,
+                                       VideoFormat format, unsigned scale) {
+    std::ifstream file(input, std::ios::binary);
+    char header[8];
+    if(!file.read(header, 8) || std::memcmp(header, "C8V1", 4) != 0) {
+        std::cerr << "Stream .c8v inválido: " << input << std::endl;
+        return false;
+    }
+
+    std::unique_ptr<VideoSink> sink(createSink(output, format, scale));
+    if(!sink || !sink->good()) {
+        std::cerr << "Erro ao criar vídeo: " << output << std::endl;
+        return false;
+    }
+
+    uint8_t packed[PACKED_SIZE] = {0};
+    std::vector<uint8_t> delta;
+    unsigned char length[2];
+    while(file.read(reinterpret_cast<char*>(length), 2)) {
+        delta.resize(length[0] | (length[1] << 8));
+        if(!file.read(reinterpret_cast<char*>(delta.data()), delta.size()) ||
+           !applyDelta(delta.data(), delta.size(), packed)) {
+            std::cerr << "Frame corrompido em " << input << std::endl;
+            return false;
+        }
+        sink->writeFrame(packed, delta.data(), delta.size());
+    }
+    return sink->good();
+}
+
+// ============================================================================
+// Gravação em segundo plano
+// ============================================================================
+VideoRecorder::VideoRecorder(size_t queueFrames)
+    : queue(queueFrames), droppedFrames(0), running(false), framesWritten(0) {
+    std::memset(lastQueued, 0, sizeof(lastQueued));
+}
+
+VideoRecorder::~VideoRecorder() {
+    close();
+}
+
+bool VideoRecorder::open(const char* path, VideoFormat format, unsigned scale) {
+    close();
+
+    sink.reset(createSink(path, format, scale));
+    if(!sink || !sink->good()) {
+        std::cerr << "Erro ao criar vídeo: " << path << std::endl;
+        sink.reset();
+        return false;
+    }
+
+    std::memset(lastQueued, 0, sizeof(lastQueued));
+    droppedFrames = 0;
+    framesWritten = 0;
+    running = true;
+    worker = std::thread(&VideoRecorder::workerLoop, this);
+    return true;
+}
+
+void VideoRecorder::close() {
+    if(!running.load()) return;
+    running = false;
+    wake.notify_one();
+    worker.join();
+    sink.reset();
+}
+
+bool VideoRecorder::submit(const uint8_t* pixels) {
+    if(!running.load(std::memory_order_relaxed)) return false;
+
+    uint8_t packed[PACKED_SIZE];
+    packPixels(pixels, packed);
+    encodeDelta(lastQueued, packed, encodeBuffer);
+
+    if(!queue.tryPush(encodeBuffer)) {
+        // lastQueued não avança: o próximo delta cobre este frame também
+        ++droppedFrames;
+        return false;
+    }
+
+    std::memcpy(lastQueued, packed, PACKED_SIZE);
+    wake.notify_one();
+    return true;
+}
+
+void VideoRecorder::workerLoop() {
+    uint8_t current[PACKED_SIZE] = {0};
+    std::vector<uint8_t> delta;
+
+    for(;;) {
+        bool stopping = !running.load();
+
+        while(queue.tryPop(delta)) {
+            applyDelta(delta.data(), delta.size(), current);
+            sink->writeFrame(current, delta.data(), delta.size());
+            ++framesWritten;
+        }
+        if(stopping) break;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(5));
+    }
+}
@@ -0,0 +1,101 @@
+// ============================================================================
+// libchip8.cpp - Implementação da API C sobre Chip8
+// ============================================================================
+#include "libchip8.h"
+
+#include <new>
+
+#include "Chip8.h"
+
+static_assert(static_cast<int>(Trap::PcOutOfRange) == CHIP8_TRAP_PC_OUT_OF_RANGE,
+              "CHIP8_TRAP_* segue a ordem de Trap");
+
+struct chip8_instance {
+    Chip8 machine;
+    RunOptions options;     // Só cyclesPerFrame e vipTiming são usados
+};
+
+int chip8_api_version(void) {
+    return CHIP8_API_VERSION;
+}
+
+chip8_instance* chip8_create(void) {
+    chip8_instance* instance = new (std::nothrow) chip8_instance;
+    if(instance) {
+        instance->machine.initialize();
+    }
+    return instance;
+}
+
+void chip8_destroy(chip8_instance* instance) {
+    delete instance;
+}
+
+int chip8_load_rom(chip8_instance* instance, const uint8_t* data, size_t size) {
+    if(!instance || !data) return CHIP8_ERROR_INVALID_ARGUMENT;
+
+    instance->machine.initialize();
+    if(!instance->machine.loadROM(data, size)) return CHIP8_ERROR_ROM_TOO_LARGE;
+    return CHIP8_OK;
+}
+
+void chip8_set_cycles_per_frame(chip8_instance* instance, uint32_t cycles) {
+    if(instance) instance->options.cyclesPerFrame = cycles;
+}
+
+void chip8_set_vip_timing(chip8_instance* instance, int enabled) {
+    if(instance) instance->options.vipTiming = enabled != 0;
+}
+
+void chip8_seed_random(chip8_instance* instance, uint32_t seed) {
+    if(instance) instance->machine.seedRandom(seed);
+}
+
+void chip8_set_keys(chip8_instance* instance, uint16_t mask) {
+    if(instance) instance->machine.getInput().setKeyMask(mask);
+}
+
+void chip8_run_frames(chip8_instance* instance, uint32_t frames) {
+    if(!instance) return;
+    for(uint32_t i = 0; i < frames; ++i) {
+        instance->machine.runFrame(instance->options);
+    }
+}
+
+void chip8_step_many(chip8_instance* const* instances, size_t count, uint32_t frames) {
+    if(!instances) return;
+    for(size_t n = 0; n < count; ++n) {
+        chip8_run_frames(instances[n], frames);
+    }
+}
+
+const uint8_t* chip8_framebuffer(const chip8_instance* instance) {
+    return instance ? instance->machine.getDisplay().getPixels() : nullptr;
+}
+
+int chip8_get_trap(const chip8_instance* instance) {
+    return instance ? static_cast<int>(instance->machine.getTrap()) : CHIP8_TRAP_NONE;
+}
+
+int chip8_take_redraw(chip8_instance* instance) {
+    return instance && instance->machine.takeRedraw() ? 1 : 0;
+}
+
+void chip8_get_state(const chip8_instance* instance, chip8_state* state) {
+    if(!instance || !state) return;
+
+    const Registers& registers = instance->machine.getRegisters();
+    for(uint8_t n = 0; n < 16; ++n) {
+        state->v[n] = registers.getV(n);
+        state->stack[n] = registers.getStackEntry(n);
+    }
+    state->i = registers.getI();
+    state->pc = registers.getPC();
+    state->sp = registers.getSP();
+    state->delay_timer = registers.getDelayTimer();
+    state->sound_timer = registers.getSoundTimer();
+    state->stack_fault = registers.hasStackFault() ? 1 : 0;
+    state->frame_count = instance->machine.getFrameCount();
+    state->machine_cycles = instance->machine.getMachineCycles();
+    state->trap = static_cast<uint8_t>(registers.getTrap());
+}
@@ -1,26 +1,247 @@
 // ============================================================================
-// main.cpp - Ponto de entrada
+// main.cpp - Ponto de entrada (execução headless)
 // ============================================================================
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Chip8.h"
+#include "HeadlessRunner.h"
+#include "InstructionTrace.h"
+#include "TerminalRenderer.h"
+
+namespace {
+
+// Decimal ou 0x...; false se sobrar texto ou passar de max
+bool parseNumber(const char* text, uint64_t max, uint64_t& value) {
+    char* end = nullptr;
+    if(*text == '\0' || *text == '-') return false;
+    value = std::strtoull(text, &end, 0);
+    return *end == '\0' && value <= max;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Uso: " << program << " <ROM_file> [opções]\n"
+              << "  --frames N           para depois de N frames\n"
+              << "  --cycles N           para depois de N instruções\n"
+              << "  --ips N              instruções por segundo (padrão 600 = 10 por frame)\n"
+              << "  --seed N             semente fixa do CXNN (execuções reproduzíveis)\n"
+              << "  --input arquivo      script de teclas: <frame> <tecla hex> down|up\n"
+              << "  --until-pc ADDR      para quando o PC chegar em ADDR\n"
+              << "  --until-halt         para num laço 1NNN para o próprio endereço\n"
+              << "  --until-mem ADDR=VAL para quando a memória em ADDR valer VAL\n"
+              << "  --until-hash HEX     para quando o hash da tela for HEX (o de chip8-golden)\n"
+              << "  --dump arquivo|-     estado final em JSON\n"
+              << "  --profile diretório  --trace arquivo  --trace-ring registros\n"
+              << "  --screen half|braille\n"
+              << "Sem limite nem condição, roda 60 frames." << std::endl;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
     if(argc < 2) {
-        std::cout << "Uso: " << argv[0] << " <ROM_file>" << std::endl;
+        printUsage(argv[0]);
         return 1;
     }
-    
+
+    RunnerOptions options;
+    std::string inputPath;
+    std::string dumpPath;
+    std::string profileDir;
+    std::string tracePath;
+    uint64_t traceRing = 0;
+    bool traceRingSet = false;
+    uint64_t seed = 0;
+    bool seeded = false;
+    const char* screen = nullptr;
+    for(int i = 2; i < argc; ++i) {
+        const char* option = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        uint64_t number = 0;
+        bool valid = true;
+
+        if(std::strcmp(option, "--until-halt") == 0) {
+            options.stopOnHalt = true;
+            continue;
+        }
+        if(!value) {
+            std::cerr << "Opção desconhecida ou sem valor: " << option << std::endl;
+            return 1;
+        }
+        ++i;
+
+        if(std::strcmp(option, "--frames") == 0) {
+            valid = parseNumber(value, UINT64_MAX, options.maxFrames) && options.maxFrames > 0;
+        } else if(std::strcmp(option, "--cycles") == 0) {
+            valid = parseNumber(value, UINT64_MAX, options.maxCycles) && options.maxCycles > 0;
+        } else if(std::strcmp(option, "--ips") == 0) {
+            valid = parseNumber(value, 60ull * UINT32_MAX, number) && number > 0;
+            options.cyclesPerFrame = static_cast<uint32_t>(number < 60 ? 1 : (number + 30) / 60);
+        } else if(std::strcmp(option, "--seed") == 0) {
+            valid = parseNumber(value, UINT32_MAX, seed);
+            seeded = true;
+        } else if(std::strcmp(option, "--input") == 0) {
+            inputPath = value;
+        } else if(std::strcmp(option, "--until-pc") == 0) {
+            valid = parseNumber(value, 0xFFF, number);
+            options.stopAtPc = true;
+            options.pc = static_cast<uint16_t>(number);
+        } else if(std::strcmp(option, "--until-mem") == 0) {
+            std::string text(value);
+            size_t equals = text.find('=');
+            uint64_t address = 0;
+            valid = equals != std::string::npos &&
+                    parseNumber(text.substr(0, equals).c_str(), 0xFFF, address) &&
+                    parseNumber(text.substr(equals + 1).c_str(), 0xFF, number);
+            options.stopOnMemory = true;
+            options.memoryAddress = static_cast<uint16_t>(address);
+            options.memoryValue = static_cast<uint8_t>(number);
+        } else if(std::strcmp(option, "--until-hash") == 0) {
+            char* end = nullptr;
+            options.frameHash = std::strtoull(value, &end, 16);
+            valid = *value != '\0' && *end == '\0';
+            options.stopOnFrameHash = true;
+        } else if(std::strcmp(option, "--dump") == 0) {
+            dumpPath = value;
+        } else if(std::strcmp(option, "--profile") == 0) {
+            profileDir = value;
+        } else if(std::strcmp(option, "--trace") == 0) {
+            tracePath = value;
+        } else if(std::strcmp(option, "--trace-ring") == 0) {
+            valid = parseNumber(value, TraceWriter::MAX_RING_RECORDS, traceRing);
+            traceRingSet = true;
+        } else if(std::strcmp(option, "--screen") == 0) {
+            screen = value;
+            valid = std::strcmp(screen, "half") == 0 || std::strcmp(screen, "braille") == 0;
+        } else {
+            std::cerr << "Opção desconhecida: " << option << std::endl;
+            return 1;
+        }
+
+        if(!valid) {
+            std::cerr << "Valor inválido para " << option << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    if(traceRingSet && tracePath.empty()) {
+        std::cerr << "--trace-ring requer --trace" << std::endl;
+        return 1;
+    }
+
+    // Sem limite nem condição a execução nunca terminaria
+    if(!options.maxFrames && !options.maxCycles && !options.hasConditions()) {
+        options.maxFrames = 60;
+    }
+    if(!inputPath.empty() && !HeadlessRunner::loadInputScript(inputPath, options.input)) {
+        return 1;
+    }
+
+    // Com o JSON em stdout, mensagens, tela e resumo vão para stderr
+    bool dumpToStdout = dumpPath == "-";
+    std::ostream& log = dumpToStdout ? std::cerr : std::cout;
     Chip8 emulator;
     emulator.initialize();
-    
-    if(!emulator.loadROM(argv[1])) {
+
+    std::streambuf* console = std::cout.rdbuf();
+    if(dumpToStdout) std::cout.rdbuf(std::cerr.rdbuf());
+    bool loaded = emulator.loadROM(argv[1]);
+    std::cout.rdbuf(console);
+    if(!loaded) {
+        return 1;
+    }
+    if(seeded) emulator.seedRandom(static_cast<uint32_t>(seed));
+
+    // Perfil da ROM (pelo hash do conteúdo): continua o das execuções
+    // anteriores e é regravado no fim, para recompile-rom -p
+    std::string profilePath;
+    RomProfile profile;
+    if(!profileDir.empty()) {
+        profilePath = RomProfile::pathFor(profileDir, emulator.getRomHash());
+        if(profile.load(profilePath, emulator.getRomHash())) {
+            log << "Perfil carregado: " << profilePath << std::endl;
+        }
+    }
+    ProfileRecorder<Chip8> recorder(profile, emulator);
+
+    // Trace por instrução, lido depois com chip8-trace
+    TraceWriter trace;
+    if(!tracePath.empty() && !trace.open(tracePath, traceRing)) {
+        return 1;
+    }
+    InstructionTracer<Chip8> tracer(trace, emulator);
+
+    // Tela no terminal: depois do primeiro desenho, só as células alteradas
+    TerminalRenderer renderer(screen && std::strcmp(screen, "braille") == 0
+                                  ? TerminalGlyphs::Braille : TerminalGlyphs::HalfBlock);
+    std::string output;
+    if(screen) output = TerminalRenderer::beginScreen();
+    auto present = [&](bool redraw) {
+        if(redraw) {
+            renderer.render(emulator.getDisplay(), output);
+            log << output << std::flush;
+            output.clear();
+        }
+    };
+
+    // Sem perfil, trace nem tela, cada frame é um runFrame puro
+    bool profiling = !profilePath.empty();
+    RunnerResult result;
+    if(profiling || trace.isOpen()) {
+        auto step = [&]() {
+            if(profiling) recorder.step();
+            if(trace.isOpen()) tracer.step();
+        };
+        result = screen ? HeadlessRunner::run(emulator, options, step, present)
+                        : HeadlessRunner::run(emulator, options, step, [](bool) {});
+    } else {
+        result = screen ? HeadlessRunner::run(emulator, options, []() {}, present)
+                        : HeadlessRunner::run(emulator, options);
+    }
+    if(screen) {
+        log << output << TerminalRenderer::endScreen(renderer.getRows() + 1) << std::flush;
+    }
+
+    if(trace.isOpen() && !trace.close()) {
+        return 1;
+    }
+
+    if(!profilePath.empty() && !profile.save(profilePath)) {
+        return 1;
+    }
+
+    if(dumpToStdout) {
+        HeadlessRunner::dumpJson(emulator, result, std::cout);
+    } else if(!dumpPath.empty()) {
+        std::ofstream file(dumpPath);
+        if(file.is_open()) HeadlessRunner::dumpJson(emulator, result, file);
+        if(!file) {
+            std::cerr << "Erro ao gravar dump: " << dumpPath << std::endl;
+            return 1;
+        }
+    }
+
+    log << "exit: " << HeadlessRunner::exitName(result.exit)
+            << " frames: " << result.frames << " cycles: " << result.cycles
+            << " pc: 0x" << std::hex << emulator.getRegisters().getPC()
+            << " hash: " << std::setw(16) << std::setfill('0')
+            << HeadlessRunner::frameHash(emulator.getDisplay()) << std::dec << std::endl;
+
+    if(emulator.getTrap() != Trap::None) {
+        std::cerr << "Execução interrompida: " << trapName(emulator.getTrap())
+                  << " em PC=0x" << std::hex << emulator.getRegisters().getPC() << std::endl;
         return 1;
     }
-    
-    std::cout << "Emulador CHIP-8 Modular iniciado!" << std::endl;
-    std::cout << "Arquitetura: Componentes separados e reutilizáveis" << std::endl;
-    
-    // Loop de exemplo
-    for(int i = 0; i < 10; ++i) {
-        emulator.cycle();
+
+    // Condição pedida e não atingida antes do limite: 2, para scripts
+    if(options.hasConditions() &&
+       (result.exit == RunnerExit::Frames || result.exit == RunnerExit::Cycles)) {
+        return 2;
     }
-    
+
     return 0;
-}
\ No newline at end of file
+}
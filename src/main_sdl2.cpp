@@ -0,0 +1,331 @@
+// ============================================================================
+// main_sdl2.cpp - Frontend SDL2 (vídeo, áudio e teclado)
+// ============================================================================
+// Uso: chip8-sdl2 <ROM_file> [--scale N] [--speed X] [--cycles N] [--vip]
+//                 [--phosphor] [--no-vsync] [--frames N] [--seed N]
+//
+// A emulação segue o próprio relógio (FramePacer, via Chip8::run): o vsync
+// só limita a apresentação, então um monitor de 144 Hz não acelera o jogo e
+// um compositor lento faz a emulação rodar os frames atrasados seguidos.
+// Com SDL_VIDEODRIVER=dummy (ou offscreen) e SDL_AUDIODRIVER=dummy roda sem
+// tela nem som; --frames N termina depois de exatamente N frames e imprime
+// o hash da tela final (o mesmo de chip8-core), para testes. Com --seed o
+// CXNN é reproduzível.
+#include <SDL.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "AudioSynth.h"
+#include "Chip8.h"
+#include "HeadlessRunner.h"
+#include "PhosphorFilter.h"
+#include "SpscRing.h"
+
+namespace {
+
+const int WIDTH = static_cast<int>(Display::getWidth());
+const int HEIGHT = static_cast<int>(Display::getHeight());
+
+const uint32_t BACKGROUND = 0xFF101810;
+const uint32_t FOREGROUND = 0xFF40FF60;
+
+// Teclado hexadecimal do COSMAC VIP no bloco 1234/QWER/ASDF/ZXCV
+struct KeyBinding {
+    SDL_Scancode scancode;
+    uint8_t key;
+};
+
+const KeyBinding KEYMAP[16] = {
+    {SDL_SCANCODE_1, 0x1}, {SDL_SCANCODE_2, 0x2}, {SDL_SCANCODE_3, 0x3}, {SDL_SCANCODE_4, 0xC},
+    {SDL_SCANCODE_Q, 0x4}, {SDL_SCANCODE_W, 0x5}, {SDL_SCANCODE_E, 0x6}, {SDL_SCANCODE_R, 0xD},
+    {SDL_SCANCODE_A, 0x7}, {SDL_SCANCODE_S, 0x8}, {SDL_SCANCODE_D, 0x9}, {SDL_SCANCODE_F, 0xE},
+    {SDL_SCANCODE_Z, 0xA}, {SDL_SCANCODE_X, 0x0}, {SDL_SCANCODE_C, 0xB}, {SDL_SCANCODE_V, 0xF}
+};
+
+// Amostras entre a emulação (produtor) e o callback do SDL (consumidor)
+struct AudioOutput {
+    SDL_AudioDeviceID device;
+    SpscRing<int16_t> ring;
+    std::atomic<uint64_t> underruns;
+
+    explicit AudioOutput(size_t capacity) : device(0), ring(capacity), underruns(0) {}
+};
+
+// Thread de áudio do SDL: nunca bloqueia; falta de amostras vira silêncio
+void SDLCALL audioCallback(void* userdata, Uint8* stream, int length) {
+    AudioOutput& audio = *static_cast<AudioOutput*>(userdata);
+    int16_t* samples = reinterpret_cast<int16_t*>(stream);
+    size_t count = static_cast<size_t>(length) / sizeof(int16_t);
+    size_t got = audio.ring.pop(samples, count);
+    if(got < count) {
+        std::memset(samples + got, 0, (count - got) * sizeof(int16_t));
+        audio.underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint32_t blendColor(uint8_t level) {
+    uint32_t color = 0xFF000000;
+    for(int shift = 0; shift < 24; shift += 8) {
+        uint32_t bg = (BACKGROUND >> shift) & 0xFF;
+        uint32_t fg = (FOREGROUND >> shift) & 0xFF;
+        color |= ((bg * (255 - level) + fg * level) / 255) << shift;
+    }
+    return color;
+}
+
+// Textura de streaming 64x32 atualizada só nas linhas que mudaram desde o
+// último upload (comparando níveis 0..255 por pixel)
+class ScreenTexture {
+private:
+    SDL_Texture* texture;
+    uint32_t palette[256];
+    std::vector<uint8_t> shown;
+    bool uploaded;
+
+public:
+    ScreenTexture() : texture(nullptr), shown(WIDTH * HEIGHT, 0), uploaded(false) {
+        for(int level = 0; level < 256; ++level) {
+            palette[level] = blendColor(static_cast<uint8_t>(level));
+        }
+    }
+
+    ~ScreenTexture() {
+        if(texture) SDL_DestroyTexture(texture);
+    }
+
+    bool create(SDL_Renderer* renderer) {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                    SDL_TEXTUREACCESS_STREAMING, WIDTH, HEIGHT);
+        if(!texture) {
+            std::cerr << "Erro ao criar textura: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // levels: WIDTH * HEIGHT níveis. Retorna false se nada mudou.
+    bool update(const uint8_t* levels) {
+        int first = 0;
+        int last = HEIGHT - 1;
+        if(uploaded) {
+            while(first < HEIGHT && std::memcmp(&levels[first * WIDTH], &shown[first * WIDTH], WIDTH) == 0) {
+                ++first;
+            }
+            if(first == HEIGHT) return false;
+            while(std::memcmp(&levels[last * WIDTH], &shown[last * WIDTH], WIDTH) == 0) {
+                --last;
+            }
+        }
+
+        SDL_Rect rows = {0, first, WIDTH, last - first + 1};
+        void* data = nullptr;
+        int pitch = 0;
+        if(SDL_LockTexture(texture, &rows, &data, &pitch) != 0) {
+            std::cerr << "Erro ao travar textura: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        for(int y = first; y <= last; ++y) {
+            uint32_t* line = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(data) + (y - first) * pitch);
+            const uint8_t* source = &levels[y * WIDTH];
+            for(int x = 0; x < WIDTH; ++x) {
+                line[x] = palette[source[x]];
+            }
+        }
+        SDL_UnlockTexture(texture);
+
+        std::memcpy(&shown[first * WIDTH], &levels[first * WIDTH], (last - first + 1) * WIDTH);
+        uploaded = true;
+        return true;
+    }
+
+    SDL_Texture* get() const { return texture; }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        std::cout << "Uso: " << argv[0] << " <ROM_file> [--scale N] [--speed X] [--cycles N] [--vip]"
+                  << " [--phosphor] [--no-vsync] [--frames N] [--seed N]" << std::endl;
+        return 1;
+    }
+
+    RunOptions options;
+    int scale = 10;
+    bool phosphor = false;
+    bool vsync = true;
+    uint64_t frameLimit = 0;
+    const char* seed = nullptr;
+    for(int i = 2; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = std::atoi(argv[++i]);
+            if(scale < 1) scale = 1;
+        } else if(std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            options.speed = std::atof(argv[++i]);
+        } else if(std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+            options.cyclesPerFrame = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if(std::strcmp(argv[i], "--vip") == 0) {
+            options.vipTiming = true;
+        } else if(std::strcmp(argv[i], "--phosphor") == 0) {
+            phosphor = true;
+        } else if(std::strcmp(argv[i], "--no-vsync") == 0) {
+            vsync = false;
+        } else if(std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameLimit = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = argv[++i];
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    Chip8 emulator;
+    emulator.initialize();
+    if(!emulator.loadROM(argv[1])) {
+        return 1;
+    }
+    if(seed) emulator.seedRandom(static_cast<uint32_t>(std::strtoul(seed, nullptr, 10)));
+
+    // Com limite, um frame por rodada: atrasada, a emulação ressincroniza em
+    // vez de rodar vários frames seguidos e passar de frameLimit
+    if(frameLimit) options.maxCatchUpFrames = 1;
+
+    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
+        std::cerr << "Erro ao iniciar SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    SDL_Window* window = SDL_CreateWindow("CHIP-8", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                          WIDTH * scale, HEIGHT * scale, SDL_WINDOW_RESIZABLE);
+    if(!window) {
+        std::cerr << "Erro ao criar janela: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+
+    // Drivers sem aceleração (dummy, offscreen) caem no renderer software
+    Uint32 flags = SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, flags);
+    if(!renderer) renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if(!renderer) {
+        std::cerr << "Erro ao criar renderer: " << SDL_GetError() << std::endl;
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    SDL_RenderSetLogicalSize(renderer, WIDTH, HEIGHT);
+
+    int status = 0;
+    {
+        ScreenTexture screen;
+        if(!screen.create(renderer)) status = 1;
+
+        // Áudio opcional: sem dispositivo a emulação segue muda. O ring
+        // guarda ~4 frames, o que limita a latência.
+        AudioSynth synth;
+        AudioOutput audio(AudioSynth::DEFAULT_SAMPLE_RATE * 4 / AudioSynth::FRAME_RATE);
+        if(status == 0 && SDL_InitSubSystem(SDL_INIT_AUDIO) == 0) {
+            SDL_AudioSpec want, have;
+            SDL_zero(want);
+            want.freq = static_cast<int>(AudioSynth::DEFAULT_SAMPLE_RATE);
+            want.format = AUDIO_S16SYS;
+            want.channels = 1;
+            want.samples = 512;
+            want.callback = audioCallback;
+            want.userdata = &audio;
+            audio.device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
+            if(audio.device) {
+                SDL_PauseAudioDevice(audio.device, 0);
+            } else {
+                std::cerr << "Sem áudio: " << SDL_GetError() << std::endl;
+            }
+        }
+
+        PhosphorOptions persistence;
+        if(!phosphor) {
+            persistence.decay = 0;
+            persistence.blend = false;
+        }
+        PhosphorFilter filter(persistence);
+
+        bool quit = status != 0;
+        bool exposed = true;
+
+        std::function<bool()> keepRunning = [&]() {
+            SDL_Event event;
+            while(SDL_PollEvent(&event)) {
+                if(event.type == SDL_QUIT) {
+                    quit = true;
+                } else if(event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
+                    if(event.key.repeat) continue;
+                    bool pressed = event.type == SDL_KEYDOWN;
+                    if(event.key.keysym.scancode == SDL_SCANCODE_ESCAPE) quit = true;
+                    for(size_t k = 0; k < 16; ++k) {
+                        if(KEYMAP[k].scancode == event.key.keysym.scancode) {
+                            emulator.getInput().postKey(KEYMAP[k].key, pressed);
+                        }
+                    }
+                } else if(event.type == SDL_WINDOWEVENT) {
+                    exposed = true;     // Exposta ou redimensionada: redesenha
+                }
+            }
+            return !quit && (frameLimit == 0 || emulator.getFrameCount() < frameLimit);
+        };
+
+        // A cada frame emulado, mesmo nas rodadas de catch-up: o som e o
+        // decaimento do fósforo seguem o tempo emulado, não o das
+        // apresentações, e um bipe que começa ou acaba no meio da rodada
+        // não estica nem some
+        std::function<void()> afterFrame = [&]() {
+            if(audio.device) synth.renderFrame(emulator.shouldBeep(), audio.ring);
+            if(phosphor) filter.process(emulator.getDisplay());
+        };
+
+        // Uma vez por rodada de frames emulados
+        std::function<void()> present = [&]() {
+            // Com a persistência a imagem muda mesmo sem desenho novo
+            if(!emulator.takeRedraw() && !phosphor && !exposed) return;
+            const uint8_t* levels = phosphor ? filter.getIntensity()
+                                             : filter.process(emulator.getDisplay());
+            bool changed = screen.update(levels);
+            if(!changed && !exposed) return;
+
+            SDL_RenderClear(renderer);
+            SDL_RenderCopy(renderer, screen.get(), nullptr, nullptr);
+            SDL_RenderPresent(renderer);
+            exposed = false;
+        };
+
+        if(status == 0) {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            emulator.run(options, keepRunning, present, afterFrame);
+        }
+
+        if(audio.device) SDL_CloseAudioDevice(audio.device);
+
+        if(emulator.getTrap() != Trap::None) {
+            std::cerr << "Execução interrompida: " << trapName(emulator.getTrap())
+                      << " em PC=0x" << std::hex << emulator.getRegisters().getPC() << std::dec
+                      << std::endl;
+            status = 1;
+        }
+        if(frameLimit) {
+            std::cout << "frames: " << emulator.getFrameCount()
+                      << " hash: " << std::hex << std::setw(16) << std::setfill('0')
+                      << HeadlessRunner::frameHash(emulator.getDisplay())
+                      << std::dec << " apresentações puladas: " << emulator.getSkippedPresents()
+                      << " underruns: " << audio.underruns.load() << std::endl;
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return status;
+}
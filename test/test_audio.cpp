@@ -0,0 +1,96 @@
+// ============================================================================
+// test_audio.cpp - Audio Synthesis and WAV Sink Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+#include "AudioSynth.h"
+#include "WavWriter.h"
+
+TEST(AudioSynthTest, SilentWhenInactive) {
+    AudioSynth synth(48000);
+    std::vector<int16_t> samples(800);
+    synth.render(false, samples.data(), samples.size());
+
+    for(size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_EQ(samples[i], 0);
+    }
+}
+
+TEST(AudioSynthTest, ProducesToneWhenActive) {
+    AudioSynth synth(48000);
+    std::vector<int16_t> samples(800);
+    synth.render(true, samples.data(), samples.size());
+
+    int16_t peak = 0;
+    for(size_t i = 0; i < samples.size(); ++i) {
+        peak = std::max<int16_t>(peak, std::abs(samples[i]));
+    }
+    EXPECT_GT(peak, 4000);
+}
+
+TEST(AudioSynthTest, EdgesAreBandLimited) {
+    // Sem PolyBLEP a onda quadrada saltaria de -volume para +volume em uma
+    // única amostra; com a correção o salto é distribuído em duas.
+    AudioSynth synth(48000);
+    synth.setVolume(10000);
+    std::vector<int16_t> samples(4800);
+    synth.render(true, samples.data(), samples.size());
+
+    int maxJump = 0;
+    for(size_t i = 2400; i < samples.size(); ++i) {
+        maxJump = std::max(maxJump, std::abs(samples[i] - samples[i - 1]));
+    }
+    EXPECT_LT(maxJump, 20000);
+}
+
+TEST(AudioSynthTest, RenderFrameAccumulatesFractionalSamples) {
+    AudioSynth synth(44100);
+    SpscRing<int16_t> ring(1 << 16);
+
+    size_t total = 0;
+    for(int frame = 0; frame < 60; ++frame) {
+        total += synth.renderFrame(true, ring);
+    }
+    EXPECT_EQ(total, 44100u);
+    EXPECT_EQ(synth.getDroppedSamples(), 0u);
+}
+
+TEST(AudioSynthTest, FullRingDropsInsteadOfBlocking) {
+    AudioSynth synth(44100);
+    SpscRing<int16_t> ring(256);
+
+    synth.renderFrame(true, ring);
+    EXPECT_EQ(ring.size(), 256u);
+    EXPECT_EQ(synth.getDroppedSamples(), 735u - 256u);
+}
+
+TEST(WavWriterTest, WritesHeaderAndSamples) {
+    const char* path = "test_audio_output.wav";
+    {
+        WavWriter wav;
+        ASSERT_TRUE(wav.open(path, 22050));
+
+        AudioSynth synth(22050);
+        SpscRing<int16_t> ring(1024);
+        synth.renderFrame(true, ring);
+        EXPECT_EQ(wav.drain(ring), 367u);
+        EXPECT_EQ(wav.getSamplesWritten(), 367u);
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(static_cast<size_t>(file.tellg()), 44u + 367u * 2);
+
+    char header[44];
+    file.seekg(0);
+    file.read(header, 44);
+    EXPECT_EQ(std::string(header, 4), "RIFF");
+    EXPECT_EQ(std::string(header + 8, 4), "WAVE");
+    EXPECT_EQ(std::string(header + 36, 4), "data");
+
+    file.close();
+    std::remove(path);
+}
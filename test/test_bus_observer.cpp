@@ -0,0 +1,103 @@
+// ============================================================================
+// test_bus_observer.cpp - Compile-time Observer Policy Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <vector>
+#include "Memory.h"
+#include "Registers.h"
+#include "Display.h"
+
+// A política nula não pode acrescentar nenhum byte aos componentes
+// (Memory tem 4096 bytes mais os 2 de guarda de fetchOpcode)
+static_assert(sizeof(BasicMemory<NullObserver>) == 4096 + 2, "NullObserver must be free");
+static_assert(sizeof(BasicDisplay<NullObserver>) == 64 * 32 + 1, "NullObserver must be free");
+
+TEST(BusObserverTest, TracesMemoryReadsAndWrites) {
+    BasicMemory<TracingObserver> memory;
+    memory.write(0x300, 0xAB);
+    memory.read(0x1300);    // Mascarado para 0x300
+
+    std::vector<TraceRecord> trace;
+    memory.getObserver().copyTrace(trace);
+    ASSERT_EQ(trace.size(), 2u);
+    EXPECT_EQ(trace[0].kind, TRACE_MEMORY_WRITE);
+    EXPECT_EQ(trace[0].address, 0x300);
+    EXPECT_EQ(trace[0].value, 0xAB);
+    EXPECT_EQ(trace[1].kind, TRACE_MEMORY_READ);
+    EXPECT_EQ(trace[1].address, 0x300);
+}
+
+TEST(BusObserverTest, SpansExpandToPerByteRecords) {
+    BasicMemory<TracingObserver> memory;
+    uint8_t data[3] = {1, 2, 3};
+    memory.writeSpan(0xFFF, data, 3);
+
+    std::vector<TraceRecord> trace;
+    memory.getObserver().copyTrace(trace);
+    ASSERT_EQ(trace.size(), 3u);
+    EXPECT_EQ(trace[0].address, 0xFFF);
+    EXPECT_EQ(trace[1].address, 0x000);
+    EXPECT_EQ(trace[2].address, 0x001);
+    EXPECT_EQ(trace[2].value, 3);
+}
+
+TEST(BusObserverTest, TracesRegisterChanges) {
+    BasicRegisters<TracingObserver> registers;
+    registers.getObserver().clearTrace();
+
+    registers.setV(0x3, 0x42);
+    registers.pushStack(0x202);
+    registers.setPC(0x400);
+
+    std::vector<TraceRecord> trace;
+    registers.getObserver().copyTrace(trace);
+    ASSERT_EQ(trace.size(), 3u);
+    EXPECT_EQ(trace[0].kind, TRACE_REGISTER_V);
+    EXPECT_EQ(trace[0].index, 3);
+    EXPECT_EQ(trace[0].value, 0x42);
+    EXPECT_EQ(trace[1].kind, TRACE_REGISTER_SP);
+    EXPECT_EQ(trace[1].value, 1);
+    EXPECT_EQ(trace[1].address, 0x202);
+    EXPECT_EQ(trace[2].kind, TRACE_REGISTER_PC);
+    EXPECT_EQ(trace[2].value, 0x400);
+}
+
+TEST(BusObserverTest, TracesDisplayDraws) {
+    BasicDisplay<TracingObserver> display;
+    uint8_t sprite[1] = {0x80};
+    display.drawSprite(5, 7, sprite, 1);
+    display.drawSprite(5, 7, sprite, 1);
+
+    std::vector<TraceRecord> trace;
+    display.getObserver().copyTrace(trace);
+    ASSERT_EQ(trace.size(), 3u);   // clear() do construtor + 2 desenhos
+    EXPECT_EQ(trace[0].kind, TRACE_DISPLAY_CLEAR);
+    EXPECT_EQ(trace[1].kind, TRACE_DISPLAY_DRAW);
+    EXPECT_EQ(trace[1].address, 5 | (7 << 8));
+    EXPECT_EQ(trace[1].value, 0);
+    EXPECT_EQ(trace[2].value, 1);
+}
+
+TEST(BusObserverTest, RingKeepsMostRecentRecords) {
+    TracingObserver observer(4);
+    for(uint16_t i = 0; i < 10; ++i) {
+        observer.onMemoryWrite(i, static_cast<uint8_t>(i));
+    }
+
+    std::vector<TraceRecord> trace;
+    observer.copyTrace(trace);
+    ASSERT_EQ(trace.size(), 4u);
+    EXPECT_EQ(trace[0].address, 6);
+    EXPECT_EQ(trace[3].address, 9);
+    EXPECT_EQ(observer.getTraceCount(), 10u);
+}
+
+TEST(BusObserverTest, CopiesStartWithEmptyTrace) {
+    BasicMemory<TracingObserver> memory;
+    memory.write(0x200, 1);
+
+    BasicMemory<TracingObserver> copy(memory);
+    EXPECT_EQ(copy.read(0x200), 1);
+    EXPECT_EQ(copy.getObserver().getTraceCount(), 1u);
+    EXPECT_EQ(memory.getObserver().getTraceCount(), 1u);
+}
@@ -2,8 +2,43 @@
 // test_chip8.cpp - Integration Tests
 // ============================================================================
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 #include "Chip8.h"
 
+namespace {
+
+// Grava uma ROM temporária para loadROM()
+bool writeROM(const char* path, const uint8_t* data, size_t size) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data), size);
+    return file.good();
+}
+
+// 200: 603C LD V0,60  | 202: F015 LD DT,V0 | 204: 6114 LD V1,20 | 206: F118 LD ST,V1
+// 208: F207 LD V2,DT  | 20A: 3205 SE V2,5  | 20C: 1208 JP 208   (espera DT == 5)
+// 20E: 7301 ADD V3,1  | 210: 120E JP 20E
+const uint8_t TIMER_WAIT_ROM[] = {
+    0x60, 0x3C, 0xF0, 0x15, 0x61, 0x14, 0xF1, 0x18,
+    0xF2, 0x07, 0x32, 0x05, 0x12, 0x08, 0x73, 0x01, 0x12, 0x0E
+};
+
+// Mesmo estado observável: registradores, timers e frame
+void expectSameState(const Chip8& a, const Chip8& b) {
+    const Registers& ra = a.getRegisters();
+    const Registers& rb = b.getRegisters();
+    EXPECT_EQ(ra.getPC(), rb.getPC());
+    EXPECT_EQ(ra.getI(), rb.getI());
+    for(uint8_t v = 0; v < 16; ++v) {
+        EXPECT_EQ(ra.getV(v), rb.getV(v)) << "V" << static_cast<int>(v);
+    }
+    EXPECT_EQ(ra.getDelayTimer(), rb.getDelayTimer());
+    EXPECT_EQ(ra.getSoundTimer(), rb.getSoundTimer());
+    EXPECT_EQ(a.getFrameCount(), b.getFrameCount());
+}
+
+} // namespace
+
 class Chip8Test : public ::testing::Test {
 protected:
     Chip8 emulator;
@@ -44,10 +79,216 @@ TEST_F(Chip8Test, MultipleInitializations) {
     EXPECT_NO_THROW(emulator.cycle());
 }
 
-// ============================================================================
-// Main test runner
-// ============================================================================
-int main(int argc, char** argv) {
-    ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
-}
\ No newline at end of file
+TEST_F(Chip8Test, RunFrameTicksTimersOncePerFrame) {
+    // 6005: V0 = 5; F015: DT = V0; 1204: laço infinito
+    const uint8_t rom[] = {0x60, 0x05, 0xF0, 0x15, 0x12, 0x04};
+    ASSERT_TRUE(writeROM("test_timer.ch8", rom, sizeof(rom)));
+    ASSERT_TRUE(emulator.loadROM("test_timer.ch8"));
+    std::remove("test_timer.ch8");
+
+    emulator.runFrame(10);
+    EXPECT_EQ(emulator.getRegisters().getDelayTimer(), 4);
+    emulator.runFrame(10);
+    EXPECT_EQ(emulator.getRegisters().getDelayTimer(), 3);
+    EXPECT_EQ(emulator.getFrameCount(), 2u);
+}
+
+TEST_F(Chip8Test, RunFrameAppliesInputStampedWithFrameNumber) {
+    emulator.getInput().postKey(4, true, 1);
+
+    emulator.runFrame(1);
+    EXPECT_FALSE(emulator.getInput().isKeyPressed(4));
+    emulator.runFrame(1);
+    EXPECT_TRUE(emulator.getInput().isKeyPressed(4));
+}
+
+TEST_F(Chip8Test, UncappedRunStopsOnPredicate) {
+    // Memória vazia correria até o fim e pararia num trap
+    const uint8_t rom[] = {0x12, 0x00};     // JP 200
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+    RunOptions options;
+    options.speed = 0.0;
+
+    uint64_t frames = emulator.run(options, [this]() {
+        return emulator.getFrameCount() < 1000;
+    });
+    EXPECT_EQ(frames, 1000u);
+}
+
+TEST_F(Chip8Test, RealTimeRunPresentsAtMostOncePerRound) {
+    RunOptions options;
+    options.speed = 10.0;   // 600 frames por segundo
+
+    int presents = 0;
+    uint64_t frames = emulator.run(options,
+        [this]() { return emulator.getFrameCount() < 30; },
+        [&presents]() { ++presents; });
+
+    // Uma rodada atrasada emula vários frames antes do teste de parada
+    EXPECT_GE(frames, 30u);
+    EXPECT_LE(frames, 30u + options.maxCatchUpFrames);
+    EXPECT_EQ(static_cast<uint64_t>(presents) + emulator.getSkippedPresents(), frames);
+}
+
+TEST_F(Chip8Test, RunCallsFrameHookForEveryEmulatedFrame) {
+    const double speeds[] = {0.0, 10.0};
+    for(double speed : speeds) {
+        emulator.initialize();
+        RunOptions options;
+        options.speed = speed;
+
+        // Cada chamada vê o frame já contado, um de cada vez
+        uint64_t hooks = 0;
+        bool inOrder = true;
+        uint64_t frames = emulator.run(options,
+            [this]() { return emulator.getFrameCount() < 30; },
+            std::function<void()>(),
+            [&]() { inOrder = inOrder && emulator.getFrameCount() == ++hooks; });
+
+        EXPECT_EQ(hooks, frames) << speed;
+        EXPECT_TRUE(inOrder) << speed;
+    }
+}
+
+TEST_F(Chip8Test, LoadROMFromBuffer) {
+    const uint8_t rom[] = {0x60, 0x2A};
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+    emulator.runFrame(1);
+    EXPECT_EQ(emulator.getRegisters().getV(0), 0x2A);
+    
+    std::vector<uint8_t> tooBig(4096);
+    EXPECT_FALSE(emulator.loadROM(tooBig.data(), tooBig.size()));
+}
+
+TEST_F(Chip8Test, RestoreSnapshotUndoesExecution) {
+    Chip8Snapshot pristine;
+    emulator.saveSnapshot(pristine);
+    
+    // 6005: V0 = 5; F029: I = fonte de V0; D015: desenha; 2200: recursão infinita
+    const uint8_t rom[] = {0x60, 0x05, 0xF0, 0x29, 0xD0, 0x15, 0x22, 0x00};
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+    emulator.getInput().postKey(3, true, 100);
+    emulator.runFrame(80);
+    ASSERT_TRUE(emulator.getRegisters().hasStackFault());
+    
+    emulator.restoreSnapshot(pristine);
+    EXPECT_EQ(emulator.getRegisters().getPC(), 0x200);
+    EXPECT_EQ(emulator.getRegisters().getV(0), 0);
+    EXPECT_FALSE(emulator.getRegisters().hasStackFault());
+    EXPECT_EQ(emulator.getMemory().read(0x200), 0);
+    EXPECT_EQ(emulator.getFrameCount(), 0u);
+    for(int i = 0; i < 64 * 32; ++i) {
+        ASSERT_EQ(emulator.getDisplay().getPixels()[i], 0);
+    }
+    // Eventos pendentes não sobrevivem ao restore
+    EXPECT_EQ(emulator.getInput().applyPending(1000), 0u);
+}
+
+TEST_F(Chip8Test, RunFrameCallsStepHookPerInstruction) {
+    const uint8_t rom[] = {0x60, 0x01, 0x61, 0x02, 0x12, 0x04};
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+    
+    std::vector<uint16_t> pcs;
+    const Registers& registers = emulator.getRegisters();
+    emulator.runFrame(4, [&]() { pcs.push_back(registers.getPC()); });
+    
+    ASSERT_EQ(pcs.size(), 4u);
+    EXPECT_EQ(pcs[0], 0x202);
+    EXPECT_EQ(pcs[1], 0x204);
+    EXPECT_EQ(pcs[2], 0x204);
+}
+
+TEST_F(Chip8Test, KeyWaitIsIdleUntilAKeyArrives) {
+    // 6128 LD V1,40 | F115 LD DT,V1 | F30A LD V3,K | 7401 ADD V4,1 | 1208 JP 208
+    const uint8_t rom[] = {0x61, 0x28, 0xF1, 0x15, 0xF3, 0x0A, 0x74, 0x01, 0x12, 0x08};
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+    RunOptions options;
+    uint32_t frames;
+
+    emulator.runFrame(options);
+    ASSERT_EQ(emulator.idleWait(options, frames), IdleWait::Key);
+    EXPECT_EQ(frames, UINT32_MAX);
+
+    Chip8Snapshot snapshot;
+    emulator.saveSnapshot(snapshot);
+    Chip8 emulated;
+    emulated.restoreSnapshot(snapshot);
+    for(int f = 0; f < 25; ++f) emulated.runFrame(options);
+    emulator.skipIdleFrames(25, options);
+    expectSameState(emulator, emulated);
+
+    // Tecla pendente ou pressionada: o próximo frame sai da espera
+    emulator.getInput().postKey(6, true);
+    EXPECT_EQ(emulator.idleWait(options, frames), IdleWait::None);
+    emulator.runFrame(options);
+    EXPECT_EQ(emulator.getRegisters().getV(3), 6);
+    EXPECT_EQ(emulator.idleWait(options, frames), IdleWait::None);
+}
+
+TEST_F(Chip8Test, TimerWaitSkipMatchesEmulationForAnyFrameSize) {
+    const uint32_t cycles[] = {3, 4, 5, 7, 10, 11, 12};
+    for(size_t c = 0; c < sizeof(cycles) / sizeof(cycles[0]); ++c) {
+        SCOPED_TRACE(cycles[c]);
+        RunOptions options;
+        options.cyclesPerFrame = cycles[c];
+
+        Chip8 skipped;
+        skipped.initialize();
+        ASSERT_TRUE(skipped.loadROM(TIMER_WAIT_ROM, sizeof(TIMER_WAIT_ROM)));
+        uint32_t frames = 0;
+        while(skipped.idleWait(options, frames) == IdleWait::None) {
+            ASSERT_LT(skipped.getFrameCount(), 10u);
+            skipped.runFrame(options);
+        }
+        ASSERT_EQ(frames, skipped.getRegisters().getDelayTimer() - 5u);
+
+        Chip8Snapshot snapshot;
+        skipped.saveSnapshot(snapshot);
+        Chip8 emulated;
+        emulated.restoreSnapshot(snapshot);
+
+        // Em dois pedaços (acordar cedo por tecla) e depois até o fim
+        skipped.skipIdleFrames(frames / 2, options);
+        uint32_t rest;
+        ASSERT_EQ(skipped.idleWait(options, rest), IdleWait::Timer);
+        EXPECT_EQ(rest, frames - frames / 2);
+        skipped.skipIdleFrames(rest, options);
+        for(uint32_t f = 0; f < frames; ++f) emulated.runFrame(options);
+        expectSameState(skipped, emulated);
+
+        // O laço sai no mesmo ponto do mesmo frame
+        EXPECT_NE(skipped.idleWait(options, rest), IdleWait::Timer);
+        for(int f = 0; f < 3; ++f) {
+            skipped.runFrame(options);
+            emulated.runFrame(options);
+        }
+        expectSameState(skipped, emulated);
+        EXPECT_GT(skipped.getRegisters().getV(3), 0);
+    }
+}
+
+TEST_F(Chip8Test, BusyCodeVipTimingAndTrapsAreNotIdle) {
+    ASSERT_TRUE(emulator.loadROM(TIMER_WAIT_ROM, sizeof(TIMER_WAIT_ROM)));
+    RunOptions options;
+    uint32_t frames;
+    EXPECT_EQ(emulator.idleWait(options, frames), IdleWait::None);     // Ainda no preâmbulo
+    emulator.runFrame(options);
+    ASSERT_EQ(emulator.idleWait(options, frames), IdleWait::Timer);
+
+    RunOptions vip;
+    vip.vipTiming = true;
+    EXPECT_EQ(emulator.idleWait(vip, frames), IdleWait::None);
+    RunOptions tiny;
+    tiny.cyclesPerFrame = 2;
+    EXPECT_EQ(emulator.idleWait(tiny, frames), IdleWait::None);
+
+    // Depois do laço: contando em V3, nunca ocioso
+    for(int f = 0; f < 60; ++f) emulator.runFrame(options);
+    EXPECT_EQ(emulator.idleWait(options, frames), IdleWait::None);
+
+    const uint8_t underflow[] = {0x00, 0xEE};
+    emulator.initialize();
+    ASSERT_TRUE(emulator.loadROM(underflow, sizeof(underflow)));
+    emulator.runFrame(options);
+    EXPECT_EQ(emulator.idleWait(options, frames), IdleWait::Halted);
+}
@@ -2,6 +2,7 @@
 // test_display.cpp - Display Module Tests
 // ============================================================================
 #include <gtest/gtest.h>
+#include <cstring>
 #include "Display.h"
 
 class DisplayTest : public ::testing::Test {
@@ -84,6 +85,19 @@ TEST_F(DisplayTest, XORDrawing) {
     EXPECT_EQ(pixels[0], 0);   // Pixel turned off
 }
 
+TEST_F(DisplayTest, XorSpriteDrawsWithoutCollision) {
+    const uint8_t sprite[2] = {0xF0, 0x99};
+    Display reference;
+    reference.drawSprite(62, 31, sprite, 2);
+    reference.drawSprite(60, 0, sprite, 2);
+    
+    display.xorSprite(62, 31, sprite, 2);
+    display.xorSprite(60, 0, sprite, 2);
+    
+    EXPECT_EQ(std::memcmp(display.getPixels(), reference.getPixels(), 64 * 32), 0);
+    EXPECT_TRUE(display.getNeedsRedraw());
+}
+
 TEST_F(DisplayTest, SpriteWrapping) {
     uint8_t sprite[1] = {0x80};
     
@@ -0,0 +1,149 @@
+// ============================================================================
+// test_frame_codec.cpp - Framebuffer Delta Codec Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "FrameCodec.h"
+
+namespace {
+
+const size_t PACKED = FrameCodec::PACKED_SIZE;
+
+// Desenha um sprite de 5 linhas em (x, y) num frame empacotado
+void drawSprite(uint8_t* packed, size_t x, size_t y, uint8_t value) {
+    for(size_t row = 0; row < 5; ++row) {
+        uint8_t* line = packed + (y + row) * FrameCodec::ROW_BYTES;
+        size_t shift = x % 8;
+        line[x / 8] ^= value >> shift;
+        if(shift && x / 8 + 1 < FrameCodec::ROW_BYTES) {
+            line[x / 8 + 1] ^= static_cast<uint8_t>(value << (8 - shift));
+        }
+    }
+}
+
+} // namespace
+
+TEST(FrameCodecTest, PackAndUnpackRoundTrip) {
+    uint8_t pixels[PACKED * 8] = {0};
+    pixels[0] = 1;
+    pixels[9] = 1;
+    pixels[PACKED * 8 - 1] = 1;
+
+    uint8_t packed[PACKED];
+    FrameCodec::packPixels(pixels, packed);
+    EXPECT_EQ(packed[0], 0x80);
+    EXPECT_EQ(packed[1], 0x40);
+    EXPECT_EQ(packed[PACKED - 1], 0x01);
+
+    uint8_t back[PACKED * 8];
+    FrameCodec::unpackPixels(packed, back);
+    EXPECT_EQ(std::memcmp(pixels, back, sizeof(back)), 0);
+}
+
+TEST(FrameCodecTest, SingleSpriteDeltaIsSmall) {
+    FrameEncoder encoder;
+    uint8_t frame[PACKED] = {0};
+    std::vector<uint8_t> out;
+    encoder.encodePacked(frame, out);               // Keyframe apagado
+    EXPECT_EQ(out.size(), FrameCodec::HEADER_SIZE);
+
+    drawSprite(frame, 8, 10, 0xF0);
+    out.clear();
+    encoder.encodePacked(frame, out);
+    EXPECT_EQ(out[0] & FrameCodec::FLAG_KEYFRAME, 0);
+    EXPECT_EQ(out.size(), FrameCodec::HEADER_SIZE + 5 * 2);
+
+    drawSprite(frame, 13, 20, 0xF0);                // Desalinhado: 2 bytes por linha
+    out.clear();
+    encoder.encodePacked(frame, out);
+    EXPECT_EQ(out.size(), FrameCodec::HEADER_SIZE + 5 * 3);
+}
+
+TEST(FrameCodecTest, DecoderReproducesEncodedFrames) {
+    FrameEncoder encoder(4);
+    FrameDecoder decoder;
+    uint8_t frame[PACKED] = {0};
+
+    for(int i = 0; i < 20; ++i) {
+        drawSprite(frame, (i * 7) % 60, (i * 3) % 27, static_cast<uint8_t>(0x81 + i));
+        std::vector<uint8_t> out;
+        encoder.encodePacked(frame, out);
+
+        size_t consumed;
+        ASSERT_EQ(decoder.decode(out.data(), out.size(), consumed), FrameDecodeStatus::Frame);
+        EXPECT_EQ(consumed, out.size());
+        EXPECT_EQ(std::memcmp(decoder.getPacked(), frame, PACKED), 0) << "frame " << i;
+        EXPECT_EQ(decoder.getSequence(), encoder.getSequence());
+    }
+}
+
+TEST(FrameCodecTest, StreamOfPacketsDecodesIncrementally) {
+    FrameEncoder encoder;
+    uint8_t frame[PACKED] = {0};
+    std::vector<uint8_t> stream;
+    for(int i = 0; i < 3; ++i) {
+        drawSprite(frame, i * 16, 4, 0xFF);
+        encoder.encodePacked(frame, stream);
+    }
+
+    // Bytes chegando um a um: cada pacote só é aceito quando completo
+    FrameDecoder decoder;
+    std::vector<uint8_t> received;
+    int frames = 0;
+    for(size_t i = 0; i < stream.size(); ++i) {
+        received.push_back(stream[i]);
+        size_t consumed;
+        FrameDecodeStatus status = decoder.decode(received.data(), received.size(), consumed);
+        if(status == FrameDecodeStatus::Frame) {
+            received.erase(received.begin(), received.begin() + consumed);
+            ++frames;
+        } else {
+            ASSERT_EQ(status, FrameDecodeStatus::Incomplete);
+        }
+    }
+    EXPECT_EQ(frames, 3);
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(std::memcmp(decoder.getPacked(), frame, PACKED), 0);
+}
+
+TEST(FrameCodecTest, LostPacketWaitsForKeyframe) {
+    FrameEncoder encoder(0);
+    FrameDecoder decoder;
+    uint8_t frame[PACKED] = {0};
+    std::vector<uint8_t> packet;
+    size_t consumed;
+
+    encoder.encodePacked(frame, packet);
+    ASSERT_EQ(decoder.decode(packet.data(), packet.size(), consumed), FrameDecodeStatus::Frame);
+
+    drawSprite(frame, 0, 0, 0xF0);
+    packet.clear();
+    encoder.encodePacked(frame, packet);            // Perdido
+
+    drawSprite(frame, 32, 0, 0xF0);
+    packet.clear();
+    encoder.encodePacked(frame, packet);
+    EXPECT_EQ(decoder.decode(packet.data(), packet.size(), consumed), FrameDecodeStatus::NeedKeyframe);
+    EXPECT_EQ(consumed, packet.size());
+    EXPECT_FALSE(decoder.isSynced());
+
+    encoder.requestKeyframe();
+    packet.clear();
+    encoder.encodePacked(frame, packet);
+    ASSERT_EQ(decoder.decode(packet.data(), packet.size(), consumed), FrameDecodeStatus::Frame);
+    EXPECT_EQ(std::memcmp(decoder.getPacked(), frame, PACKED), 0);
+}
+
+TEST(FrameCodecTest, RejectsCorruptPackets) {
+    FrameDecoder decoder;
+    size_t consumed;
+
+    const uint8_t badFlags[] = {0x02, 1, 0, 0, 0, 0, 0, 0, 0};
+    EXPECT_EQ(decoder.decode(badFlags, sizeof(badFlags), consumed), FrameDecodeStatus::Corrupt);
+
+    // Linha 0 com token que passa do fim da linha (pula 7, escreve 2)
+    const uint8_t overflow[] = {0x01, 1, 0, 0, 0, 1, 0, 0, 0, 0xF2, 0xAA, 0xBB};
+    EXPECT_EQ(decoder.decode(overflow, sizeof(overflow), consumed), FrameDecodeStatus::Corrupt);
+    EXPECT_EQ(consumed, 0u);
+}
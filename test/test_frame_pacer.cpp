@@ -0,0 +1,73 @@
+// ============================================================================
+// test_frame_pacer.cpp - Real-time Catch-up Pacing Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include "FramePacer.h"
+
+typedef FramePacer::Clock Clock;
+
+class FramePacerTest : public ::testing::Test {
+protected:
+    Clock::time_point t0;
+    
+    void SetUp() override {
+        t0 = Clock::now();
+    }
+};
+
+TEST_F(FramePacerTest, FirstFrameIsDueImmediately) {
+    FramePacer pacer;
+    pacer.start(t0);
+    EXPECT_EQ(pacer.framesDue(t0), 1u);
+}
+
+TEST_F(FramePacerTest, AheadOfScheduleRunsNothing) {
+    FramePacer pacer;
+    pacer.start(t0);
+    pacer.advance(1);
+    EXPECT_EQ(pacer.framesDue(t0 + pacer.getFramePeriod() / 2), 0u);
+    EXPECT_EQ(pacer.getNextFrameTime(), t0 + pacer.getFramePeriod());
+}
+
+TEST_F(FramePacerTest, BehindScheduleCatchesUpWithWholeFrames) {
+    FramePacer pacer;
+    pacer.start(t0);
+    Clock::duration period = pacer.getFramePeriod();
+
+    // 3.5 frames de atraso: roda 4 frames (0, 1, 2, 3)
+    EXPECT_EQ(pacer.framesDue(t0 + period * 3 + period / 2), 4u);
+    pacer.advance(4);
+    EXPECT_EQ(pacer.framesDue(t0 + period * 3 + period / 2), 0u);
+}
+
+TEST_F(FramePacerTest, SpeedMultiplierShortensPeriod) {
+    FramePacer normal(1.0);
+    FramePacer fast(4.0);
+    EXPECT_NEAR(static_cast<double>(normal.getFramePeriod().count()),
+                4.0 * fast.getFramePeriod().count(),
+                normal.getFramePeriod().count() * 0.001);
+}
+
+TEST_F(FramePacerTest, ResyncsWhenHopelesslyBehind) {
+    FramePacer pacer(1.0, 5);
+    pacer.start(t0);
+    Clock::time_point late = t0 + std::chrono::seconds(10);
+
+    EXPECT_EQ(pacer.framesDue(late), 5u);
+    EXPECT_EQ(pacer.getResyncCount(), 1u);
+    pacer.advance(5);
+    EXPECT_EQ(pacer.framesDue(late), 0u);
+}
+
+TEST_F(FramePacerTest, IdleSkipKeepsTheWholeSleepWithoutResync) {
+    FramePacer pacer(1.0, 5);
+    pacer.start(t0);
+    Clock::duration period = pacer.getFramePeriod();
+    Clock::time_point late = t0 + period * 600 + period / 2;
+
+    // Frames 0..599 passam sem emulação; o 600 ainda é devido
+    EXPECT_EQ(pacer.skipIdle(t0 - period), 0u);
+    EXPECT_EQ(pacer.skipIdle(late), 600u);
+    EXPECT_EQ(pacer.framesDue(late), 1u);
+    EXPECT_EQ(pacer.getResyncCount(), 0u);
+}
@@ -0,0 +1,118 @@
+// ============================================================================
+// test_frame_publisher.cpp - Triple-buffered Frame Publisher Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "FramePublisher.h"
+
+class FramePublisherTest : public ::testing::Test {
+protected:
+    FramePublisher publisher;
+    uint8_t pixels[Frame::PIXEL_COUNT];
+
+    void fill(uint8_t value) {
+        std::memset(pixels, value, sizeof(pixels));
+    }
+};
+
+TEST_F(FramePublisherTest, EmptyBeforeFirstPublish) {
+    FrameHandle handle = publisher.acquire();
+    EXPECT_FALSE(handle.valid());
+
+    Frame frame;
+    EXPECT_FALSE(publisher.copyLatest(frame));
+}
+
+TEST_F(FramePublisherTest, AcquireReturnsLatestFrame) {
+    fill(1);
+    EXPECT_TRUE(publisher.publish(pixels));
+    fill(2);
+    EXPECT_TRUE(publisher.publish(pixels));
+
+    FrameHandle handle = publisher.acquire();
+    ASSERT_TRUE(handle.valid());
+    EXPECT_EQ(handle->sequence, 2u);
+    EXPECT_EQ(handle->pixels[0], 2);
+}
+
+TEST_F(FramePublisherTest, HeldFrameIsNotOverwritten) {
+    fill(1);
+    publisher.publish(pixels);
+    FrameHandle held = publisher.acquire();
+
+    for(uint8_t i = 2; i < 10; ++i) {
+        fill(i);
+        EXPECT_TRUE(publisher.publish(pixels));
+    }
+
+    EXPECT_EQ(held->sequence, 1u);
+    EXPECT_EQ(held->pixels[Frame::PIXEL_COUNT - 1], 1);
+}
+
+TEST_F(FramePublisherTest, PublishFromDisplay) {
+    Display display;
+    uint8_t sprite[1] = {0x80};
+    display.drawSprite(0, 0, sprite, 1);
+
+    publisher.publish(display);
+    Frame frame;
+    ASSERT_TRUE(publisher.copyLatest(frame));
+    EXPECT_EQ(frame.pixels[0], 1);
+    EXPECT_EQ(frame.pixels[1], 0);
+}
+
+TEST_F(FramePublisherTest, DropsInsteadOfStallingWhenAllSlotsHeld) {
+    FramePublisher small(2);
+    fill(1);
+    small.publish(pixels);
+    FrameHandle first = small.acquire();
+    fill(2);
+    small.publish(pixels);
+    FrameHandle second = small.acquire();
+
+    fill(3);
+    EXPECT_FALSE(small.publish(pixels));
+    EXPECT_EQ(small.getDroppedFrames(), 1u);
+
+    first = FrameHandle();
+    EXPECT_TRUE(small.publish(pixels));
+}
+
+TEST_F(FramePublisherTest, ConcurrentReadersNeverSeeTornFrames) {
+    FramePublisher shared(5);
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+
+    std::vector<std::thread> readers;
+    for(int r = 0; r < 3; ++r) {
+        readers.push_back(std::thread([&]() {
+            while(!done.load()) {
+                FrameHandle handle = shared.acquire();
+                if(!handle) continue;
+                uint8_t expected = handle->sequence & 0xFF;
+                for(size_t i = 0; i < Frame::PIXEL_COUNT; ++i) {
+                    if(handle->pixels[i] != expected) {
+                        ++torn;
+                        break;
+                    }
+                }
+            }
+        }));
+    }
+
+    uint8_t frame[Frame::PIXEL_COUNT];
+    for(uint64_t seq = 1; seq <= 2000; ++seq) {
+        std::memset(frame, static_cast<int>(seq & 0xFF), sizeof(frame));
+        if(!shared.publish(frame)) {
+            std::this_thread::yield();
+        }
+    }
+    done = true;
+    for(size_t r = 0; r < readers.size(); ++r) {
+        readers[r].join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+}
@@ -0,0 +1,169 @@
+// ============================================================================
+// test_frame_scheduler.cpp - Soft Real-time EDF Scheduler Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FrameScheduler.h"
+
+namespace {
+
+// 200: 7001 ADD V0,1 | 202: 1200 JP 200
+const uint8_t BUSY_ROM[] = {0x70, 0x01, 0x12, 0x00};
+
+// 200: F10A LD V1,K | 202: 1202 JP 202
+const uint8_t KEY_ROM[] = {0xF1, 0x0A, 0x12, 0x02};
+
+FrameSchedulerOptions unpinned(size_t workers) {
+    FrameSchedulerOptions options;
+    options.workerThreads = workers;
+    options.pinWorkers = false;
+    return options;
+}
+
+RunOptions atSpeed(double speed) {
+    RunOptions options;
+    options.speed = speed;
+    return options;
+}
+
+} // namespace
+
+TEST(FrameSchedulerTest, SessionsProduceFramesAtTheirRate) {
+    FrameScheduler scheduler(unpinned(2));
+    std::vector<uint32_t> ids;
+    for(int i = 0; i < 8; ++i) {
+        ids.push_back(scheduler.addSession(BUSY_ROM, sizeof(BUSY_ROM), atSpeed(10.0)));
+        ASSERT_NE(ids.back(), 0u);
+    }
+    EXPECT_EQ(scheduler.getSessionCount(), 8u);
+
+    FramePacer::Clock::time_point begin = FramePacer::Clock::now();
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    scheduler.stop();
+    double elapsed = std::chrono::duration<double>(FramePacer::Clock::now() - begin).count();
+
+    // 600 frames/s por ~0,3 s: nunca adiantado (o sleep pode passar do
+    // tempo, daí o relógio medido), e sem ficar muito para trás
+    for(size_t i = 0; i < ids.size(); ++i) {
+        FrameStats stats;
+        ASSERT_TRUE(scheduler.getStats(ids[i], stats));
+        EXPECT_LE(stats.frames, static_cast<uint64_t>(elapsed * 600.0) + 2);
+        EXPECT_GE(stats.frames, 90u);
+    }
+    EXPECT_GE(scheduler.getTotals().frames, 8u * 90u);
+}
+
+TEST(FrameSchedulerTest, EarliestDeadlineRunsFirst) {
+    std::mutex mutex;
+    std::vector<uint32_t> order;
+    FrameScheduler scheduler(unpinned(1), [&](uint32_t session, Chip8&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(session);
+    });
+
+    // Liberadas juntas: a de período menor tem o deadline mais cedo
+    uint32_t slow = scheduler.addSession(BUSY_ROM, sizeof(BUSY_ROM), atSpeed(1.0));
+    uint32_t fast = scheduler.addSession(BUSY_ROM, sizeof(BUSY_ROM), atSpeed(4.0));
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scheduler.stop();
+
+    ASSERT_GE(order.size(), 2u);
+    EXPECT_EQ(order[0], fast);
+    EXPECT_EQ(order[1], slow);
+
+    // Só frames liberados rodam: ~4 rápidos para cada lento
+    FrameStats slowStats, fastStats;
+    ASSERT_TRUE(scheduler.getStats(slow, slowStats));
+    ASSERT_TRUE(scheduler.getStats(fast, fastStats));
+    EXPECT_GE(fastStats.frames, 3 * slowStats.frames);
+}
+
+TEST(FrameSchedulerTest, OverloadReportsMissesJitterAndDrops) {
+    FrameSchedulerOptions options = unpinned(1);
+    options.maxLateFrames = 2;
+    FrameScheduler scheduler(options, [](uint32_t, Chip8&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));     // Frame de 5 ms
+    });
+
+    uint32_t id = scheduler.addSession(BUSY_ROM, sizeof(BUSY_ROM), atSpeed(10.0));  // Período de 1,7 ms
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    scheduler.stop();
+
+    FrameStats stats;
+    ASSERT_TRUE(scheduler.getStats(id, stats));
+    ASSERT_GT(stats.frames, 2u);
+    EXPECT_EQ(stats.misses, stats.frames);
+    EXPECT_GT(stats.dropped, 0u);
+    EXPECT_GT(stats.worstLateness, 0);
+    EXPECT_GT(stats.jitter, 0);
+}
+
+TEST(FrameSchedulerTest, KeysReachTheSessionMachine) {
+    std::atomic<int> pressed(-1);
+    FrameScheduler scheduler(unpinned(2), [&](uint32_t, Chip8& machine) {
+        if(machine.getRegisters().getPC() == 0x202) pressed.store(machine.getRegisters().getV(1));
+    });
+    uint32_t id = scheduler.addSession(KEY_ROM, sizeof(KEY_ROM), atSpeed(10.0));
+    scheduler.start();
+
+    EXPECT_TRUE(scheduler.postKey(id, 9, true));
+    EXPECT_FALSE(scheduler.postKey(id + 1, 9, true));
+    for(int i = 0; i < 500 && pressed.load() < 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    scheduler.stop();
+    EXPECT_EQ(pressed.load(), 9);
+}
+
+TEST(FrameSchedulerTest, RemovedSessionStopsRunning) {
+    std::atomic<uint64_t> frames(0);
+    FrameScheduler scheduler(unpinned(2), [&](uint32_t, Chip8&) { ++frames; });
+    uint32_t id = scheduler.addSession(BUSY_ROM, sizeof(BUSY_ROM), atSpeed(10.0));
+    scheduler.start();
+    for(int i = 0; i < 500 && frames.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_TRUE(scheduler.removeSession(id));
+    EXPECT_FALSE(scheduler.removeSession(id));
+    EXPECT_EQ(scheduler.getSessionCount(), 0u);
+    FrameStats stats;
+    EXPECT_FALSE(scheduler.getStats(id, stats));
+
+    // No máximo o frame que estava rodando termina
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    uint64_t after = frames.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(frames.load(), after);
+    scheduler.stop();
+}
+
+TEST(FrameSchedulerTest, InvalidRomIsRejected) {
+    FrameScheduler scheduler(unpinned(1));
+    std::vector<uint8_t> huge(4096, 0);
+    EXPECT_EQ(scheduler.addSession(huge.data(), huge.size()), 0u);
+    EXPECT_EQ(scheduler.addSession(BUSY_ROM, 0), 0u);
+    EXPECT_EQ(scheduler.getSessionCount(), 0u);
+}
+
+TEST(FrameSchedulerTest, PinnedWorkersReportAffinity) {
+    FrameSchedulerOptions options;
+    options.workerThreads = 2;
+    FrameScheduler scheduler(options);
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler.stop();
+#ifdef __linux__
+    EXPECT_TRUE(scheduler.isPinned());
+#else
+    EXPECT_FALSE(scheduler.isPinned());
+#endif
+}
@@ -0,0 +1,138 @@
+// ============================================================================
+// test_golden.cpp - GoldenSuite Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "GoldenSuite.h"
+
+namespace {
+
+// As mesmas ROMs que test/roms/*.ch8 dá ao chip8-golden
+std::vector<GoldenCase> corpus() {
+    std::vector<GoldenCase> cases = GoldenSuite::builtinCases();
+    EXPECT_TRUE(GoldenSuite::addRomFile(CHIP8_TEST_DIR "/roms/dead_flags.ch8", cases));
+    EXPECT_TRUE(GoldenSuite::addRomFile(CHIP8_TEST_DIR "/roms/recompiler_sample.ch8", cases));
+    return cases;
+}
+
+bool sameResults(const std::vector<GoldenResult>& a, const std::vector<GoldenResult>& b) {
+    if(a.size() != b.size()) return false;
+    for(size_t i = 0; i < a.size(); ++i) {
+        if(a[i].name != b[i].name || a[i].frameHash != b[i].frameHash ||
+           a[i].stateHash != b[i].stateHash || a[i].trap != b[i].trap) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// Divergência aqui é mudança de comportamento: se for intencional, regrave
+// com chip8-golden test/golden/builtin.golden -u test/roms/*.ch8
+TEST(GoldenTest, CorpusMatchesCommittedGoldens) {
+    GoldenTable table;
+    ASSERT_TRUE(GoldenSuite::load(CHIP8_TEST_DIR "/golden/builtin.golden", table));
+
+    std::vector<GoldenCase> cases = corpus();
+    ASSERT_EQ(cases.size(), table.size());
+
+    std::string report;
+    EXPECT_EQ(GoldenSuite::compare(GoldenSuite::runAll(cases), table, report), 0u) << report;
+}
+
+TEST(GoldenTest, OpcodeChecksAllPass) {
+    // Cada verificação desenha C ou E numa grade de 12 colunas (glifos em
+    // x = 5c + 2, y = 6l + 1). Só a linha do meio distingue: C é "#...",
+    // E é "####". Contar os C impede que um -u esconda uma verificação.
+    const size_t OPCODE_CHECKS = 44;
+    std::vector<GoldenCase> cases = GoldenSuite::builtinCases();
+    Chip8 machine;
+    GoldenSuite::run(cases[0], machine);
+    ASSERT_EQ(machine.getTrap(), Trap::None);
+
+    std::string frame = GoldenSuite::renderFrame(machine.getDisplay());
+    const size_t stride = Display::getWidth() + 1;
+    size_t passed = 0;
+    size_t failed = 0;
+    bool gridEnded = false;
+    for(size_t y = 3; y < Display::getHeight(); y += 6) {
+        for(size_t column = 0; column < 12; ++column) {
+            std::string cell = frame.substr(y * stride + column * 5 + 2, 4);
+            if(cell == "....") {
+                gridEnded = true;
+            } else {
+                EXPECT_FALSE(gridEnded) << "glifo depois do fim da grade, linha " << y;
+                if(cell == "#...") {
+                    ++passed;
+                } else {
+                    ++failed;
+                    ADD_FAILURE() << "verificação " << (y / 6) * 12 + column << " desenhou " << cell;
+                }
+            }
+        }
+    }
+    EXPECT_EQ(failed, 0u);
+    EXPECT_EQ(passed, OPCODE_CHECKS);
+}
+
+TEST(GoldenTest, ResultsDoNotDependOnJobCount) {
+    std::vector<GoldenCase> cases = corpus();
+    EXPECT_TRUE(sameResults(GoldenSuite::runAll(cases, 1), GoldenSuite::runAll(cases, 4)));
+}
+
+TEST(GoldenTest, TrapCasesReportTheirTrap) {
+    std::vector<GoldenResult> results = GoldenSuite::runAll(GoldenSuite::builtinCases());
+    GoldenTable byName;
+    for(size_t i = 0; i < results.size(); ++i) byName[results[i].name] = results[i];
+
+    EXPECT_EQ(byName["trap_stack_overflow"].trap, Trap::StackOverflow);
+    EXPECT_EQ(byName["trap_invalid_opcode"].trap, Trap::InvalidOpcode);
+    EXPECT_EQ(byName["trap_pc_out_of_range"].trap, Trap::PcOutOfRange);
+    EXPECT_EQ(byName["opcodes"].trap, Trap::None);
+}
+
+TEST(GoldenTest, ChangedInputIsDetected) {
+    std::vector<GoldenCase> cases = GoldenSuite::builtinCases();
+    GoldenCase keypad;
+    for(size_t i = 0; i < cases.size(); ++i) {
+        if(cases[i].name == "keypad") keypad = cases[i];
+    }
+    ASSERT_FALSE(keypad.input.empty());
+    GoldenResult expected = GoldenSuite::run(keypad);
+
+    keypad.input[0].keyMask = 1 << 0x6;
+    GoldenResult changed = GoldenSuite::run(keypad);
+
+    GoldenTable table;
+    table[expected.name] = expected;
+    std::string report;
+    EXPECT_EQ(GoldenSuite::compare(std::vector<GoldenResult>(1, changed), table, report), 1u);
+    EXPECT_NE(report.find("keypad: tela"), std::string::npos);
+}
+
+TEST(GoldenTest, MissingGoldenIsAFailure) {
+    std::vector<GoldenResult> results(1);
+    results[0].name = "nova_rom";
+    std::string report;
+    EXPECT_EQ(GoldenSuite::compare(results, GoldenTable(), report), 1u);
+    EXPECT_EQ(report, "nova_rom: sem golden\n");
+}
+
+TEST(GoldenTest, SaveAndLoadRoundTrip) {
+    std::vector<GoldenCase> cases = GoldenSuite::builtinCases();
+    cases.resize(3);
+    std::vector<GoldenResult> results = GoldenSuite::runAll(cases, 2);
+
+    const std::string path = "golden_roundtrip.golden";
+    ASSERT_TRUE(GoldenSuite::save(path, results));
+    GoldenTable table;
+    ASSERT_TRUE(GoldenSuite::load(path, table));
+    std::remove(path.c_str());
+
+    std::string report;
+    EXPECT_EQ(GoldenSuite::compare(results, table, report), 0u) << report;
+}
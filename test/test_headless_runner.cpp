@@ -0,0 +1,213 @@
+// ============================================================================
+// test_headless_runner.cpp - HeadlessRunner Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "HeadlessRunner.h"
+
+namespace {
+
+void load(Chip8& machine, const std::vector<uint8_t>& rom) {
+    machine.initialize();
+    ASSERT_TRUE(machine.loadROM(rom.data(), rom.size()));
+}
+
+// V0 = 0; laço V0 += 1
+const std::vector<uint8_t> COUNTER = {0x60, 0x00, 0x70, 0x01, 0x12, 0x02};
+
+// V0 = 5; I = 0x300; BCD de V0 em 0x300..0x302; laço em 0x206
+const std::vector<uint8_t> BCD_THEN_HALT = {0x60, 0x05, 0xA3, 0x00, 0xF0, 0x33, 0x12, 0x06};
+
+// Um dígito da fonte por volta do laço, cada um 6 pixels à direita e abaixo
+const std::vector<uint8_t> DIGITS = {
+    0x60, 0x00, 0x6A, 0x00, 0xF0, 0x29, 0xDA, 0xA5,
+    0x70, 0x01, 0x7A, 0x06, 0x12, 0x04
+};
+
+} // namespace
+
+TEST(HeadlessRunnerTest, StopsAfterFrameLimit) {
+    Chip8 machine;
+    load(machine, COUNTER);
+    RunnerOptions options;
+    options.maxFrames = 5;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Frames);
+    EXPECT_EQ(result.frames, 5u);
+    EXPECT_EQ(result.cycles, 50u);
+    EXPECT_EQ(machine.getFrameCount(), 5u);
+}
+
+TEST(HeadlessRunnerTest, CycleLimitEndsInPartialFrame) {
+    Chip8 machine;
+    load(machine, COUNTER);
+    RunnerOptions options;
+    options.maxCycles = 25;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Cycles);
+    EXPECT_EQ(result.frames, 2u);
+    EXPECT_EQ(result.cycles, 25u);
+    EXPECT_EQ(machine.getFrameCount(), 2u);
+    // 1 atribuição + 12 pares soma/salto
+    EXPECT_EQ(machine.getRegisters().getV(0), 12);
+}
+
+TEST(HeadlessRunnerTest, StopsExactlyAtPc) {
+    Chip8 machine;
+    load(machine, COUNTER);
+    RunnerOptions options;
+    options.maxFrames = 100;
+    options.stopAtPc = true;
+    options.pc = 0x204;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Pc);
+    EXPECT_EQ(result.cycles, 2u);
+    EXPECT_EQ(result.frames, 0u);
+    EXPECT_EQ(machine.getRegisters().getPC(), 0x204);
+    EXPECT_EQ(machine.getRegisters().getV(0), 1);
+}
+
+TEST(HeadlessRunnerTest, StopsWhenMemoryMatches) {
+    Chip8 machine;
+    load(machine, BCD_THEN_HALT);
+    RunnerOptions options;
+    options.stopOnMemory = true;
+    options.memoryAddress = 0x302;
+    options.memoryValue = 5;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Memory);
+    EXPECT_EQ(result.cycles, 3u);
+    EXPECT_EQ(machine.getRegisters().getPC(), 0x206);
+}
+
+TEST(HeadlessRunnerTest, DetectsSelfJumpAtFrameEnd) {
+    Chip8 machine;
+    load(machine, BCD_THEN_HALT);
+    RunnerOptions options;
+    options.maxFrames = 100;
+    options.stopOnHalt = true;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Halt);
+    EXPECT_EQ(result.frames, 1u);
+    EXPECT_EQ(result.cycles, 10u);
+    EXPECT_TRUE(HeadlessRunner::isHalted(machine));
+}
+
+TEST(HeadlessRunnerTest, StopsOnFrameHash) {
+    RunnerOptions options;
+    options.cyclesPerFrame = 5;
+    options.maxFrames = 3;
+
+    Chip8 reference;
+    load(reference, DIGITS);
+    HeadlessRunner::run(reference, options);
+    uint64_t hash = HeadlessRunner::frameHash(reference.getDisplay());
+
+    Chip8 machine;
+    load(machine, DIGITS);
+    options.maxFrames = 100;
+    options.stopOnFrameHash = true;
+    options.frameHash = hash;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::FrameHash);
+    EXPECT_EQ(result.frames, 3u);
+    EXPECT_EQ(machine.getRegisters().getV(0), reference.getRegisters().getV(0));
+}
+
+TEST(HeadlessRunnerTest, StopsOnTrap) {
+    Chip8 machine;
+    load(machine, std::vector<uint8_t>{0x00, 0xEE});
+    RunnerOptions options;
+    options.maxFrames = 10;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Trap);
+    EXPECT_EQ(result.frames, 1u);
+    EXPECT_EQ(machine.getTrap(), Trap::StackUnderflow);
+}
+
+TEST(HeadlessRunnerTest, HooksSeeEveryInstructionAndFrame) {
+    RunnerOptions options;
+    options.maxCycles = 47;
+    for(int perInstruction = 0; perInstruction < 2; ++perInstruction) {
+        Chip8 machine;
+        load(machine, COUNTER);
+        options.stopAtPc = perInstruction != 0;
+        options.pc = 0xFFE;       // Nunca atingido
+
+        uint64_t steps = 0, frames = 0;
+        RunnerResult result = HeadlessRunner::run(machine, options,
+                                                  [&]() { ++steps; },
+                                                  [&](bool) { ++frames; });
+        EXPECT_EQ(result.cycles, 47u);
+        EXPECT_EQ(steps, 47u);
+        EXPECT_EQ(frames, 4u);
+    }
+}
+
+TEST(HeadlessRunnerTest, InputScriptDrivesKeys) {
+    std::istringstream script(
+        "# frame tecla ação\n"
+        "4 7 up\n"
+        "\n"
+        "3 7 down   # espera do FX0A\n");
+    RunnerOptions options;
+    ASSERT_TRUE(HeadlessRunner::parseInputScript(script, options.input));
+    ASSERT_EQ(options.input.size(), 2u);
+    EXPECT_EQ(options.input[0].frame, 3u);
+    EXPECT_TRUE(options.input[0].pressed);
+    EXPECT_EQ(options.input[1].frame, 4u);
+
+    // V0 = tecla; laço em 0x202
+    Chip8 machine;
+    load(machine, std::vector<uint8_t>{0xF0, 0x0A, 0x12, 0x02});
+    options.maxFrames = 100;
+    options.stopOnHalt = true;
+
+    RunnerResult result = HeadlessRunner::run(machine, options);
+    EXPECT_EQ(result.exit, RunnerExit::Halt);
+    EXPECT_EQ(result.frames, 4u);
+    EXPECT_EQ(machine.getRegisters().getV(0), 7);
+}
+
+TEST(HeadlessRunnerTest, RejectsInvalidScriptLines) {
+    const char* invalid[] = {"1 G down", "x 1 down", "1 2 press", "1 2", "1 2 down extra", "-1 2 up"};
+    for(const char* line : invalid) {
+        std::istringstream script(line);
+        std::vector<RunnerKeyEvent> events;
+        EXPECT_FALSE(HeadlessRunner::parseInputScript(script, events)) << line;
+    }
+}
+
+TEST(HeadlessRunnerTest, DumpsStateAsJson) {
+    Chip8 machine;
+    load(machine, BCD_THEN_HALT);
+    RunnerOptions options;
+    options.stopOnHalt = true;
+    RunnerResult result = HeadlessRunner::run(machine, options);
+
+    std::ostringstream out;
+    HeadlessRunner::dumpJson(machine, result, out);
+    std::string json = out.str();
+    EXPECT_NE(json.find("\"exit\": \"halt\""), std::string::npos);
+    EXPECT_NE(json.find("\"pc\": 518"), std::string::npos);
+    EXPECT_NE(json.find("\"i\": 768"), std::string::npos);
+    EXPECT_NE(json.find("\"v\": [5, 0,"), std::string::npos);
+    EXPECT_NE(json.find("\"display\": [\n    \"" + std::string(64, '0') + "\""), std::string::npos);
+
+    // Memória: 4096 bytes em hex, ROM em 0x200 e o BCD em 0x300
+    size_t start = json.find("\"memory\": \"") + 11;
+    size_t end = json.find('"', start);
+    ASSERT_EQ(end - start, 8192u);
+    EXPECT_EQ(json.substr(start + 0x200 * 2, 16), "6005a300f0331206");
+    EXPECT_EQ(json.substr(start + 0x300 * 2, 6), "000005");
+}
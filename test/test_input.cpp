@@ -65,4 +65,47 @@ TEST_F(InputTest, InvalidKeyIndex) {
     input.setKey(16, true);
     input.setKey(100, true);
     // No crash = pass
-}
\ No newline at end of file
+}
+TEST_F(InputTest, KeyMaskPacking) {
+    input.setKey(0, true);
+    input.setKey(15, true);
+    EXPECT_EQ(input.getKeyMask(), 0x8001);
+
+    input.setKeyMask(0x0010);
+    EXPECT_TRUE(input.isKeyPressed(4));
+    EXPECT_EQ(input.getAnyKeyPressed(), 4);
+}
+
+TEST_F(InputTest, PostedEventsApplyOnlyAtBoundary) {
+    EXPECT_TRUE(input.postKey(3, true, 0));
+    EXPECT_FALSE(input.isKeyPressed(3));
+
+    EXPECT_EQ(input.applyPending(0), 1u);
+    EXPECT_TRUE(input.isKeyPressed(3));
+}
+
+TEST_F(InputTest, FutureEventsStayQueued) {
+    input.postKey(1, true, 10);
+    input.postKey(1, false, 20);
+
+    EXPECT_EQ(input.applyPending(9), 0u);
+    EXPECT_FALSE(input.isKeyPressed(1));
+
+    EXPECT_EQ(input.applyPending(10), 1u);
+    EXPECT_TRUE(input.isKeyPressed(1));
+
+    EXPECT_EQ(input.applyPending(25), 1u);
+    EXPECT_FALSE(input.isKeyPressed(1));
+}
+
+TEST_F(InputTest, PostRejectsInvalidKey) {
+    EXPECT_FALSE(input.postKey(16, true));
+    EXPECT_EQ(input.applyPending(0), 0u);
+}
+
+TEST_F(InputTest, ClearDiscardsPendingEvents) {
+    input.postKey(2, true);
+    input.clear();
+    EXPECT_EQ(input.applyPending(0), 0u);
+    EXPECT_FALSE(input.isKeyPressed(2));
+}
@@ -0,0 +1,254 @@
+// ============================================================================
+// test_instruction_trace.cpp - Instruction Trace Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Chip8.h"
+#include "InstructionTrace.h"
+
+namespace {
+
+// 200: 6305 LD V3,5    | 202: A300 LD I,300 | 204: F333 LD B,V3
+// 206: F315 LD DT,V3   | 208: 220C CALL 20C | 20A: 120A JP 20A
+// 20C: 00EE RET
+const std::vector<uint8_t> EFFECTS_ROM = {
+    0x63, 0x05, 0xA3, 0x00, 0xF3, 0x33, 0xF3, 0x15, 0x22, 0x0C, 0x12, 0x0A, 0x00, 0xEE
+};
+
+// 200: 7001 ADD V0,1 | 202: 1200 JP 200
+const std::vector<uint8_t> COUNTER_ROM = {0x70, 0x01, 0x12, 0x00};
+
+// 200: 6001 LD V0,1 | 202: FFFF (inválido)
+const std::vector<uint8_t> TRAP_ROM = {0x60, 0x01, 0xFF, 0xFF};
+
+const char* LINEAR_PATH = "instruction_trace_test.trace";
+const char* RING_PATH = "instruction_trace_test_ring.trace";
+const char* OTHER_PATH = "instruction_trace_test_other.trace";
+
+// Roda a ROM gravando frames * cycles instruções
+bool traceRom(const std::vector<uint8_t>& rom, const char* path, uint64_t ring,
+              uint32_t frames, uint32_t cycles) {
+    Chip8 machine;
+    machine.initialize();
+    if(!machine.loadROM(rom.data(), rom.size())) return false;
+
+    TraceWriter writer;
+    if(!writer.open(path, ring)) return false;
+    InstructionTracer<Chip8> tracer(writer, machine);
+    for(uint32_t f = 0; f < frames; ++f) {
+        machine.runFrame(cycles, [&]() { tracer.step(); });
+    }
+    return writer.close();
+}
+
+std::vector<InstructionRecord> readAll(const char* path) {
+    std::vector<InstructionRecord> records;
+    TraceReader reader;
+    InstructionRecord record;
+    if(!reader.open(path)) return records;
+    while(reader.next(record)) records.push_back(record);
+    return records;
+}
+
+class InstructionTraceTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(LINEAR_PATH);
+        std::remove(RING_PATH);
+        std::remove(OTHER_PATH);
+    }
+};
+
+} // namespace
+
+TEST_F(InstructionTraceTest, LinearTraceKeepsEveryInstructionInOrder) {
+    // Mais que um bloco de gravação
+    ASSERT_TRUE(traceRom(COUNTER_ROM, LINEAR_PATH, 0, 500, 10));
+
+    TraceReader reader;
+    ASSERT_TRUE(reader.open(LINEAR_PATH));
+    EXPECT_FALSE(reader.isRing());
+    EXPECT_EQ(reader.size(), 5000u);
+    EXPECT_EQ(reader.getTotal(), 5000u);
+
+    InstructionRecord record;
+    for(uint64_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(reader.next(record));
+        ASSERT_EQ(record.getCycle(), i);
+        ASSERT_EQ(record.pc, i % 2 ? 0x202 : 0x200);
+    }
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(InstructionTraceTest, RingKeepsTheMostRecentRecords) {
+    // 100 pede 128 slots; 1000 instruções dão a volta várias vezes
+    ASSERT_TRUE(traceRom(COUNTER_ROM, RING_PATH, 100, 100, 10));
+
+    TraceReader reader;
+    ASSERT_TRUE(reader.open(RING_PATH));
+    EXPECT_TRUE(reader.isRing());
+    EXPECT_EQ(reader.size(), 128u);
+    EXPECT_EQ(reader.getTotal(), 1000u);
+
+    std::vector<InstructionRecord> records = readAll(RING_PATH);
+    ASSERT_EQ(records.size(), 128u);
+    for(size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].getCycle(), 1000u - 128u + i);
+    }
+    // 7001 nos ciclos pares: V0 = ciclo / 2 + 1 (mod 256)
+    EXPECT_EQ(records.back().getCycle(), 999u);
+    EXPECT_EQ(records[0].opcode, 0x7001);
+    EXPECT_EQ(records[0].value, (records[0].getCycle() / 2 + 1) & 0xFF);
+}
+
+TEST_F(InstructionTraceTest, RingSmallerThanRunIsReadableBeforeWrapping) {
+    ASSERT_TRUE(traceRom(COUNTER_ROM, RING_PATH, 64, 1, 10));
+    std::vector<InstructionRecord> records = readAll(RING_PATH);
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(records[0].getCycle(), 0u);
+    EXPECT_EQ(records[9].getCycle(), 9u);
+}
+
+TEST_F(InstructionTraceTest, RejectsRingAboveMaximum) {
+    TraceWriter writer;
+    EXPECT_FALSE(writer.open(RING_PATH, TraceWriter::MAX_RING_RECORDS + 1));
+    EXPECT_FALSE(writer.open(RING_PATH, UINT64_MAX));
+    EXPECT_FALSE(writer.isOpen());
+}
+
+TEST_F(InstructionTraceTest, RecordsChangedRegisterAndMemoryWrites) {
+    ASSERT_TRUE(traceRom(EFFECTS_ROM, LINEAR_PATH, 0, 1, 7));
+    std::vector<InstructionRecord> records = readAll(LINEAR_PATH);
+    ASSERT_EQ(records.size(), 7u);
+
+    EXPECT_EQ(records[0].getRegister(), 3);
+    EXPECT_EQ(records[0].value, 5);
+    EXPECT_FALSE(records[0].wroteMemory());
+
+    EXPECT_EQ(records[1].getRegister(), InstructionRecord::REG_I);
+    EXPECT_EQ(records[1].value, 0x300);
+
+    // BCD de 5: [300..302] = 0, 0, 5
+    EXPECT_EQ(records[2].getRegister(), InstructionRecord::NO_REGISTER);
+    ASSERT_TRUE(records[2].wroteMemory());
+    EXPECT_EQ(records[2].getMemoryAddress(), 0x300);
+    EXPECT_EQ(records[2].getMemoryCount(), 3u);
+    EXPECT_EQ(records[2].memoryValue, 0);
+
+    EXPECT_EQ(records[3].getRegister(), InstructionRecord::REG_DT);
+    EXPECT_EQ(records[3].value, 5);
+
+    EXPECT_EQ(records[4].pc, 0x208);
+    EXPECT_EQ(records[4].getRegister(), InstructionRecord::REG_SP);
+    EXPECT_EQ(records[4].value, 1);
+    EXPECT_EQ(records[5].pc, 0x20C);
+    EXPECT_EQ(records[5].value, 0);
+
+    EXPECT_EQ(records[6].pc, 0x20A);
+    EXPECT_EQ(records[6].getRegister(), InstructionRecord::NO_REGISTER);
+}
+
+TEST_F(InstructionTraceTest, TrapIsRecordedOnce) {
+    ASSERT_TRUE(traceRom(TRAP_ROM, LINEAR_PATH, 0, 3, 10));
+    std::vector<InstructionRecord> records = readAll(LINEAR_PATH);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].pc, 0x202);
+    EXPECT_EQ(records[1].opcode, 0xFFFF);
+    EXPECT_EQ(records[1].getRegister(), InstructionRecord::NO_REGISTER);
+}
+
+TEST_F(InstructionTraceTest, FilterSelectsPcAndOpcodeRanges) {
+    ASSERT_TRUE(traceRom(EFFECTS_ROM, LINEAR_PATH, 0, 1, 7));
+    std::vector<InstructionRecord> records = readAll(LINEAR_PATH);
+
+    TraceFilter filter;
+    filter.opcodeFirst = 0xF000;
+    size_t fx = 0;
+    for(size_t i = 0; i < records.size(); ++i) fx += filter.matches(records[i]);
+    EXPECT_EQ(fx, 2u);
+
+    filter = TraceFilter();
+    filter.pcFirst = 0x208;
+    filter.pcLast = 0x20A;
+    size_t inRange = 0;
+    for(size_t i = 0; i < records.size(); ++i) inRange += filter.matches(records[i]);
+    EXPECT_EQ(inRange, 2u);
+}
+
+TEST_F(InstructionTraceTest, FormatShowsMnemonicAndEffects) {
+    ASSERT_TRUE(traceRom(EFFECTS_ROM, LINEAR_PATH, 0, 1, 3));
+    std::vector<InstructionRecord> records = readAll(LINEAR_PATH);
+    ASSERT_EQ(records.size(), 3u);
+
+    std::ostringstream out;
+    for(size_t i = 0; i < records.size(); ++i) InstructionTrace::formatRecord(out, records[i]);
+    std::string text = out.str();
+    EXPECT_NE(text.find("LD V3, 0x05"), std::string::npos);
+    EXPECT_NE(text.find("V3=05"), std::string::npos);
+    EXPECT_NE(text.find("I=300"), std::string::npos);
+    EXPECT_NE(text.find("LD B, V3"), std::string::npos);
+    EXPECT_NE(text.find("[300+3]=00"), std::string::npos);
+
+    EXPECT_EQ(InstructionTrace::disassemble(0xD125), "DRW V1, V2, 5");
+    EXPECT_EQ(InstructionTrace::disassemble(0x8AB7), "SUBN VA, VB");
+    EXPECT_EQ(InstructionTrace::disassemble(0x8008), "DW 0x8008");
+}
+
+TEST_F(InstructionTraceTest, DiffFindsFirstDivergenceWithContext) {
+    ASSERT_TRUE(traceRom(COUNTER_ROM, LINEAR_PATH, 0, 2, 10));
+    ASSERT_TRUE(traceRom(COUNTER_ROM, OTHER_PATH, 0, 2, 10));
+
+    TraceDivergence divergence;
+    {
+        TraceReader a, b;
+        ASSERT_TRUE(a.open(LINEAR_PATH));
+        ASSERT_TRUE(b.open(OTHER_PATH));
+        EXPECT_TRUE(InstructionTrace::diff(a, b, divergence));
+    }
+
+    // Mesma ROM com V0 começando em outro valor: diverge no primeiro ADD
+    std::vector<uint8_t> shifted = {0x60, 0x10, 0x70, 0x01, 0x12, 0x02};
+    ASSERT_TRUE(traceRom(shifted, OTHER_PATH, 0, 1, 5));
+    std::vector<uint8_t> plain = {0x60, 0x00, 0x70, 0x01, 0x12, 0x02};
+    ASSERT_TRUE(traceRom(plain, LINEAR_PATH, 0, 1, 5));
+
+    TraceReader a, b;
+    ASSERT_TRUE(a.open(LINEAR_PATH));
+    ASSERT_TRUE(b.open(OTHER_PATH));
+    EXPECT_FALSE(InstructionTrace::diff(a, b, divergence, 4));
+    EXPECT_EQ(divergence.index, 0u);       // LD V0 já difere no opcode
+    EXPECT_TRUE(divergence.context.empty());
+    EXPECT_EQ(divergence.first.opcode, 0x6000);
+    EXPECT_EQ(divergence.second.opcode, 0x6010);
+}
+
+TEST_F(InstructionTraceTest, DiffReportsTheShorterTrace) {
+    ASSERT_TRUE(traceRom(COUNTER_ROM, LINEAR_PATH, 0, 1, 10));
+    ASSERT_TRUE(traceRom(COUNTER_ROM, OTHER_PATH, 0, 1, 6));
+
+    TraceReader a, b;
+    ASSERT_TRUE(a.open(LINEAR_PATH));
+    ASSERT_TRUE(b.open(OTHER_PATH));
+    TraceDivergence divergence;
+    EXPECT_FALSE(InstructionTrace::diff(a, b, divergence, 4));
+    EXPECT_EQ(divergence.index, 6u);
+    EXPECT_FALSE(divergence.endOfFirst);
+    EXPECT_TRUE(divergence.endOfSecond);
+    ASSERT_EQ(divergence.context.size(), 4u);
+    EXPECT_EQ(divergence.context.back().getCycle(), 5u);
+}
+
+TEST_F(InstructionTraceTest, RejectsForeignFiles) {
+    std::FILE* file = std::fopen(LINEAR_PATH, "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a trace file at all, just some text......", file);
+    std::fclose(file);
+
+    TraceReader reader;
+    EXPECT_FALSE(reader.open(LINEAR_PATH));
+    EXPECT_FALSE(reader.open("instruction_trace_missing.trace"));
+}
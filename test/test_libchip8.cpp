@@ -0,0 +1,114 @@
+// ============================================================================
+// test_libchip8.cpp - C API Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include "libchip8.h"
+
+namespace {
+
+// 200: 7001 ADD V0,1 | 202: 1200 JP 200
+const uint8_t COUNTER_ROM[] = {0x70, 0x01, 0x12, 0x00};
+
+} // namespace
+
+class LibChip8Test : public ::testing::Test {
+protected:
+    chip8_instance* instance;
+
+    void SetUp() override {
+        instance = chip8_create();
+        ASSERT_NE(instance, nullptr);
+    }
+
+    void TearDown() override {
+        chip8_destroy(instance);
+    }
+};
+
+TEST_F(LibChip8Test, ReportsApiVersion) {
+    EXPECT_EQ(chip8_api_version(), CHIP8_API_VERSION);
+}
+
+TEST_F(LibChip8Test, RejectsInvalidRoms) {
+    uint8_t big[4096] = {0};
+    EXPECT_EQ(chip8_load_rom(instance, nullptr, 4), CHIP8_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(chip8_load_rom(instance, big, sizeof(big)), CHIP8_ERROR_ROM_TOO_LARGE);
+    EXPECT_EQ(chip8_load_rom(nullptr, COUNTER_ROM, sizeof(COUNTER_ROM)), CHIP8_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(LibChip8Test, RunFramesExecutesWholeFrames) {
+    ASSERT_EQ(chip8_load_rom(instance, COUNTER_ROM, sizeof(COUNTER_ROM)), CHIP8_OK);
+    chip8_set_cycles_per_frame(instance, 20);
+    chip8_run_frames(instance, 3);
+
+    chip8_state state;
+    chip8_get_state(instance, &state);
+    EXPECT_EQ(state.frame_count, 3u);
+    EXPECT_EQ(state.v[0], 30);
+    EXPECT_EQ(state.pc, 0x200);
+    EXPECT_EQ(state.machine_cycles, 0u);
+}
+
+TEST_F(LibChip8Test, StepManyAdvancesEveryInstance) {
+    chip8_instance* other = chip8_create();
+    ASSERT_NE(other, nullptr);
+    ASSERT_EQ(chip8_load_rom(instance, COUNTER_ROM, sizeof(COUNTER_ROM)), CHIP8_OK);
+    ASSERT_EQ(chip8_load_rom(other, COUNTER_ROM, sizeof(COUNTER_ROM)), CHIP8_OK);
+    chip8_set_vip_timing(other, 1);
+
+    chip8_instance* batch[] = {instance, nullptr, other};
+    chip8_step_many(batch, 3, 2);
+
+    chip8_state first;
+    chip8_state second;
+    chip8_get_state(instance, &first);
+    chip8_get_state(other, &second);
+    EXPECT_EQ(first.frame_count, 2u);
+    EXPECT_EQ(second.frame_count, 2u);
+    EXPECT_EQ(first.v[0], 10);
+    EXPECT_GT(second.machine_cycles, 0u);
+    chip8_destroy(other);
+}
+
+TEST_F(LibChip8Test, FramebufferReflectsDrawing) {
+    // 200: F029 LD F,V0 (dígito 0) | 202: D005 DRW V0,V0,5 | 204: 1204
+    const uint8_t rom[] = {0xF0, 0x29, 0xD0, 0x05, 0x12, 0x04};
+    ASSERT_EQ(chip8_load_rom(instance, rom, sizeof(rom)), CHIP8_OK);
+    chip8_take_redraw(instance);
+    chip8_run_frames(instance, 1);
+
+    const uint8_t* pixels = chip8_framebuffer(instance);
+    ASSERT_NE(pixels, nullptr);
+    EXPECT_EQ(pixels[0], 1);                        // "0" começa com 0xF0
+    EXPECT_EQ(pixels[4], 0);
+    EXPECT_EQ(pixels[CHIP8_SCREEN_WIDTH + 1], 0);   // Segunda linha: 0x90
+    EXPECT_EQ(chip8_take_redraw(instance), 1);
+    EXPECT_EQ(chip8_take_redraw(instance), 0);
+}
+
+TEST_F(LibChip8Test, TrapStopsOnlyTheFaultingInstance) {
+    const uint8_t recursion[] = {0x22, 0x00};      // CALL 200 sem fim
+    chip8_instance* healthy = chip8_create();
+    ASSERT_NE(healthy, nullptr);
+    ASSERT_EQ(chip8_load_rom(instance, recursion, sizeof(recursion)), CHIP8_OK);
+    ASSERT_EQ(chip8_load_rom(healthy, COUNTER_ROM, sizeof(COUNTER_ROM)), CHIP8_OK);
+    chip8_set_cycles_per_frame(instance, 100);     // Falha já no primeiro frame
+
+    chip8_instance* batch[] = {instance, healthy};
+    chip8_step_many(batch, 2, 3);
+
+    chip8_state state;
+    chip8_get_state(instance, &state);
+    EXPECT_EQ(chip8_get_trap(instance), CHIP8_TRAP_STACK_OVERFLOW);
+    EXPECT_EQ(state.trap, CHIP8_TRAP_STACK_OVERFLOW);
+    EXPECT_EQ(state.pc, 0x200);
+    EXPECT_EQ(state.frame_count, 1u);
+
+    chip8_get_state(healthy, &state);
+    EXPECT_EQ(state.trap, CHIP8_TRAP_NONE);
+    EXPECT_EQ(state.frame_count, 3u);
+    chip8_destroy(healthy);
+
+    ASSERT_EQ(chip8_load_rom(instance, COUNTER_ROM, sizeof(COUNTER_ROM)), CHIP8_OK);
+    EXPECT_EQ(chip8_get_trap(instance), CHIP8_TRAP_NONE);
+}
@@ -0,0 +1,131 @@
+// ============================================================================
+// test_lockstep.cpp - Differential Engine Harness Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <sstream>
+#include "Lockstep.h"
+
+namespace {
+
+// Interpretador com um bug injetado: depois da instrução número faultAt,
+// inverte um bit de V3
+class FaultyEngine : public InterpreterEngine {
+private:
+    uint64_t executed;
+    uint64_t faultAt;
+
+public:
+    explicit FaultyEngine(uint64_t at) : executed(0), faultAt(at) {}
+
+    const char* getName() const override { return "faulty"; }
+
+    bool start(const uint8_t* rom, size_t size, uint32_t seed) override {
+        executed = 0;
+        return InterpreterEngine::start(rom, size, seed);
+    }
+
+    void execute(uint32_t count) override {
+        for(uint32_t i = 0; i < count; ++i) {
+            machine.step();
+            if(++executed == faultAt) {
+                Chip8Snapshot state;
+                machine.saveSnapshot(state);
+                state.registers.setV(3, state.registers.getV(3) ^ 0x01);
+                machine.restoreSnapshot(state);
+            }
+        }
+    }
+
+    // O contador de instruções faz parte do estado deste motor
+    void saveSnapshot(Chip8Snapshot& snapshot) const override {
+        InterpreterEngine::saveSnapshot(snapshot);
+        snapshot.frameCount = executed;
+    }
+    void restoreSnapshot(const Chip8Snapshot& snapshot) override {
+        InterpreterEngine::restoreSnapshot(snapshot);
+        executed = snapshot.frameCount;
+    }
+};
+
+// Laço com CXNN, desenho, timer e teclado:
+// 200: A20E  I = 0x20E (sprite)
+// 202: C1FF  V1 = rand
+// 204: D015  desenha em (V0, V1)
+// 206: 7001  V0 += 1
+// 208: F015  DT = V0
+// 20A: E49E  pula se tecla 4
+// 20C: 1200  volta ao início
+// 20E: F0 90 90 90 F0
+const uint8_t LOOP_ROM[] = {
+    0xA2, 0x0E, 0xC1, 0xFF, 0xD0, 0x15, 0x70, 0x01,
+    0xF0, 0x15, 0xE4, 0x9E, 0x12, 0x00,
+    0xF0, 0x90, 0x90, 0x90, 0xF0
+};
+
+LockstepOptions makeOptions(uint64_t instructions) {
+    LockstepOptions options;
+    options.checkInterval = 64;
+    options.cyclesPerFrame = 10;
+    options.maxInstructions = instructions;
+    options.seed = 1234;
+    return options;
+}
+
+} // namespace
+
+TEST(LockstepTest, IdenticalEnginesNeverDiverge) {
+    InterpreterEngine a;
+    InterpreterEngine b;
+    LockstepHarness harness(a, b, makeOptions(5000));
+
+    std::vector<KeyEvent> script;
+    KeyEvent press = {20, 4, true};
+    KeyEvent release = {40, 4, false};
+    script.push_back(press);
+    script.push_back(release);
+    harness.setInputScript(script);
+
+    LockstepResult result;
+    EXPECT_TRUE(harness.run(LOOP_ROM, sizeof(LOOP_ROM), result));
+    EXPECT_FALSE(result.diverged);
+    EXPECT_EQ(result.instructions, 5000u);
+    EXPECT_EQ(result.differences, "");
+}
+
+TEST(LockstepTest, BisectsToFirstDivergentInstruction) {
+    InterpreterEngine reference;
+    FaultyEngine candidate(1000);
+    LockstepHarness harness(reference, candidate, makeOptions(5000));
+
+    LockstepResult result;
+    EXPECT_FALSE(harness.run(LOOP_ROM, sizeof(LOOP_ROM), result));
+    ASSERT_TRUE(result.diverged);
+    EXPECT_EQ(result.instructions, 1000u);
+
+    // Sem teclas o laço tem 7 instruções: a de índice 999 é a 6ª, E49E em 0x20A
+    EXPECT_EQ(result.pc, 0x20A);
+    EXPECT_EQ(result.opcode, 0xE49E);
+    EXPECT_NE(result.differences.find("V3"), std::string::npos);
+    EXPECT_EQ(LockstepHarness::compare(result.before, result.before), "");
+
+    std::ostringstream dump;
+    LockstepHarness::dumpResult(dump, result, reference.getName(), candidate.getName());
+    EXPECT_NE(dump.str().find("opcode E49E"), std::string::npos);
+    EXPECT_NE(dump.str().find("--- faulty ---"), std::string::npos);
+}
+
+TEST(LockstepTest, CompareReportsEachDifferentField) {
+    Chip8 machine;
+    Chip8Snapshot a;
+    machine.saveSnapshot(a);
+    Chip8Snapshot b = a;
+
+    b.registers.setI(0x300);
+    b.memory.write(0x400, 0xAB);
+    b.keyMask = 0x0001;
+
+    std::string report = LockstepHarness::compare(a, b);
+    EXPECT_NE(report.find("I: 0000 != 0300"), std::string::npos);
+    EXPECT_NE(report.find("mem[400]: 00 != AB"), std::string::npos);
+    EXPECT_NE(report.find("keys: 0000 != 0001"), std::string::npos);
+}
@@ -4,13 +4,10 @@
 #include <gtest/gtest.h>
 #include "Memory.h"
 
+// O construtor já zera a memória e carrega o fontset
 class MemoryTest : public ::testing::Test {
 protected:
     Memory memory;
-    
-    void SetUp() override {
-        memory.clear();
-    }
 };
 
 TEST_F(MemoryTest, InitialStateIsZero) {
@@ -66,10 +63,47 @@ TEST_F(MemoryTest, LoadProgram) {
 }
 
 TEST_F(MemoryTest, LoadProgramTooLarge) {
-    uint8_t largeProgram[4096];
+    uint8_t largeProgram[4096] = {0};
     EXPECT_FALSE(memory.loadProgram(largeProgram, sizeof(largeProgram)));
 }
 
 TEST_F(MemoryTest, ProgramStartAddress) {
     EXPECT_EQ(Memory::getProgramStart(), 0x200);
-}
\ No newline at end of file
+}
+TEST_F(MemoryTest, SpanReadWriteWithoutWrap) {
+    uint8_t in[4] = {1, 2, 3, 4};
+    memory.writeSpan(0x300, in, 4);
+
+    uint8_t out[4] = {0};
+    memory.readSpan(0x300, out, 4);
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_EQ(out[i], in[i]);
+        EXPECT_EQ(memory.read(0x300 + i), in[i]);
+    }
+}
+
+TEST_F(MemoryTest, SpanWrapsAtEndOfMemory) {
+    uint8_t in[4] = {0xA, 0xB, 0xC, 0xD};
+    memory.writeSpan(0xFFE, in, 4);
+
+    EXPECT_EQ(memory.read(0xFFE), 0xA);
+    EXPECT_EQ(memory.read(0xFFF), 0xB);
+    EXPECT_EQ(memory.read(0x000), 0xC);
+    EXPECT_EQ(memory.read(0x001), 0xD);
+
+    uint8_t out[4] = {0};
+    memory.readSpan(0x1FFE, out, 4);  // Endereço também é mascarado
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_EQ(out[i], in[i]);
+    }
+}
+
+TEST_F(MemoryTest, DirectPointerOnlyWhenNotWrapping) {
+    memory.write(0x400, 0x77);
+    const uint8_t* ptr = memory.getPointer(0x400, 15);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(ptr[0], 0x77);
+
+    EXPECT_NE(memory.getPointer(0xFF1, 15), nullptr);
+    EXPECT_EQ(memory.getPointer(0xFF2, 15), nullptr);
+}
@@ -0,0 +1,78 @@
+// ============================================================================
+// test_mpsc_queue.cpp - Lock-free MPSC Queue Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "MpscQueue.h"
+
+TEST(MpscQueueTest, FifoOrderSingleProducer) {
+    MpscQueue<int> queue(8);
+    for(int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+
+    int value = -1;
+    for(int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpscQueueTest, RejectsWhenFull) {
+    MpscQueue<int> queue(4);
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(99));
+
+    int value;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(99));
+}
+
+TEST(MpscQueueTest, PeekDoesNotConsume) {
+    MpscQueue<int> queue(4);
+    queue.tryPush(42);
+
+    int value = 0;
+    EXPECT_TRUE(queue.peek(value));
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_FALSE(queue.peek(value));
+}
+
+TEST(MpscQueueTest, MultipleProducers) {
+    MpscQueue<int> queue(64);
+    const int PRODUCERS = 4;
+    const int PER_PRODUCER = 2000;
+
+    std::vector<std::thread> producers;
+    for(int p = 0; p < PRODUCERS; ++p) {
+        producers.push_back(std::thread([&queue, p, PER_PRODUCER]() {
+            for(int i = 0; i < PER_PRODUCER; ) {
+                if(queue.tryPush(p * PER_PRODUCER + i)) ++i;
+                else std::this_thread::yield();
+            }
+        }));
+    }
+
+    // Cada produtor deve aparecer em ordem crescente
+    std::vector<int> last(PRODUCERS, -1);
+    int received = 0;
+    while(received < PRODUCERS * PER_PRODUCER) {
+        int value;
+        if(queue.tryPop(value)) {
+            int producer = value / PER_PRODUCER;
+            EXPECT_GT(value, last[producer]);
+            last[producer] = value;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for(size_t i = 0; i < producers.size(); ++i) {
+        producers[i].join();
+    }
+}
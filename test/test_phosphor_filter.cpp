@@ -0,0 +1,158 @@
+// ============================================================================
+// test_phosphor_filter.cpp - Phosphor Persistence Filter Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "FramePublisher.h"
+#include "PhosphorFilter.h"
+
+namespace {
+
+PhosphorOptions makeOptions(uint8_t decay, bool blend, uint8_t threshold = 64) {
+    PhosphorOptions options;
+    options.decay = decay;
+    options.blend = blend;
+    options.threshold = threshold;
+    return options;
+}
+
+// Referência direta da fórmula documentada
+struct ReferenceFilter {
+    PhosphorOptions options;
+    std::vector<uint8_t> intensity, previous;
+
+    ReferenceFilter(const PhosphorOptions& opts, size_t count)
+        : options(opts), intensity(count), previous(count) {}
+
+    void process(const uint8_t* pixels) {
+        for(size_t i = 0; i < intensity.size(); ++i) {
+            int target = pixels[i] * 255;
+            if(options.blend) target = (target + previous[i] * 255 + 1) / 2;
+            int decayed = intensity[i] * options.decay / 256;
+            intensity[i] = static_cast<uint8_t>(std::max(target, decayed));
+            previous[i] = pixels[i];
+        }
+    }
+};
+
+} // namespace
+
+TEST(PhosphorFilterTest, WithoutDecayOrBlendItPassesPixelsThrough) {
+    PhosphorFilter filter(makeOptions(0, false));
+    Display display;
+    const uint8_t sprite[] = {0xF0, 0x90};
+    display.drawSprite(10, 5, sprite, 2);
+
+    const uint8_t* intensity = filter.process(display);
+    for(size_t i = 0; i < Frame::PIXEL_COUNT; ++i) {
+        ASSERT_EQ(intensity[i], display.getPixels()[i] ? 255 : 0);
+        ASSERT_EQ(filter.getPixels()[i], display.getPixels()[i]);
+    }
+}
+
+TEST(PhosphorFilterTest, ErasedPixelDecaysGeometrically) {
+    PhosphorFilter filter(makeOptions(128, false));
+    std::vector<uint8_t> pixels(Frame::PIXEL_COUNT, 0);
+    pixels[100] = 1;
+    filter.process(pixels.data());
+    EXPECT_EQ(filter.getIntensity()[100], 255);
+
+    pixels[100] = 0;
+    const uint8_t expected[] = {127, 63, 31, 15, 7, 3, 1, 0};
+    for(size_t f = 0; f < sizeof(expected); ++f) {
+        filter.process(pixels.data());
+        EXPECT_EQ(filter.getIntensity()[100], expected[f]);
+    }
+    EXPECT_EQ(filter.getIntensity()[101], 0);
+}
+
+TEST(PhosphorFilterTest, BlendingHidesXorFlicker) {
+    // Sprite apagado e redesenhado em frames alternados
+    PhosphorFilter filter;
+    std::vector<uint8_t> on(Frame::PIXEL_COUNT, 1), off(Frame::PIXEL_COUNT, 0);
+    filter.process(on.data());
+    EXPECT_EQ(filter.getIntensity()[0], 128);      // Só no atual: meia intensidade
+
+    for(int f = 0; f < 20; ++f) {
+        filter.process(f % 2 ? on.data() : off.data());
+        ASSERT_GE(filter.getIntensity()[0], 128);
+        ASSERT_EQ(filter.getPixels()[0], 1);
+    }
+
+    // Aceso de forma estável chega ao máximo
+    filter.process(on.data());
+    filter.process(on.data());
+    EXPECT_EQ(filter.getIntensity()[0], 255);
+
+    // Apagado de vez: some abaixo do limiar em poucos frames
+    int frames = 0;
+    while(filter.getPixels()[0] && frames < 10) {
+        filter.process(off.data());
+        ++frames;
+    }
+    EXPECT_EQ(filter.getPixels()[0], 0);
+    EXPECT_LE(frames, 6);
+}
+
+TEST(PhosphorFilterTest, VectorPathMatchesReferenceForAnySize) {
+    // 128x64 e um tamanho sem múltiplo de 16 (sobra escalar)
+    const size_t sizes[][2] = {{128, 64}, {13, 7}, {64, 32}};
+    const PhosphorOptions options[] = {
+        makeOptions(192, true, 64), makeOptions(250, false, 1), makeOptions(17, true, 200)
+    };
+    std::srand(1234);
+    for(size_t s = 0; s < 3; ++s) {
+        for(size_t o = 0; o < 3; ++o) {
+            size_t count = sizes[s][0] * sizes[s][1];
+            PhosphorFilter filter(options[o], sizes[s][0], sizes[s][1]);
+            ReferenceFilter reference(options[o], count);
+            std::vector<uint8_t> pixels(count);
+            for(int frame = 0; frame < 30; ++frame) {
+                for(size_t i = 0; i < count; ++i) pixels[i] = std::rand() % 3 == 0;
+                filter.process(pixels.data());
+                reference.process(pixels.data());
+                for(size_t i = 0; i < count; ++i) {
+                    ASSERT_EQ(filter.getIntensity()[i], reference.intensity[i])
+                        << "tamanho " << s << " opções " << o << " frame " << frame << " pixel " << i;
+                    ASSERT_EQ(filter.getPixels()[i], reference.intensity[i] >= options[o].threshold);
+                }
+            }
+        }
+    }
+}
+
+TEST(PhosphorFilterTest, UpscaleReplicatesEachPixel) {
+    PhosphorFilter filter(makeOptions(0, false), 4, 2);
+    const uint8_t pixels[] = {1, 0, 0, 1,
+                              0, 1, 0, 0};
+    filter.process(pixels);
+
+    const unsigned scale = 3;
+    std::vector<uint8_t> out(4 * scale * 2 * scale, 0xAA);
+    filter.upscale(scale, out.data());
+    for(size_t y = 0; y < 2 * scale; ++y) {
+        for(size_t x = 0; x < 4 * scale; ++x) {
+            ASSERT_EQ(out[y * 4 * scale + x], pixels[(y / scale) * 4 + x / scale] ? 255 : 0);
+        }
+    }
+}
+
+TEST(PhosphorFilterTest, ResetClearsPersistenceAndFeedsOneBitSinks) {
+    PhosphorFilter filter;
+    Display display;
+    const uint8_t sprite[] = {0x80};
+    display.drawSprite(0, 0, sprite, 1);
+    filter.process(display);
+    filter.process(display);
+
+    FramePublisher publisher;
+    ASSERT_TRUE(publisher.publish(filter.getPixels()));
+    EXPECT_EQ(publisher.acquire()->pixels[0], 1);
+
+    filter.reset();
+    EXPECT_EQ(filter.getIntensity()[0], 0);
+    EXPECT_EQ(filter.getPixels()[0], 0);
+}
@@ -0,0 +1,207 @@
+// ============================================================================
+// test_recompiler.cpp - Static Recompiler Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <sstream>
+#include "Recompiler.h"
+#include "RecompiledEngine.h"
+
+// Gerados no build por recompile-rom a partir de test/roms/*.ch8
+extern const RecompiledProgram recompiler_sample_program;
+extern const RecompiledProgram dead_flags_program;
+
+namespace {
+
+const RecompilerBlock* findBlock(const Recompiler& recompiler, uint16_t start) {
+    const std::vector<RecompilerBlock>& blocks = recompiler.getBlocks();
+    for(size_t i = 0; i < blocks.size(); ++i) {
+        if(blocks[i].start == start) return &blocks[i];
+    }
+    return nullptr;
+}
+
+LockstepOptions sampleOptions() {
+    LockstepOptions options;
+    options.checkInterval = 97;
+    options.cyclesPerFrame = 11;
+    options.maxInstructions = 50000;
+    options.seed = 7;
+    return options;
+}
+
+} // namespace
+
+TEST(RecompilerTest, FollowsJumpsCallsAndBothSidesOfSkips) {
+    // 200: 2206 CALL 206 | 202: 3000 SE V0,0 | 204: 1200 JP 200
+    // 206: 6001          | 208: 00EE RET
+    const uint8_t rom[] = {0x22, 0x06, 0x30, 0x00, 0x12, 0x00, 0x60, 0x01, 0x00, 0xEE};
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(rom, sizeof(rom)));
+
+    ASSERT_EQ(recompiler.getBlocks().size(), 4u);
+    const RecompilerBlock* entry = findBlock(recompiler, 0x200);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->end, 0x202);
+    ASSERT_EQ(entry->successors.size(), 2u);
+    EXPECT_EQ(entry->successors[0], 0x206);     // Alvo da chamada
+    EXPECT_EQ(entry->successors[1], 0x202);     // Retorno
+
+    const RecompilerBlock* skip = findBlock(recompiler, 0x202);
+    ASSERT_NE(skip, nullptr);
+    EXPECT_EQ(skip->end, 0x204);
+    EXPECT_NE(findBlock(recompiler, 0x204), nullptr);
+    EXPECT_NE(findBlock(recompiler, 0x206), nullptr);
+    EXPECT_EQ(findBlock(recompiler, 0x206)->end, 0x20A);
+}
+
+TEST(RecompilerTest, IndirectJumpTargetsAreLeftToInterpreter) {
+    // 200: B204 JP V0,204 | 202: 1202 | 204: 1200 (só alcançável por BNNN)
+    const uint8_t rom[] = {0xB2, 0x04, 0x12, 0x02, 0x12, 0x00};
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(rom, sizeof(rom)));
+
+    EXPECT_EQ(recompiler.getIndirectJumpCount(), 1u);
+    EXPECT_EQ(recompiler.getBlocks().size(), 1u);
+    EXPECT_EQ(findBlock(recompiler, 0x204), nullptr);
+}
+
+TEST(RecompilerTest, RejectsEmptyOrOversizedRoms) {
+    Recompiler recompiler;
+    const uint8_t one[] = {0x00};
+    EXPECT_FALSE(recompiler.analyze(one, 1));
+
+    std::vector<uint8_t> big(4096, 0);
+    EXPECT_FALSE(recompiler.analyze(big.data(), big.size()));
+}
+
+TEST(RecompilerTest, EmitsOneFunctionPerBlockAndProgramTable) {
+    const uint8_t rom[] = {0x60, 0x05, 0x70, 0x01, 0x12, 0x02};
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(rom, sizeof(rom)));
+
+    std::ostringstream out;
+    recompiler.emit(out, "tiny_program", "tiny.ch8");
+    std::string code = out.str();
+
+    EXPECT_NE(code.find("uint32_t block_200(RecompiledContext& ctx, uint32_t budget)"), std::string::npos);
+    EXPECT_NE(code.find("uint32_t block_202("), std::string::npos);
+    EXPECT_NE(code.find("r.setV(0x0, 0x05);"), std::string::npos);
+    EXPECT_NE(code.find("const RecompiledProgram tiny_program = {"), std::string::npos);
+}
+
+TEST(RecompilerTest, RecompiledSampleMatchesInterpreterInLockstep) {
+    InterpreterEngine reference;
+    RecompiledEngine candidate(recompiler_sample_program);
+    LockstepHarness harness(reference, candidate, sampleOptions());
+
+    std::vector<KeyEvent> script;
+    KeyEvent press = {30, 4, true};
+    KeyEvent release = {90, 4, false};
+    script.push_back(press);
+    script.push_back(release);
+    harness.setInputScript(script);
+
+    LockstepResult result;
+    bool same = harness.run(recompiler_sample_program.rom, recompiler_sample_program.romSize, result);
+    if(!same) {
+        std::ostringstream dump;
+        LockstepHarness::dumpResult(dump, result, reference.getName(), candidate.getName());
+        ADD_FAILURE() << dump.str();
+    }
+
+    // Alvos de BNNN e o código auto-modificado passam pelo interpretador
+    EXPECT_GT(candidate.getCompiledInstructions(), candidate.getInterpretedInstructions());
+    EXPECT_GT(candidate.getInterpretedInstructions(), 0u);
+}
+
+TEST(RecompilerTest, DifferentRomFallsBackToInterpreter) {
+    const uint8_t rom[] = {0x60, 0x05, 0x70, 0x01, 0x12, 0x02};
+    InterpreterEngine reference;
+    RecompiledEngine candidate(recompiler_sample_program);
+    LockstepHarness harness(reference, candidate, sampleOptions());
+
+    LockstepResult result;
+    EXPECT_TRUE(harness.run(rom, sizeof(rom), result));
+    EXPECT_EQ(candidate.getCompiledInstructions(), 0u);
+}
+
+TEST(RecompilerTest, EmbeddedRomStartsAtProgramStart) {
+    RecompiledEngine engine(recompiler_sample_program);
+    ASSERT_TRUE(engine.start(0));
+    engine.execute(1000);
+    EXPECT_GT(engine.getCompiledInstructions(), 0u);
+}
+
+// ============================================================================
+// Liveness de VF
+// ============================================================================
+
+TEST(RecompilerTest, FlagsOverwrittenBeforeUseAreDead) {
+    // 200: 8124 ADD | 202: 8125 SUB | 204: D015 DRW | 206: 6F00 LD VF,0 | 208: 1200
+    const uint8_t rom[] = {0x81, 0x24, 0x81, 0x25, 0xD0, 0x15, 0x6F, 0x00, 0x12, 0x00};
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(rom, sizeof(rom)));
+
+    const RecompilerBlock* block = findBlock(recompiler, 0x200);
+    ASSERT_NE(block, nullptr);
+    const std::vector<uint16_t> expected = {0x200, 0x202, 0x204};
+    EXPECT_EQ(block->deadFlags, expected);
+    EXPECT_EQ(recompiler.getDeadFlagCount(), 3u);
+}
+
+TEST(RecompilerTest, ReadsAndBlockExitsKeepFlagsLive) {
+    // 8124 lido por 7F01; 8124 antes de FX55 (pode sair do bloco); 8124 no
+    // fim do bloco; 8F14 tem o flag sobrescrito pelo próprio resultado
+    const uint8_t rom[] = {
+        0x81, 0x24, 0x7F, 0x01,
+        0x81, 0x24, 0xF0, 0x55,
+        0x8F, 0x14,
+        0x81, 0x24, 0x12, 0x00
+    };
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(rom, sizeof(rom)));
+
+    const RecompilerBlock* block = findBlock(recompiler, 0x200);
+    ASSERT_NE(block, nullptr);
+    const std::vector<uint16_t> expected = {0x208};
+    EXPECT_EQ(block->deadFlags, expected);
+}
+
+TEST(RecompilerTest, EmitsFullBudgetVersionWithoutDeadFlags) {
+    const uint8_t rom[] = {0x81, 0x24, 0xD0, 0x15, 0x6F, 0x00, 0x12, 0x00};
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(rom, sizeof(rom)));
+
+    std::ostringstream out;
+    recompiler.emit(out, "flags_program", "flags.ch8");
+    std::string code = out.str();
+
+    EXPECT_NE(code.find("uint32_t block_200_full(RecompiledContext& ctx)"), std::string::npos);
+    EXPECT_NE(code.find("if(budget >= 4) return block_200_full(ctx);"), std::string::npos);
+    EXPECT_NE(code.find("ctx.drawWithoutFlag(0x0, 0x1, 5);"), std::string::npos);
+    EXPECT_NE(code.find("ctx.draw(0x0, 0x1, 5);"), std::string::npos);   // Versão com budget parcial
+}
+
+TEST(RecompilerTest, DeadFlagProgramMatchesInterpreterInLockstep) {
+    // Intervalos variados: o budget cai em todos os pontos do laço de 23
+    // instruções, e os maiores cobrem o laço inteiro (versão _full)
+    const uint32_t intervals[] = {1, 7, 23, 97, 500};
+    for(size_t i = 0; i < sizeof(intervals) / sizeof(intervals[0]); ++i) {
+        LockstepOptions options = sampleOptions();
+        options.checkInterval = intervals[i];
+        options.cyclesPerFrame = 1000;
+        options.maxInstructions = 20000;
+
+        InterpreterEngine reference;
+        RecompiledEngine candidate(dead_flags_program);
+        LockstepHarness harness(reference, candidate, options);
+
+        LockstepResult result;
+        if(!harness.run(dead_flags_program.rom, dead_flags_program.romSize, result)) {
+            std::ostringstream dump;
+            LockstepHarness::dumpResult(dump, result, reference.getName(), candidate.getName());
+            ADD_FAILURE() << "intervalo " << intervals[i] << "\n" << dump.str();
+        }
+        EXPECT_GT(candidate.getCompiledInstructions(), 0u);
+    }
+}
@@ -0,0 +1,145 @@
+// ============================================================================
+// test_rom_profile.cpp - RomProfile Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Chip8.h"
+#include "Recompiler.h"
+
+namespace {
+
+// 200: 6004 LD V0,4  | 202: B206 JP V0,206 -> 20A
+// 204: 1204 JP 204   | 206: 1206 JP 206     | 208: 1208 JP 208
+// 20A: 7101 ADD V1,1 | 20C: 120A JP 20A     (só alcançável por BNNN)
+const std::vector<uint8_t> INDIRECT_ROM = {
+    0x60, 0x04, 0xB2, 0x06, 0x12, 0x04, 0x12, 0x06, 0x12, 0x08, 0x71, 0x01, 0x12, 0x0A
+};
+
+const char* PROFILE_PATH = "rom_profile_test.profile";
+
+const RecompilerBlock* findBlock(const Recompiler& recompiler, uint16_t start) {
+    const std::vector<RecompilerBlock>& blocks = recompiler.getBlocks();
+    for(size_t i = 0; i < blocks.size(); ++i) {
+        if(blocks[i].start == start) return &blocks[i];
+    }
+    return nullptr;
+}
+
+RomProfile profileRun(Chip8& emulator, uint32_t frames) {
+    RomProfile profile;
+    profile.reset(emulator.getRomHash());
+    ProfileRecorder<Chip8> recorder(profile, emulator);
+    for(uint32_t f = 0; f < frames; ++f) {
+        emulator.runFrame(10, [&]() { recorder.step(); });
+    }
+    return profile;
+}
+
+class RomProfileTest : public ::testing::Test {
+protected:
+    Chip8 emulator;
+
+    void SetUp() override {
+        emulator.initialize();
+        ASSERT_TRUE(emulator.loadROM(INDIRECT_ROM.data(), INDIRECT_ROM.size()));
+    }
+
+    void TearDown() override {
+        std::remove(PROFILE_PATH);
+    }
+};
+
+} // namespace
+
+TEST_F(RomProfileTest, LoadRomKeysByContent) {
+    EXPECT_EQ(emulator.getRomHash(), RomProfile::hashRom(INDIRECT_ROM.data(), INDIRECT_ROM.size()));
+
+    std::vector<uint8_t> other = INDIRECT_ROM;
+    other[1] = 0x05;
+    Chip8 second;
+    second.initialize();
+    second.loadROM(other.data(), other.size());
+    EXPECT_NE(second.getRomHash(), emulator.getRomHash());
+
+    second.initialize();
+    EXPECT_EQ(second.getRomHash(), 0u);
+}
+
+TEST_F(RomProfileTest, RecorderSeesBlockEntriesAndIndirectTargets) {
+    RomProfile profile = profileRun(emulator, 3);
+
+    EXPECT_EQ(profile.getEntryCount(0x200), 1u);
+    EXPECT_EQ(profile.getEntryCount(0x202), 0u);        // Sequencial
+    EXPECT_EQ(profile.getIndirectCount(0x20A), 1u);
+    EXPECT_GT(profile.getEntryCount(0x20A), 10u);       // Laço 20A-20C
+
+    std::vector<uint16_t> roots = profile.translationRoots();
+    ASSERT_GE(roots.size(), 2u);
+    EXPECT_EQ(roots[0], 0x20A);                         // BNNN antes das quentes
+}
+
+TEST_F(RomProfileTest, ProfileRootsTranslateIndirectTargets) {
+    Recompiler plain;
+    ASSERT_TRUE(plain.analyze(INDIRECT_ROM.data(), INDIRECT_ROM.size()));
+    EXPECT_EQ(findBlock(plain, 0x20A), nullptr);
+
+    RomProfile profile = profileRun(emulator, 3);
+    Recompiler warm;
+    ASSERT_TRUE(warm.analyze(INDIRECT_ROM.data(), INDIRECT_ROM.size(), profile.translationRoots()));
+    const RecompilerBlock* target = findBlock(warm, 0x20A);
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(target->end, 0x20E);
+}
+
+TEST_F(RomProfileTest, RootsOutsideTheRomAreIgnored) {
+    const std::vector<uint16_t> roots = {0x100, 0x900};
+    Recompiler recompiler;
+    ASSERT_TRUE(recompiler.analyze(INDIRECT_ROM.data(), INDIRECT_ROM.size(), roots));
+    EXPECT_EQ(findBlock(recompiler, 0x100), nullptr);
+    EXPECT_EQ(findBlock(recompiler, 0x900), nullptr);
+}
+
+TEST_F(RomProfileTest, SaveAndLoadAccumulatesAcrossRuns) {
+    RomProfile first = profileRun(emulator, 2);
+    ASSERT_TRUE(first.save(PROFILE_PATH));
+
+    // Próxima sessão: o perfil é carregado e a execução soma a ele
+    RomProfile next;
+    ASSERT_TRUE(next.load(PROFILE_PATH, emulator.getRomHash()));
+    EXPECT_EQ(next.getIndirectCount(0x20A), 1u);
+    EXPECT_EQ(next.getEntryCount(0x20A), first.getEntryCount(0x20A));
+
+    ASSERT_TRUE(next.load(PROFILE_PATH, emulator.getRomHash()));
+    EXPECT_EQ(next.getEntryCount(0x20A), 2 * first.getEntryCount(0x20A));
+}
+
+TEST_F(RomProfileTest, ProfileOfAnotherRomIsRejected) {
+    RomProfile profile = profileRun(emulator, 1);
+    ASSERT_TRUE(profile.save(PROFILE_PATH));
+
+    RomProfile other;
+    EXPECT_FALSE(other.load(PROFILE_PATH, emulator.getRomHash() ^ 1));
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(other.getRomHash(), emulator.getRomHash() ^ 1);
+}
+
+TEST_F(RomProfileTest, MissingOrCorruptProfileIsAColdStart) {
+    RomProfile profile;
+    EXPECT_FALSE(profile.load("nao_existe.profile", emulator.getRomHash()));
+    EXPECT_TRUE(profile.empty());
+
+    {
+        std::ofstream file(PROFILE_PATH);
+        file << "entry 20a 5\n";                        // Sem linha rom
+    }
+    EXPECT_FALSE(profile.load(PROFILE_PATH, emulator.getRomHash()));
+    EXPECT_TRUE(profile.empty());
+}
+
+TEST(RomProfilePathTest, FileNameIsTheRomHash) {
+    EXPECT_EQ(RomProfile::pathFor("perfis", 0xABCULL), "perfis/0000000000000abc.profile");
+    EXPECT_EQ(RomProfile::pathFor("perfis/", 0x1ULL), "perfis/0000000000000001.profile");
+}
@@ -0,0 +1,382 @@
+// ============================================================================
+// test_session_daemon.cpp - Session Daemon Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "SessionDaemon.h"
+
+namespace {
+
+// 200: F00A LD V0,K | 202: F029 LD F,V0 | 204: 6100 LD V1,0
+// 206: D115 DRW V1,V1,5 | 208: 1208 JP 208
+const uint8_t KEY_DIGIT_ROM[] = {0xF0, 0x0A, 0xF0, 0x29, 0x61, 0x00, 0xD1, 0x15, 0x12, 0x08};
+
+// 200: 6078 LD V0,120 | 202: F015 LD DT,V0 | 204: F107 LD V1,DT
+// 206: 3100 SE V1,0   | 208: 1204 JP 204   | 20A: F129 LD F,V1
+// 20C: D115 DRW V1,V1,5 | 20E: 120E JP 20E
+const uint8_t TIMER_DIGIT_ROM[] = {
+    0x60, 0x78, 0xF0, 0x15, 0xF1, 0x07, 0x31, 0x00, 0x12, 0x04,
+    0xF1, 0x29, 0xD1, 0x15, 0x12, 0x0E
+};
+
+// Espera até cond() ou ~2 s
+template<typename Condition>
+bool waitFor(Condition cond) {
+    for(int i = 0; i < 2000 && !cond(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return cond();
+}
+
+// Cliente bloqueante mínimo, com timeout de leitura
+class TestClient {
+public:
+    int fd;
+    bool connected;
+    std::vector<uint8_t> buffer;
+
+    explicit TestClient(const std::string& path) : fd(socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        connected = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+
+        timeval timeout = {2, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    ~TestClient() { ::close(fd); }
+
+    void send(const std::vector<uint8_t>& data) {
+        ASSERT_EQ(::send(fd, data.data(), data.size(), MSG_NOSIGNAL), static_cast<ssize_t>(data.size()));
+    }
+
+    // Próxima mensagem; false em timeout ou desconexão
+    bool receive(DaemonMessage& type, std::vector<uint8_t>& payload) {
+        for(;;) {
+            DaemonMessageView message;
+            long used = DaemonProtocol::parse(buffer.data(), buffer.size(), message);
+            if(used > 0) {
+                type = message.type;
+                payload.assign(message.payload, message.payload + message.size);
+                buffer.erase(buffer.begin(), buffer.begin() + used);
+                return true;
+            }
+            if(used < 0) return false;
+
+            uint8_t chunk[4096];
+            ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            if(received <= 0) return false;
+            buffer.insert(buffer.end(), chunk, chunk + received);
+        }
+    }
+
+    // Descarta mensagens até achar uma do tipo pedido
+    bool receiveType(DaemonMessage wanted, std::vector<uint8_t>& payload) {
+        DaemonMessage type;
+        while(receive(type, payload)) {
+            if(type == wanted) return true;
+        }
+        return false;
+    }
+};
+
+class SessionDaemonTest : public ::testing::Test {
+protected:
+    std::string path;
+    std::unique_ptr<SessionDaemon> daemon;
+    std::thread loop;
+
+    void SetUp() override {
+        path = "/tmp/chip8d-test-" + std::to_string(getpid()) + ".sock";
+        DaemonOptions options;
+        options.workerThreads = 2;
+        options.speed = 10.0;
+        daemon.reset(new SessionDaemon(options));
+        ASSERT_TRUE(daemon->listen(path));
+        loop = std::thread(&SessionDaemon::run, daemon.get());
+    }
+
+    void TearDown() override {
+        daemon->stop();
+        if(loop.joinable()) loop.join();
+    }
+
+    uint32_t createSession(TestClient& client, const uint8_t* rom = KEY_DIGIT_ROM,
+                           size_t size = sizeof(KEY_DIGIT_ROM)) {
+        std::vector<uint8_t> message;
+        DaemonProtocol::appendCreate(message, 10, rom, size);
+        client.send(message);
+
+        std::vector<uint8_t> payload;
+        EXPECT_TRUE(client.receiveType(DaemonMessage::Created, payload));
+        return payload.size() == 4 ? DaemonProtocol::getU32(payload.data()) : 0;
+    }
+};
+
+} // namespace
+
+TEST(DaemonProtocolTest, ParseWaitsForCompleteMessage) {
+    std::vector<uint8_t> data;
+    DaemonProtocol::appendKey(data, 0x01020304, 7, true);
+    ASSERT_EQ(data.size(), DaemonProtocol::HEADER_SIZE + 1 + 6);
+
+    DaemonMessageView message;
+    EXPECT_EQ(DaemonProtocol::parse(data.data(), data.size() - 1, message), 0);
+    ASSERT_EQ(DaemonProtocol::parse(data.data(), data.size(), message), static_cast<long>(data.size()));
+    EXPECT_EQ(message.type, DaemonMessage::Key);
+    EXPECT_EQ(DaemonProtocol::getU32(message.payload), 0x01020304u);
+    EXPECT_EQ(message.payload[4], 7);
+    EXPECT_EQ(message.payload[5], 1);
+}
+
+TEST(DaemonProtocolTest, RejectsOversizedLength) {
+    const uint8_t data[] = {0xFF, 0xFF, 0xFF, 0x7F, 0x01};
+    DaemonMessageView message;
+    EXPECT_EQ(DaemonProtocol::parse(data, sizeof(data), message), -1);
+}
+
+TEST_F(SessionDaemonTest, CreatedSessionStreamsFramesAndTakesKeys) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+    uint32_t session = createSession(client);
+    ASSERT_NE(session, 0u);
+
+    std::vector<uint8_t> key;
+    DaemonProtocol::appendKey(key, session, 7, true);
+    client.send(key);
+
+    // O dígito 7 começa com a linha 0xF0 no canto superior esquerdo
+    const size_t prefix = DaemonProtocol::FRAME_PREFIX_SIZE;
+    FrameDecoder decoder;
+    bool drawn = false;
+    std::vector<uint8_t> payload;
+    while(!drawn && client.receiveType(DaemonMessage::Frame, payload)) {
+        ASSERT_GT(payload.size(), prefix);
+        EXPECT_EQ(DaemonProtocol::getU32(payload.data()), session);
+
+        size_t consumed;
+        ASSERT_EQ(decoder.decode(payload.data() + prefix, payload.size() - prefix, consumed),
+                  FrameDecodeStatus::Frame);
+        EXPECT_EQ(consumed, payload.size() - prefix);
+        drawn = decoder.getPacked()[0] == 0xF0;
+    }
+    EXPECT_TRUE(drawn);
+
+    std::vector<uint8_t> destroy;
+    DaemonProtocol::appendSession(destroy, DaemonMessage::Destroy, session);
+    client.send(destroy);
+    ASSERT_TRUE(client.receiveType(DaemonMessage::Closed, payload));
+    EXPECT_EQ(DaemonProtocol::getU32(payload.data()), session);
+}
+
+TEST_F(SessionDaemonTest, KeyframeRequestResyncsDecoder) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+    uint32_t session = createSession(client);
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(client.receiveType(DaemonMessage::Frame, payload));
+
+    std::vector<uint8_t> key;
+    DaemonProtocol::appendKey(key, session, 3, true);
+    DaemonProtocol::appendSession(key, DaemonMessage::Keyframe, session);
+    client.send(key);
+
+    // Um decoder novo (espectador que entrou agora) sincroniza no keyframe
+    const size_t prefix = DaemonProtocol::FRAME_PREFIX_SIZE;
+    FrameDecoder late;
+    size_t consumed;
+    FrameDecodeStatus status = FrameDecodeStatus::NeedKeyframe;
+    while(status != FrameDecodeStatus::Frame && client.receiveType(DaemonMessage::Frame, payload)) {
+        status = late.decode(payload.data() + prefix, payload.size() - prefix, consumed);
+    }
+    EXPECT_EQ(status, FrameDecodeStatus::Frame);
+    EXPECT_TRUE(late.isSynced());
+}
+
+TEST_F(SessionDaemonTest, SessionsBelongToTheirConnection) {
+    TestClient owner(path);
+    TestClient other(path);
+    ASSERT_TRUE(owner.connected);
+    ASSERT_TRUE(other.connected);
+    uint32_t session = createSession(owner);
+
+    std::vector<uint8_t> key;
+    DaemonProtocol::appendKey(key, session, 1, true);
+    other.send(key);
+
+    std::vector<uint8_t> payload;
+    EXPECT_TRUE(other.receiveType(DaemonMessage::Error, payload));
+}
+
+TEST_F(SessionDaemonTest, RejectsCyclesPerFrameOutOfRange) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+
+    const uint32_t invalid[] = {0, DaemonOptions().maxCyclesPerFrame + 1, UINT32_MAX};
+    for(uint32_t cycles : invalid) {
+        std::vector<uint8_t> message;
+        DaemonProtocol::appendCreate(message, cycles, KEY_DIGIT_ROM, sizeof(KEY_DIGIT_ROM));
+        client.send(message);
+
+        DaemonMessage type;
+        std::vector<uint8_t> payload;
+        ASSERT_TRUE(client.receive(type, payload));
+        EXPECT_EQ(type, DaemonMessage::Error) << cycles;
+    }
+    EXPECT_EQ(daemon->getSessionCount(), 0u);
+
+    // A conexão continua válida
+    EXPECT_NE(createSession(client), 0u);
+}
+
+TEST_F(SessionDaemonTest, DisconnectDestroysSessions) {
+    {
+        TestClient client(path);
+        ASSERT_TRUE(client.connected);
+        createSession(client);
+        createSession(client);
+        EXPECT_EQ(daemon->getSessionCount(), 2u);
+    }
+
+    for(int i = 0; i < 200 && daemon->getSessionCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(daemon->getSessionCount(), 0u);
+}
+
+TEST_F(SessionDaemonTest, TrappedSessionIsReportedOnce) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+
+    const uint8_t underflow[] = {0x00, 0xEE};      // RET sem CALL
+    std::vector<uint8_t> message;
+    DaemonProtocol::appendCreate(message, 10, underflow, sizeof(underflow));
+    client.send(message);
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(client.receiveType(DaemonMessage::Created, payload));
+    uint32_t session = DaemonProtocol::getU32(payload.data());
+
+    ASSERT_TRUE(client.receiveType(DaemonMessage::Trap, payload));
+    ASSERT_EQ(payload.size(), 7u);
+    EXPECT_EQ(DaemonProtocol::getU32(payload.data()), session);
+    EXPECT_EQ(payload[4], static_cast<uint8_t>(Trap::StackUnderflow));
+    EXPECT_EQ(DaemonProtocol::getU16(payload.data() + 5), 0x200);
+
+    // Parada, a sessão continua existindo até Destroy
+    EXPECT_EQ(daemon->getSessionCount(), 1u);
+    std::vector<uint8_t> destroy;
+    DaemonProtocol::appendSession(destroy, DaemonMessage::Destroy, session);
+    client.send(destroy);
+    DaemonMessage type;
+    ASSERT_TRUE(client.receive(type, payload));
+    EXPECT_EQ(type, DaemonMessage::Closed);
+}
+
+TEST_F(SessionDaemonTest, MalformedMessageClosesConnection) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+    const uint8_t garbage[] = {0x01, 0x00, 0x00, 0x00, 0x42};
+    client.send(std::vector<uint8_t>(garbage, garbage + sizeof(garbage)));
+
+    std::vector<uint8_t> payload;
+    EXPECT_TRUE(client.receiveType(DaemonMessage::Error, payload));
+    DaemonMessage type;
+    EXPECT_FALSE(client.receive(type, payload));
+}
+
+TEST_F(SessionDaemonTest, KeyWaitParksSessionUntilInput) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+    uint32_t session = createSession(client);
+    SessionDaemon& d = *daemon;
+    ASSERT_TRUE(waitFor([&]() { return d.getParkedCount() == 1; }));
+
+    // Estacionada: o tempo passa sem emular nada
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(daemon->getFramesSkipped(), 0u);
+
+    std::vector<uint8_t> key;
+    DaemonProtocol::appendKey(key, session, 7, true);
+    client.send(key);
+
+    const size_t prefix = DaemonProtocol::FRAME_PREFIX_SIZE;
+    FrameDecoder decoder;
+    std::vector<uint8_t> payload;
+    uint64_t frame = 0;
+    while(client.receiveType(DaemonMessage::Frame, payload)) {
+        size_t consumed;
+        ASSERT_EQ(decoder.decode(payload.data() + prefix, payload.size() - prefix, consumed),
+                  FrameDecodeStatus::Frame);
+        frame = DaemonProtocol::getU64(payload.data() + 4);
+        if(decoder.getPacked()[0] == 0xF0) break;
+    }
+    EXPECT_EQ(decoder.getPacked()[0], 0xF0);
+
+    // Os ~60 frames dormidos foram pulados de uma vez, não perdidos
+    EXPECT_GE(daemon->getFramesSkipped(), 30u);
+    EXPECT_GE(frame, daemon->getFramesSkipped());
+    EXPECT_EQ(daemon->getParkedCount(), 0u);        // JP 208 roda
+}
+
+TEST_F(SessionDaemonTest, TimerWaitWakesOnTheFrameTheTimerExpires) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+    uint32_t session = createSession(client, TIMER_DIGIT_ROM, sizeof(TIMER_DIGIT_ROM));
+    ASSERT_NE(session, 0u);
+
+    const size_t prefix = DaemonProtocol::FRAME_PREFIX_SIZE;
+    FrameDecoder decoder;
+    std::vector<uint8_t> payload;
+    uint64_t frame = 0;
+    while(client.receiveType(DaemonMessage::Frame, payload)) {
+        size_t consumed;
+        ASSERT_EQ(decoder.decode(payload.data() + prefix, payload.size() - prefix, consumed),
+                  FrameDecodeStatus::Frame);
+        frame = DaemonProtocol::getU64(payload.data() + 4);
+        if(decoder.getPacked()[0] == 0xF0) break;
+    }
+    ASSERT_EQ(decoder.getPacked()[0], 0xF0);
+
+    // DT = 120 no frame 0 chega a 0 no fim do frame 119: pula os frames
+    // 1..119 e o laço sai no frame 120, como sem estacionar. O Frame leva
+    // o número do fim do tick, que pode ter rodado mais de um frame.
+    EXPECT_GE(frame, 121u);
+    EXPECT_EQ(daemon->getFramesSkipped(), 119u);
+}
+
+TEST_F(SessionDaemonTest, DestroyingParkedSessionsCancelsTheirWakeups) {
+    TestClient client(path);
+    ASSERT_TRUE(client.connected);
+    uint32_t waitingKey = createSession(client);
+    uint32_t waitingTimer = createSession(client, TIMER_DIGIT_ROM, sizeof(TIMER_DIGIT_ROM));
+    SessionDaemon& d = *daemon;
+    ASSERT_TRUE(waitFor([&]() { return d.getParkedCount() == 2; }));
+
+    std::vector<uint8_t> destroy;
+    DaemonProtocol::appendSession(destroy, DaemonMessage::Destroy, waitingTimer);
+    DaemonProtocol::appendSession(destroy, DaemonMessage::Destroy, waitingKey);
+    client.send(destroy);
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(client.receiveType(DaemonMessage::Closed, payload));
+    ASSERT_TRUE(client.receiveType(DaemonMessage::Closed, payload));
+    EXPECT_EQ(daemon->getSessionCount(), 0u);
+    EXPECT_EQ(daemon->getParkedCount(), 0u);
+
+    // O despertar agendado não toca a sessão destruída
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    EXPECT_EQ(daemon->getFramesSkipped(), 0u);
+}
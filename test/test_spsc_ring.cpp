@@ -0,0 +1,71 @@
+// ============================================================================
+// test_spsc_ring.cpp - Lock-free SPSC Ring Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <thread>
+#include "SpscRing.h"
+
+TEST(SpscRingTest, CapacityRoundsUpToPowerOfTwo) {
+    SpscRing<int> ring(100);
+    EXPECT_EQ(ring.capacity(), 128u);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, PushAndPopPreserveOrder) {
+    SpscRing<int> ring(8);
+    int in[5] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(ring.push(in, 5), 5u);
+    EXPECT_EQ(ring.size(), 5u);
+
+    int out[5] = {0};
+    EXPECT_EQ(ring.pop(out, 5), 5u);
+    for(int i = 0; i < 5; ++i) {
+        EXPECT_EQ(out[i], in[i]);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, PushNeverOverwritesWhenFull) {
+    SpscRing<int> ring(4);
+    int in[6] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(ring.push(in, 6), 4u);
+    EXPECT_FALSE(ring.tryPush(7));
+
+    int value = 0;
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(SpscRingTest, WrapsAroundIndices) {
+    SpscRing<int> ring(4);
+    for(int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(ring.tryPush(i));
+        int value = -1;
+        EXPECT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(SpscRingTest, ProducerConsumerThreads) {
+    SpscRing<int> ring(64);
+    const int COUNT = 20000;
+
+    std::thread producer([&ring, COUNT]() {
+        for(int i = 0; i < COUNT; ) {
+            if(ring.tryPush(i)) ++i;
+            else std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    while(expected < COUNT) {
+        int value;
+        if(ring.tryPop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
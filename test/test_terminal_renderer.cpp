@@ -0,0 +1,190 @@
+// ============================================================================
+// test_terminal_renderer.cpp - Terminal Renderer Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "TerminalRenderer.h"
+
+namespace {
+
+const size_t PIXELS = Display::getWidth() * Display::getHeight();
+
+// Terminal mínimo: interpreta posicionamentos ESC[r;cH e glifos UTF-8,
+// guardando o code point de cada posição
+struct VirtualTerminal {
+    static const size_t SIZE = 100;
+    std::vector<uint32_t> screen;
+    size_t row, column;
+
+    VirtualTerminal() : screen(SIZE * SIZE, 0), row(0), column(0) {}
+
+    bool feed(const std::string& bytes) {
+        size_t i = 0;
+        while(i < bytes.size()) {
+            unsigned char c = bytes[i];
+            if(c == 0x1B) {
+                unsigned r = 0, col = 0;
+                int used = 0;
+                if(std::sscanf(bytes.c_str() + i, "\x1b[%u;%uH%n", &r, &col, &used) != 2) return false;
+                row = r - 1;
+                column = col - 1;
+                i += used;
+                continue;
+            }
+            uint32_t code = c;
+            if(c >= 0x80) {
+                if(i + 2 >= bytes.size() || c != 0xE2) return false;
+                code = ((c & 0x0F) << 12) | ((bytes[i + 1] & 0x3F) << 6) | (bytes[i + 2] & 0x3F);
+                i += 2;
+            }
+            ++i;
+            screen[row * SIZE + column++] = code;
+        }
+        return true;
+    }
+
+    uint32_t at(size_t r, size_t c) const { return screen[r * SIZE + c]; }
+};
+
+uint32_t halfBlockAt(const uint8_t* pixels, size_t row, size_t column) {
+    static const uint32_t CODES[4] = {' ', 0x2580, 0x2584, 0x2588};
+    size_t width = Display::getWidth();
+    return CODES[pixels[2 * row * width + column] | (pixels[(2 * row + 1) * width + column] << 1)];
+}
+
+uint32_t brailleAt(const uint8_t* pixels, size_t row, size_t column) {
+    static const uint8_t DOTS[4][2] = {{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}};
+    size_t width = Display::getWidth();
+    uint8_t bits = 0;
+    for(size_t y = 0; y < 4; ++y) {
+        for(size_t x = 0; x < 2; ++x) {
+            if(pixels[(4 * row + y) * width + 2 * column + x]) bits |= DOTS[y][x];
+        }
+    }
+    return bits ? 0x2800 + bits : ' ';
+}
+
+} // namespace
+
+TEST(TerminalRendererTest, FirstFrameDrawsEveryCell) {
+    TerminalRenderer renderer;
+    EXPECT_EQ(renderer.getColumns(), 64u);
+    EXPECT_EQ(renderer.getRows(), 16u);
+
+    std::vector<uint8_t> pixels(PIXELS, 0);
+    std::string out;
+    size_t bytes = renderer.render(pixels.data(), out);
+    EXPECT_EQ(bytes, out.size());
+
+    // Uma linha por vez: posicionamento + 64 espaços
+    std::string expected;
+    for(int row = 1; row <= 16; ++row) {
+        expected += "\x1b[" + std::to_string(row) + ";1H" + std::string(64, ' ');
+    }
+    EXPECT_EQ(out, expected);
+}
+
+TEST(TerminalRendererTest, UnchangedFrameEmitsNothing) {
+    TerminalRenderer renderer;
+    Display display;
+    const uint8_t sprite[] = {0xFF, 0x81, 0xFF};
+    display.drawSprite(3, 4, sprite, 3);
+
+    std::string out;
+    renderer.render(display, out);
+    out.clear();
+    EXPECT_EQ(renderer.render(display, out), 0u);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(TerminalRendererTest, ChangedCellIsPositionedAndDrawn) {
+    TerminalRenderer renderer;
+    std::vector<uint8_t> pixels(PIXELS, 0);
+    std::string out;
+    renderer.render(pixels.data(), out);
+
+    // (10, 5): linha de células 2, metade de baixo
+    pixels[5 * 64 + 10] = 1;
+    out.clear();
+    renderer.render(pixels.data(), out);
+    EXPECT_EQ(out, "\x1b[3;11H\xE2\x96\x84");
+
+    // Duas mudanças próximas: a célula do meio é reescrita, sem outro
+    // posicionamento
+    pixels[0 * 64 + 20] = 1;
+    pixels[1 * 64 + 22] = 1;
+    out.clear();
+    renderer.render(pixels.data(), out);
+    EXPECT_EQ(out, "\x1b[1;21H\xE2\x96\x80 \xE2\x96\x84");
+
+    // Distantes: dois posicionamentos
+    pixels[0 * 64 + 20] = 0;
+    pixels[0 * 64 + 60] = 1;
+    out.clear();
+    renderer.render(pixels.data(), out);
+    EXPECT_EQ(out, "\x1b[1;21H \x1b[1;61H\xE2\x96\x80");
+}
+
+TEST(TerminalRendererTest, BrailleEncodesTwoByFourCells) {
+    TerminalRenderer renderer(TerminalGlyphs::Braille, 5, 70);
+    EXPECT_EQ(renderer.getColumns(), 32u);
+    EXPECT_EQ(renderer.getRows(), 8u);
+
+    std::vector<uint8_t> pixels(PIXELS, 0);
+    std::string out;
+    renderer.render(pixels.data(), out);
+    EXPECT_EQ(out.substr(0, 7), "\x1b[5;70H");
+
+    // (3, 7): célula (1, 1), ponto 8 -> U+2880
+    pixels[7 * 64 + 3] = 1;
+    out.clear();
+    renderer.render(pixels.data(), out);
+    EXPECT_EQ(out, "\x1b[6;71H\xE2\xA2\x80");
+}
+
+TEST(TerminalRendererTest, InvalidateRedrawsEverything) {
+    TerminalRenderer renderer;
+    std::vector<uint8_t> pixels(PIXELS, 0);
+    std::string first, second;
+    renderer.render(pixels.data(), first);
+    renderer.invalidate();
+    renderer.render(pixels.data(), second);
+    EXPECT_EQ(first, second);
+}
+
+TEST(TerminalRendererTest, DiffsReproduceEveryFrame) {
+    const TerminalGlyphs modes[] = {TerminalGlyphs::HalfBlock, TerminalGlyphs::Braille};
+    std::srand(99);
+    for(size_t m = 0; m < 2; ++m) {
+        TerminalRenderer renderer(modes[m], 3, 2);
+        VirtualTerminal terminal;
+        std::vector<uint8_t> pixels(PIXELS, 0);
+        size_t diffBytes = 0;
+
+        for(int frame = 0; frame < 50; ++frame) {
+            // Poucos pixels mudam por frame, como num jogo
+            for(int k = 0; k < 6; ++k) pixels[std::rand() % PIXELS] ^= 1;
+
+            std::string out;
+            renderer.render(pixels.data(), out);
+            if(frame > 0) diffBytes += out.size();
+            ASSERT_TRUE(terminal.feed(out));
+
+            for(size_t r = 0; r < renderer.getRows(); ++r) {
+                for(size_t c = 0; c < renderer.getColumns(); ++c) {
+                    uint32_t expected = modes[m] == TerminalGlyphs::HalfBlock
+                                            ? halfBlockAt(pixels.data(), r, c)
+                                            : brailleAt(pixels.data(), r, c);
+                    ASSERT_EQ(terminal.at(r + 2, c + 1), expected)
+                        << "modo " << m << " frame " << frame << " célula " << r << "," << c;
+                }
+            }
+        }
+        // Bem menos que redesenhar a tela a cada frame
+        EXPECT_LT(diffBytes / 49, 6u * 12u);
+    }
+}
@@ -0,0 +1,170 @@
+// ============================================================================
+// test_trap.cpp - Trap Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Chip8.h"
+
+namespace {
+
+class TrapTest : public ::testing::Test {
+protected:
+    Chip8 emulator;
+
+    void SetUp() override {
+        emulator.initialize();
+        emulator.seedRandom(1);
+    }
+
+    void load(const std::vector<uint8_t>& rom) {
+        ASSERT_TRUE(emulator.loadROM(rom.data(), rom.size()));
+    }
+
+    uint16_t pc() const { return emulator.getRegisters().getPC(); }
+};
+
+} // namespace
+
+TEST_F(TrapTest, RunningProgramHasNoTrap) {
+    load({0x60, 0x01, 0x12, 0x02});     // V0 = 1; JP 202
+    emulator.runFrame(100);
+    EXPECT_EQ(emulator.getTrap(), Trap::None);
+    EXPECT_EQ(emulator.getFrameCount(), 1u);
+}
+
+TEST_F(TrapTest, StackOverflowStopsOnTheCall) {
+    load({0x22, 0x00});                 // 200: CALL 200, recursão infinita
+    emulator.runFrame(100);
+
+    EXPECT_EQ(emulator.getTrap(), Trap::StackOverflow);
+    EXPECT_TRUE(emulator.getRegisters().hasStackFault());
+    EXPECT_EQ(emulator.getRegisters().getSP(), 16);
+    EXPECT_EQ(pc(), 0x200);
+}
+
+TEST_F(TrapTest, StackUnderflowStopsOnTheReturn) {
+    load({0x60, 0x07, 0x00, 0xEE, 0x60, 0x09});    // V0 = 7; RET; V0 = 9
+    emulator.runFrame(10);
+
+    EXPECT_EQ(emulator.getTrap(), Trap::StackUnderflow);
+    EXPECT_EQ(pc(), 0x202);
+    EXPECT_EQ(emulator.getRegisters().getV(0), 7);
+}
+
+TEST_F(TrapTest, InvalidOpcodeHasNoEffect) {
+    load({0x61, 0x05, 0x81, 0x28, 0x71, 0x01});    // V1 = 5; 8128; V1 += 1
+    emulator.runFrame(10);
+
+    EXPECT_EQ(emulator.getTrap(), Trap::InvalidOpcode);
+    EXPECT_EQ(pc(), 0x202);
+    EXPECT_EQ(emulator.getRegisters().getV(1), 5);
+    EXPECT_EQ(emulator.getRegisters().getV(0xF), 0);
+}
+
+TEST_F(TrapTest, UnknownFxAndExOpcodesTrap) {
+    load({0xF0, 0x99});
+    emulator.runFrame(1);
+    EXPECT_EQ(emulator.getTrap(), Trap::InvalidOpcode);
+
+    emulator.initialize();
+    load({0xE0, 0x00});
+    emulator.runFrame(1);
+    EXPECT_EQ(emulator.getTrap(), Trap::InvalidOpcode);
+}
+
+TEST_F(TrapTest, JumpPastMemoryEndIsPcOutOfRange) {
+    load({0x60, 0xFF, 0xBF, 0x80});     // V0 = FF; JP V0, F80 -> 107F
+    emulator.runFrame(10);
+
+    EXPECT_EQ(emulator.getTrap(), Trap::PcOutOfRange);
+    EXPECT_EQ(pc(), 0x107F);
+}
+
+TEST_F(TrapTest, LastWordIsTheLastValidInstruction) {
+    // 200: JP FFE | FFE: 0000 (SYS, ignorado), que segue para 1000
+    load({0x1F, 0xFE});
+    emulator.runFrame(1);
+    EXPECT_EQ(pc(), 0xFFE);
+    emulator.runFrame(2);
+    EXPECT_EQ(emulator.getTrap(), Trap::PcOutOfRange);
+    EXPECT_EQ(pc(), 0x1000);
+}
+
+TEST_F(TrapTest, InstructionAcrossMemoryEndTraps) {
+    load({0x60, 0x01, 0xBF, 0xFE});     // JP V0, FFE -> FFF: instrução não cabe
+    emulator.runFrame(10);
+    EXPECT_EQ(emulator.getTrap(), Trap::PcOutOfRange);
+    EXPECT_EQ(pc(), 0xFFF);
+}
+
+TEST_F(TrapTest, FirstTrapWins) {
+    // 8128 inválido; depois nada mais executa, nem o RET sem CALL
+    load({0x81, 0x28, 0x00, 0xEE});
+    emulator.runFrame(10);
+    EXPECT_EQ(emulator.getTrap(), Trap::InvalidOpcode);
+}
+
+TEST_F(TrapTest, TrappedMachineStopsAdvancing) {
+    load({0x60, 0x10, 0xF0, 0x15, 0xF0, 0x99});    // DT = 16; opcode inválido
+    emulator.runFrame(10);
+    ASSERT_EQ(emulator.getTrap(), Trap::InvalidOpcode);
+    uint64_t frames = emulator.getFrameCount();
+    uint8_t delay = emulator.getRegisters().getDelayTimer();
+
+    for(int i = 0; i < 5; ++i) {
+        emulator.runFrame(10);
+        emulator.runVipFrame();
+    }
+    EXPECT_EQ(emulator.getFrameCount(), frames);
+    EXPECT_EQ(emulator.getRegisters().getDelayTimer(), delay);
+}
+
+TEST_F(TrapTest, RunReturnsOnTrap) {
+    load({0x22, 0x00});
+    RunOptions options;
+    options.speed = 0.0;
+    options.cyclesPerFrame = 100;
+    uint64_t frames = emulator.run(options, []() { return true; });
+
+    EXPECT_EQ(emulator.getTrap(), Trap::StackOverflow);
+    EXPECT_EQ(frames, 1u);
+}
+
+TEST_F(TrapTest, VipTimingReportsTheSameTrap) {
+    load({0x60, 0x01, 0x81, 0x2F});
+    emulator.runVipFrame();
+    EXPECT_EQ(emulator.getTrap(), Trap::InvalidOpcode);
+    EXPECT_EQ(pc(), 0x202);
+}
+
+TEST_F(TrapTest, InitializeClearsTrap) {
+    load({0x00, 0xEE});
+    emulator.runFrame(1);
+    ASSERT_EQ(emulator.getTrap(), Trap::StackUnderflow);
+
+    emulator.initialize();
+    EXPECT_EQ(emulator.getTrap(), Trap::None);
+    EXPECT_EQ(pc(), 0x200);
+}
+
+TEST_F(TrapTest, SnapshotCarriesTrap) {
+    Chip8Snapshot clean;
+    emulator.saveSnapshot(clean);
+
+    load({0x00, 0xEE});
+    emulator.runFrame(1);
+    Chip8Snapshot faulted;
+    emulator.saveSnapshot(faulted);
+
+    emulator.restoreSnapshot(clean);
+    EXPECT_EQ(emulator.getTrap(), Trap::None);
+    emulator.restoreSnapshot(faulted);
+    EXPECT_EQ(emulator.getTrap(), Trap::StackUnderflow);
+}
+
+TEST(TrapNameTest, EveryTrapHasAName) {
+    EXPECT_STREQ(trapName(Trap::None), "nenhum");
+    EXPECT_STREQ(trapName(Trap::StackOverflow), "overflow da pilha");
+    EXPECT_STREQ(trapName(Trap::PcOutOfRange), "PC fora da memória");
+}
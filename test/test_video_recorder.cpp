@@ -0,0 +1,144 @@
+// ============================================================================
+// test_video_recorder.cpp - Headless Video Export Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "VideoRecorder.h"
+
+namespace {
+
+size_t fileSize(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<size_t>(file.tellg()) : 0;
+}
+
+std::string readHeader(const std::string& path, size_t size) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    std::string data(size, '\0');
+    file.read(&data[0], size);
+    return data;
+}
+
+} // namespace
+
+class VideoRecorderTest : public ::testing::Test {
+protected:
+    Display display;
+    uint8_t sprite[2] = {0xF0, 0x90};
+
+    void drawFrames(VideoRecorder& recorder, int count) {
+        for(int i = 0; i < count; ++i) {
+            display.drawSprite(i * 4, i, sprite, 2);
+            recorder.submit(display);
+        }
+    }
+};
+
+TEST_F(VideoRecorderTest, PackRoundTrip) {
+    display.drawSprite(10, 5, sprite, 2);
+
+    uint8_t packed[VideoRecorder::PACKED_SIZE];
+    VideoRecorder::packPixels(display.getPixels(), packed);
+
+    uint8_t pixels[64 * 32];
+    VideoRecorder::unpackPixels(packed, pixels);
+    EXPECT_EQ(0, std::memcmp(pixels, display.getPixels(), sizeof(pixels)));
+}
+
+TEST_F(VideoRecorderTest, UnchangedFrameEncodesToTwoBytes) {
+    uint8_t frame[VideoRecorder::PACKED_SIZE] = {0};
+    std::vector<uint8_t> delta;
+    VideoRecorder::encodeDelta(frame, frame, delta);
+    EXPECT_EQ(delta.size(), 2u);
+}
+
+TEST_F(VideoRecorderTest, DeltaRoundTrip) {
+    uint8_t previous[VideoRecorder::PACKED_SIZE] = {0};
+    uint8_t current[VideoRecorder::PACKED_SIZE] = {0};
+    current[0] = 0xAA;
+    current[100] = 0x01;
+    current[255] = 0xFF;
+
+    std::vector<uint8_t> delta;
+    VideoRecorder::encodeDelta(previous, current, delta);
+    EXPECT_LT(delta.size(), 16u);
+
+    ASSERT_TRUE(VideoRecorder::applyDelta(delta.data(), delta.size(), previous));
+    EXPECT_EQ(0, std::memcmp(previous, current, sizeof(current)));
+}
+
+TEST_F(VideoRecorderTest, RejectsCorruptDelta) {
+    uint8_t packed[VideoRecorder::PACKED_SIZE] = {0};
+    uint8_t truncated[1] = {0x85};
+    EXPECT_FALSE(VideoRecorder::applyDelta(truncated, 1, packed));
+}
+
+TEST_F(VideoRecorderTest, WritesY4M) {
+    const std::string path = "test_video.y4m";
+    {
+        VideoRecorder recorder;
+        ASSERT_TRUE(recorder.open(path.c_str(), VideoFormat::Y4M, 2));
+        drawFrames(recorder, 3);
+        recorder.close();
+        EXPECT_EQ(recorder.getFramesWritten(), 3u);
+    }
+
+    std::string header = "YUV4MPEG2 W128 H64 F60:1 Ip A1:1 C420jpeg\n";
+    EXPECT_EQ(readHeader(path, header.size()), header);
+    size_t frameSize = 6 + 128 * 64 + 2 * 64 * 32;
+    EXPECT_EQ(fileSize(path), header.size() + 3 * frameSize);
+    std::remove(path.c_str());
+}
+
+TEST_F(VideoRecorderTest, WritesPngSequence) {
+    VideoRecorder recorder;
+    ASSERT_TRUE(recorder.open("test_video", VideoFormat::PngSequence, 1));
+    drawFrames(recorder, 2);
+    recorder.close();
+
+    for(int i = 0; i < 2; ++i) {
+        std::string path = i == 0 ? "test_video_000000.png" : "test_video_000001.png";
+        EXPECT_EQ(readHeader(path, 4), "\x89PNG");
+        EXPECT_GT(fileSize(path), 64u * 32u);
+        std::remove(path.c_str());
+    }
+}
+
+TEST_F(VideoRecorderTest, DeltaStreamConvertsToY4M) {
+    const std::string stream = "test_video.c8v";
+    const std::string video = "test_video_converted.y4m";
+    {
+        VideoRecorder recorder;
+        ASSERT_TRUE(recorder.open(stream.c_str(), VideoFormat::DeltaStream));
+        drawFrames(recorder, 5);
+        // Frames sem mudanças devem custar quase nada
+        for(int i = 0; i < 10; ++i) {
+            recorder.submit(display);
+        }
+    }
+    EXPECT_LT(fileSize(stream), 8u + 15u * 40u);
+
+    ASSERT_TRUE(VideoRecorder::convertDeltaStream(stream.c_str(), video.c_str(),
+                                                  VideoFormat::Y4M, 1));
+    std::string header = "YUV4MPEG2 W64 H32 F60:1 Ip A1:1 C420jpeg\n";
+    size_t frameSize = 6 + 64 * 32 + 2 * 32 * 16;
+    EXPECT_EQ(fileSize(video), header.size() + 15 * frameSize);
+
+    std::remove(stream.c_str());
+    std::remove(video.c_str());
+}
+
+TEST_F(VideoRecorderTest, FullQueueDropsFrames) {
+    VideoRecorder recorder(2);
+    ASSERT_TRUE(recorder.open("test_video_drop.c8v", VideoFormat::DeltaStream));
+    for(int i = 0; i < 200; ++i) {
+        display.drawSprite(i % 64, i % 32, sprite, 2);
+        recorder.submit(display);
+    }
+    recorder.close();
+
+    EXPECT_EQ(recorder.getFramesWritten() + recorder.getDroppedFrames(), 200u);
+    std::remove("test_video_drop.c8v");
+}
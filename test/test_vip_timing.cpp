@@ -0,0 +1,90 @@
+// ============================================================================
+// test_vip_timing.cpp - COSMAC VIP Timing Model Tests
+// ============================================================================
+#include <gtest/gtest.h>
+#include "Chip8.h"
+
+TEST(VipTimingTest, FixedCostsComeFromTableWithFetch) {
+    VipTiming timing;
+    EXPECT_EQ(timing.lookup(0x6A42), 6u + VipTiming::FETCH_CYCLES);
+    EXPECT_EQ(timing.lookup(0x8124), 44u + VipTiming::FETCH_CYCLES);
+    // FX55 depende só de X, que está no opcode
+    EXPECT_EQ(timing.lookup(0xF355), 14u + 14u * 4 + VipTiming::FETCH_CYCLES);
+    EXPECT_TRUE(timing.lookup(0x3000) & VipTiming::DYNAMIC);
+}
+
+TEST(VipTimingTest, DrawCostDependsOnRowsAndAlignment) {
+    VipTiming timing;
+    uint32_t entry = timing.lookup(0xD125);
+    uint32_t aligned = VipTiming::resolve(0xD125, entry, 8, false);
+    uint32_t shifted = VipTiming::resolve(0xD125, entry, 9, false);
+
+    EXPECT_TRUE(aligned & VipTiming::WAIT_VBLANK);
+    EXPECT_GT(shifted & VipTiming::COST_MASK, aligned & VipTiming::COST_MASK);
+    EXPECT_LT(VipTiming::resolve(0xD121, entry, 8, false) & VipTiming::COST_MASK,
+              aligned & VipTiming::COST_MASK);
+}
+
+TEST(VipTimingTest, TakenSkipAndBcdDigitsCostMore) {
+    VipTiming timing;
+    uint32_t skip = timing.lookup(0x3000);
+    EXPECT_EQ(VipTiming::resolve(0x3000, skip, 0, true),
+              VipTiming::resolve(0x3000, skip, 0, false) + VipTiming::SKIP_TAKEN_CYCLES);
+
+    uint32_t bcd = timing.lookup(0xF033);
+    EXPECT_EQ(VipTiming::resolve(0xF033, bcd, 199, false) - VipTiming::resolve(0xF033, bcd, 100, false),
+              16u * 18);
+}
+
+TEST(VipTimingTest, FrameEndsWhenCyclesRunOut) {
+    // 200: 7001 ADD V0,1 | 202: 1200 JP 200
+    const uint8_t rom[] = {0x70, 0x01, 0x12, 0x00};
+    Chip8 emulator;
+    emulator.initialize();
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+
+    emulator.runVipFrame();
+
+    VipTiming timing;
+    uint32_t add = timing.lookup(0x7001);
+    uint32_t jump = timing.lookup(0x1200);
+    uint64_t available = VipTiming::CYCLES_AVAILABLE;
+    uint64_t cycles = emulator.getMachineCycles();
+    EXPECT_GE(cycles, available);
+    EXPECT_LT(cycles, available + add + jump);
+
+    uint64_t adds = (cycles + jump) / (add + jump);
+    EXPECT_EQ(emulator.getRegisters().getV(0), adds);
+}
+
+TEST(VipTimingTest, DrawWaitsForVerticalBlank) {
+    // 200: 7101 ADD V1,1 | 202: D005 DRW V0,V0,5 | 204: 1200 JP 200
+    const uint8_t rom[] = {0x71, 0x01, 0xD0, 0x05, 0x12, 0x00};
+    Chip8 emulator;
+    emulator.initialize();
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+
+    for(int i = 0; i < 3; ++i) {
+        emulator.runVipFrame();
+    }
+
+    // Um sprite por frame, e o frame termina exatamente na interrupção
+    EXPECT_EQ(emulator.getRegisters().getV(1), 3);
+    uint64_t available = VipTiming::CYCLES_AVAILABLE;
+    EXPECT_EQ(emulator.getMachineCycles(), 3 * available);
+    EXPECT_EQ(emulator.getFrameCount(), 3u);
+}
+
+TEST(VipTimingTest, DefaultModeKeepsFixedInstructionCount) {
+    const uint8_t rom[] = {0x70, 0x01, 0x12, 0x00};
+    Chip8 emulator;
+    emulator.initialize();
+    ASSERT_TRUE(emulator.loadROM(rom, sizeof(rom)));
+
+    RunOptions options;
+    options.cyclesPerFrame = 10;
+    emulator.runFrame(options);
+
+    EXPECT_EQ(emulator.getRegisters().getV(0), 5);
+    EXPECT_EQ(emulator.getMachineCycles(), 0u);
+}
@@ -0,0 +1,68 @@
+// ============================================================================
+// chip8d.cpp - Daemon de sessões CHIP-8 por socket Unix
+// ============================================================================
+// Uso: chip8d <socket> [-w workers] [-s velocidade] [-m max_sessões]
+//
+// Clientes conectam em <socket> e falam o protocolo de DaemonProtocol.h:
+// criam sessões enviando uma ROM, mandam teclas e recebem um frame a cada
+// mudança de tela. SIGINT/SIGTERM encerram o daemon e removem o socket.
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "SessionDaemon.h"
+
+namespace {
+
+SessionDaemon* runningDaemon = nullptr;
+
+void handleSignal(int) {
+    if(runningDaemon) runningDaemon->stop();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        std::cout << "Uso: " << argv[0] << " <socket> [-w workers] [-s velocidade] [-m max_sessões]"
+                  << " [-c max_ciclos_por_frame]"
+                  << std::endl;
+        return 1;
+    }
+
+    DaemonOptions options;
+    for(int i = 2; i + 1 < argc; i += 2) {
+        if(std::strcmp(argv[i], "-w") == 0) {
+            options.workerThreads = std::strtoul(argv[i + 1], nullptr, 10);
+        } else if(std::strcmp(argv[i], "-s") == 0) {
+            options.speed = std::atof(argv[i + 1]);
+        } else if(std::strcmp(argv[i], "-m") == 0) {
+            options.maxSessions = std::strtoul(argv[i + 1], nullptr, 10);
+        } else if(std::strcmp(argv[i], "-c") == 0) {
+            options.maxCyclesPerFrame = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    SessionDaemon daemon(options);
+    if(!daemon.listen(argv[1])) {
+        return 1;
+    }
+
+    runningDaemon = &daemon;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "chip8d escutando em " << argv[1] << std::endl;
+    daemon.run();
+    runningDaemon = nullptr;
+
+    std::cout << "chip8d encerrado: " << daemon.getFramesSent() << " frames enviados, "
+              << daemon.getFramesDropped() << " descartados, "
+              << daemon.getFramesSkipped() << " pulados em espera" << std::endl;
+    return 0;
+}
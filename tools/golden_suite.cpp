@@ -0,0 +1,79 @@
+// ============================================================================
+// golden_suite.cpp - Executa o corpus de goldens e compara com o arquivo
+// ============================================================================
+// Uso: chip8-golden <arquivo.golden> [-u] [-j jobs] [-d caso] [rom.ch8 ...]
+//
+// Roda as ROMs geradas de GoldenSuite mais as ROMs passadas, em paralelo,
+// e compara os hashes com <arquivo.golden>. -u regrava o arquivo com os
+// resultados atuais; -d imprime a tela final de um caso para conferência.
+// Sai com 1 se algum caso divergir.
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GoldenSuite.h"
+
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        std::cout << "Uso: " << argv[0] << " <arquivo.golden> [-u] [-j jobs] [-d caso] [rom.ch8 ...]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string goldenPath = argv[1];
+    bool update = false;
+    size_t jobs = 0;
+    std::string dump;
+    std::vector<GoldenCase> cases = GoldenSuite::builtinCases();
+
+    for(int i = 2; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-u") == 0) {
+            update = true;
+        } else if(std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            jobs = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            dump = argv[++i];
+        } else if(argv[i][0] == '-') {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            return 1;
+        } else if(!GoldenSuite::addRomFile(argv[i], cases)) {
+            return 1;
+        }
+    }
+
+    if(!dump.empty()) {
+        for(size_t i = 0; i < cases.size(); ++i) {
+            if(cases[i].name != dump) continue;
+            Chip8 machine;
+            GoldenResult result = GoldenSuite::run(cases[i], machine);
+            std::cout << GoldenSuite::renderFrame(machine.getDisplay())
+                      << "trap: " << trapName(result.trap) << std::endl;
+            return 0;
+        }
+        std::cerr << "Caso desconhecido: " << dump << std::endl;
+        return 1;
+    }
+
+    std::vector<GoldenResult> results = GoldenSuite::runAll(cases, jobs);
+
+    if(update) {
+        if(!GoldenSuite::save(goldenPath, results)) {
+            return 1;
+        }
+        std::cout << results.size() << " goldens gravados em " << goldenPath << std::endl;
+        return 0;
+    }
+
+    GoldenTable table;
+    if(!GoldenSuite::load(goldenPath, table)) {
+        return 1;
+    }
+
+    std::string report;
+    size_t failures = GoldenSuite::compare(results, table, report);
+    std::cout << report << results.size() - failures << "/" << results.size()
+              << " casos iguais aos goldens" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// ============================================================================
+// recompile_rom.cpp - Gera uma unidade de tradução C++ a partir de uma ROM
+// ============================================================================
+// Uso: recompile-rom <rom.ch8> <saida.cpp> [símbolo] [-p diretório_de_perfis]
+//
+// A saída define `extern const RecompiledProgram <símbolo>`, que é passado
+// para RecompiledEngine. Compile-a com -O3 junto com o restante do emulador.
+//
+// Com -p, o perfil da ROM gravado por execuções anteriores (chip8-core
+// --profile) acrescenta à tradução os alvos de BNNN e as entradas quentes.
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Recompiler.h"
+#include "RomProfile.h"
+
+namespace {
+
+// Nome do arquivo sem diretório nem extensão, como identificador C++
+std::string symbolFromPath(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    size_t dot = name.find('.');
+    if(dot != std::string::npos) name.erase(dot);
+
+    std::string symbol;
+    for(size_t i = 0; i < name.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(name[i]);
+        symbol += std::isalnum(c) ? static_cast<char>(c) : '_';
+    }
+    if(symbol.empty() || std::isdigit(static_cast<unsigned char>(symbol[0]))) {
+        symbol = "rom_" + symbol;
+    }
+    return symbol + "_program";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if(argc < 3) {
+        std::cout << "Uso: " << argv[0] << " <rom.ch8> <saida.cpp> [símbolo] [-p diretório_de_perfis]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string symbol = symbolFromPath(argv[1]);
+    std::string profileDirectory;
+    for(int i = 3; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            profileDirectory = argv[++i];
+        } else {
+            symbol = argv[i];
+        }
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if(!file.is_open()) {
+        std::cerr << "Erro ao abrir ROM: " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<uint8_t> rom((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<uint16_t> roots;
+    if(!profileDirectory.empty()) {
+        uint64_t hash = RomProfile::hashRom(rom.data(), rom.size());
+        RomProfile profile;
+        if(profile.load(RomProfile::pathFor(profileDirectory, hash), hash)) {
+            roots = profile.translationRoots();
+        } else {
+            std::cout << "Sem perfil para " << argv[1] << ", só análise estática" << std::endl;
+        }
+    }
+
+    Recompiler recompiler;
+    if(!recompiler.analyze(rom.data(), rom.size(), roots)) {
+        std::cerr << "ROM vazia ou muito grande: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::ofstream out(argv[2], std::ios::trunc);
+    if(!out.is_open()) {
+        std::cerr << "Erro ao criar " << argv[2] << std::endl;
+        return 1;
+    }
+    recompiler.emit(out, symbol, argv[1]);
+
+    std::cout << symbol << ": " << recompiler.getBlocks().size() << " blocos, "
+              << recompiler.getIndirectJumpCount() << " saltos indiretos (BNNN), "
+              << recompiler.getDeadFlagCount() << " flags mortos, "
+              << roots.size() << " raízes do perfil" << std::endl;
+    return out.good() ? 0 : 1;
+}
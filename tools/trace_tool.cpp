@@ -0,0 +1,112 @@
+// ============================================================================
+// trace_tool.cpp - Lê, filtra e compara traces de instruções
+// ============================================================================
+// Uso: chip8-trace print <trace> [-pc início-fim] [-op início-fim] [-n máximo]
+//      chip8-trace diff <trace1> <trace2> [-c contexto]
+//
+// print mostra os registros em ordem (no anel, a partir do mais antigo
+// retido), só os de PC e opcode nas faixas dadas (hexadecimal, inclusivas).
+// diff mostra a primeira instrução em que os traces divergem, com as
+// anteriores iguais como contexto, e sai com 1 se divergirem.
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "InstructionTrace.h"
+
+namespace {
+
+// "200-2FF" ou só "200"
+bool parseRange(const char* text, uint16_t& first, uint16_t& last) {
+    char* end = nullptr;
+    unsigned long a = std::strtoul(text, &end, 16);
+    unsigned long b = a;
+    if(*end == '-') b = std::strtoul(end + 1, &end, 16);
+    if(*end != '\0' || end == text || a > 0xFFFF || b > 0xFFFF || a > b) {
+        std::cerr << "Faixa inválida: " << text << std::endl;
+        return false;
+    }
+    first = static_cast<uint16_t>(a);
+    last = static_cast<uint16_t>(b);
+    return true;
+}
+
+int print(int argc, char* argv[]) {
+    TraceFilter filter;
+    uint64_t limit = UINT64_MAX;
+    for(int i = 3; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-pc") == 0 && i + 1 < argc) {
+            if(!parseRange(argv[++i], filter.pcFirst, filter.pcLast)) return 1;
+        } else if(std::strcmp(argv[i], "-op") == 0 && i + 1 < argc) {
+            if(!parseRange(argv[++i], filter.opcodeFirst, filter.opcodeLast)) return 1;
+        } else if(std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            limit = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    TraceReader reader;
+    if(!reader.open(argv[2])) return 1;
+
+    InstructionRecord record;
+    uint64_t shown = 0;
+    while(shown < limit && reader.next(record)) {
+        if(!filter.matches(record)) continue;
+        InstructionTrace::formatRecord(std::cout, record);
+        ++shown;
+    }
+    std::cout << shown << " de " << reader.size() << " registros ("
+              << reader.getTotal() << " gravados)" << std::endl;
+    return 0;
+}
+
+int diff(int argc, char* argv[]) {
+    size_t context = 8;
+    for(int i = 4; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            context = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    TraceReader first, second;
+    if(!first.open(argv[2]) || !second.open(argv[3])) return 1;
+
+    TraceDivergence divergence;
+    if(InstructionTrace::diff(first, second, divergence, context)) {
+        std::cout << "Traces iguais (" << first.size() << " registros)" << std::endl;
+        return 0;
+    }
+
+    std::cout << "Divergência no registro " << divergence.index << std::endl;
+    for(size_t i = 0; i < divergence.context.size(); ++i) {
+        std::cout << "  ";
+        InstructionTrace::formatRecord(std::cout, divergence.context[i]);
+    }
+    std::cout << "< ";
+    if(divergence.endOfFirst) std::cout << "(fim do trace)\n";
+    else InstructionTrace::formatRecord(std::cout, divergence.first);
+    std::cout << "> ";
+    if(divergence.endOfSecond) std::cout << "(fim do trace)\n";
+    else InstructionTrace::formatRecord(std::cout, divergence.second);
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if(argc >= 3 && std::strcmp(argv[1], "print") == 0) {
+        return print(argc, argv);
+    }
+    if(argc >= 4 && std::strcmp(argv[1], "diff") == 0) {
+        return diff(argc, argv);
+    }
+    std::cout << "Uso: " << argv[0] << " print <trace> [-pc início-fim] [-op início-fim] [-n máximo]\n"
+              << "     " << argv[0] << " diff <trace1> <trace2> [-c contexto]" << std::endl;
+    return 1;
+}